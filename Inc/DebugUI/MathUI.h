@@ -12,7 +12,8 @@ namespace MathUI {
     void Vertices(std::vector<VertexPositionNormalTexture>& vertices);
     void Vertices(std::vector<VertexPositionNormalTextureSkinning>& vertices);
 
-    void Indices(std::vector<std::uint16_t>& indices, std::uint16_t numVertices);
+    void Indices(std::vector<std::uint16_t>& indices, std::uint32_t numVertices);
+    void Indices(std::vector<std::uint32_t>& indices, std::uint32_t numVertices);
     void Matrix(DirectX::XMMATRIX& matrix);
     void Matrix(DirectX::XMFLOAT4X4& matrix);
     void Matrix(DirectX::XMFLOAT3X4& matrix);
@@ -29,11 +29,66 @@ struct Keyframe {
 #pragma pack(pop, keyframe)
 static_assert(sizeof(Keyframe) == 44, "Keyframe size mismatch");
 
+// Determines how the keyframes surrounding a point in time are found.
+enum class KeyframeSearch {
+    // Scans from the first keyframe, O(n).
+    Linear,
+    // Binary search on **BoneAnimation::TimePositions**, O(log n).
+    Binary
+};
+
+// Local transformation of every bone, relative to its parent.
+// The w component of the translations and scales is unused.
+struct LocalPose {
+    void Resize(std::uint32_t numBones);
+
+    // Builds the to-parent matrix of every bone.
+    void ToMatrices(Bone::TransformArray& toParentTransforms) const;
+    DirectX::XMMATRIX ToMatrix(std::uint32_t boneIndex) const;
+
+    std::uint32_t GetNumBones() const noexcept;
+
+    std::vector<DirectX::XMFLOAT4A> Translations;
+    std::vector<DirectX::XMFLOAT4A> Scales;
+    std::vector<DirectX::XMFLOAT4A> RotationQuaternions;
+};
+
+// Produces the local pose of an animation at a point in time.
+// Lets different representations of an animation be blended by **AnimationMixer**.
+class IAnimationSampler {
+    public:
+        virtual ~IAnimationSampler() = default;
+
+    public:
+        // Writes the transformation of every bone into **pose**, resizing it to the number of bones of the animation.
+        virtual void Sample(float timePosition, LocalPose& pose) const = 0;
+        // Only needs to write the **numBones** bones listed in **pBoneIndices**, the others may hold any value.
+        // Resizes **pose** the same way as **Sample**, which is called by default.
+        virtual void SampleBones(float timePosition, LocalPose& pose, const std::uint16_t* pBoneIndices, std::uint32_t numBones) const;
+
+        virtual float GetStartTime() const = 0;
+        virtual float GetEndTime() const = 0;
+};
+
 // Hold the keyframes for the animation of a bone.
 // All keyframes must be sorted in ascending order.
-// At least 2 keyframes are needed to calculate the transformation at a given point in time.
+// An animation without keyframes results in the identity transform, a single keyframe is held for the whole clip.
 struct BoneAnimation {
-    void Interpolate(float timePosition, DirectX::XMMATRIX& M) const;
+    void Interpolate(float timePosition, DirectX::XMMATRIX& M, KeyframeSearch search = KeyframeSearch::Binary) const;
+    // Starts the search at **cursor** and stores the keyframe that was found in it.
+    // Playback that moves forward in time only steps over the keyframes that were passed since the last call.
+    void Interpolate(float timePosition, DirectX::XMMATRIX& M, std::uint32_t& cursor) const;
+    // Same as **Interpolate** but returns the translation, scale and rotation instead of a matrix.
+    void Sample(float timePosition, DirectX::XMVECTOR& T, DirectX::XMVECTOR& S, DirectX::XMVECTOR& R, KeyframeSearch search = KeyframeSearch::Binary) const;
+    void Sample(float timePosition, DirectX::XMVECTOR& T, DirectX::XMVECTOR& S, DirectX::XMVECTOR& R, std::uint32_t& cursor) const;
+
+    // Index of the last keyframe at or before **timePosition**, clamped so that there is always a next keyframe.
+    std::uint32_t FindKeyframe(float timePosition, KeyframeSearch search = KeyframeSearch::Binary) const;
+    std::uint32_t FindKeyframe(float timePosition, std::uint32_t& cursor) const;
+
+    // Copies the time of every keyframe into **TimePositions**.
+    // Needs to be called after changing **Keyframes**, the binary search falls back to **Keyframes** when the sizes differ.
+    void UpdateTimePositions();
 
     float GetStartTime() const;
     float GetEndTime() const;
@@ -41,21 +96,65 @@ struct BoneAnimation {
     std::uint32_t GetNumKeyframes() const noexcept;
 
     std::vector<Keyframe> Keyframes;
+    // Times of **Keyframes** stored contiguously, so searching them touches as little memory as possible.
+    std::vector<float> TimePositions;
+};
+
+// Remembers the last keyframe of every bone during the playback of an animation.
+// Use one cursor for every playing instance of an animation.
+struct PlaybackCursor {
+    void Reset() noexcept;
+
+    std::vector<std::uint32_t> KeyframeIndices;
+};
+
+// Scratch memory used while applying an animation to a model.
+// Keeping one per animated model makes **Animation::Apply** free of heap allocations once the buffer is large enough.
+class PoseBuffer {
+    public:
+        PoseBuffer(std::uint32_t numBones = 0);
+
+    public:
+        // Only allocates when **numBones** is larger than the current capacity, the contents are not preserved.
+        void Reserve(std::uint32_t numBones);
+        // Hands the to-parent transforms to **model** and updates the bone matrices of the bones that changed.
+        void ComposeBoneMatrices(Model& model);
+
+    public:
+        Bone::TransformArray& GetToParentTransforms() noexcept;
+
+        std::uint32_t GetCapacity() const noexcept;
+
+    private:
+        std::uint32_t m_capacity;
+        Bone::TransformArray m_toParentTransforms;
 };
 
 // Hold the animation data for a collection of bones.
 // Bone animations must be sorted in the same way as the bone hierarchy.
-class Animation : public Identifiable {
+class Animation : public Identifiable, public IAnimationSampler {
     public:
         Animation(std::string name = "") noexcept;
 
     public:
-        void Interpolate(float timePosition, Bone::TransformArray& boneTransforms) const;
-        void Apply(float timePosition, Model& model) const;
+        void Interpolate(float timePosition, Bone::TransformArray& boneTransforms, KeyframeSearch search = KeyframeSearch::Binary) const;
+        void Interpolate(float timePosition, Bone::TransformArray& boneTransforms, PlaybackCursor& cursor) const;
+        void Sample(float timePosition, LocalPose& pose) const override;
+        void Sample(float timePosition, LocalPose& pose, PlaybackCursor& cursor) const;
+        void SampleBones(float timePosition, LocalPose& pose, const std::uint16_t* pBoneIndices, std::uint32_t numBones) const override;
+        // Allocates a temporary **PoseBuffer**, prefer the overloads taking one for models animated every frame.
+        void Apply(float timePosition, Model& model, KeyframeSearch search = KeyframeSearch::Binary) const;
+        void Apply(float timePosition, Model& model, PlaybackCursor& cursor) const;
+        void Apply(float timePosition, Model& model, PoseBuffer& poseBuffer, KeyframeSearch search = KeyframeSearch::Binary) const;
+        void Apply(float timePosition, Model& model, PoseBuffer& poseBuffer, PlaybackCursor& cursor) const;
+
+        // Calls **BoneAnimation::UpdateTimePositions** for every bone.
+        void UpdateTimePositions();
 
     public:
-        float GetStartTime() const;
-        float GetEndTime() const;
+        // Range covered by the bone animations that have keyframes, 0 when none do.
+        float GetStartTime() const override;
+        float GetEndTime() const override;
 
         std::uint32_t GetNumBoneAnimations() const noexcept;
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Animation.h"
+
+// A single animation playing in an **AnimationMixer**.
+struct AnimationLayer {
+    std::shared_ptr<IAnimationSampler> pSampler;
+
+    float TimePosition = 0.f;
+    // Amount in [0, 1] by which this layer replaces the layers below it.
+    // Layers with a weight of 0 are not sampled.
+    float Weight = 1.f;
+    // Multiplied with **Weight** per bone, bones past the end of the mask use a weight of 1.
+    std::vector<float> BoneMask;
+};
+
+// Blends several animations into a single pose.
+// Every layer is sampled into a local pose and blended over the layers below it,
+// translations and scales are lerped and rotations are nlerped.
+// The bottom layer with a weight above 0 is used as is, bones it does not animate start at the identity.
+// Layers below the top layer with a weight of 1 and no mask are skipped.
+// Bone matrices are only built once, after all layers are blended.
+class AnimationMixer {
+    public:
+        AnimationMixer() = default;
+
+    public:
+        // Adds a layer on top of the others and returns its index.
+        std::uint32_t AddLayer(std::shared_ptr<IAnimationSampler> pSampler, float weight = 1.f, std::vector<float> boneMask = {});
+        void RemoveLayer(std::uint32_t index);
+        void ClearLayers() noexcept;
+
+        // Moves the time of every layer forward by **deltaTime**.
+        void Advance(float deltaTime) noexcept;
+
+        // Blends all layers into **pose**, which holds **numBones** bones afterwards.
+        void Blend(std::uint32_t numBones, LocalPose& pose);
+        // Blends all layers and writes the final bone matrices of **model**.
+        void Apply(Model& model, PoseBuffer& poseBuffer);
+
+        // Mask selecting **rootIndex** and all bones below it, for layers that only animate part of a skeleton.
+        static std::vector<float> MakeBoneMask(Model& model, std::uint32_t rootIndex);
+
+    public:
+        AnimationLayer& GetLayer(std::uint32_t index);
+        std::vector<AnimationLayer>& GetLayers() noexcept;
+        std::uint32_t GetNumLayers() const noexcept;
+
+    private:
+        std::vector<AnimationLayer> m_layers;
+
+        LocalPose m_pose;
+        LocalPose m_layerPose;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Animation.h"
+#include "Scene.h"
+
+class ThreadPool;
+
+// Level of detail used by **AnimationSystem** for models at least **MinDistance** away from the camera.
+struct AnimationLOD {
+    float MinDistance = 0.f;
+    // Samples the animation once every **UpdateInterval** updates, the last pose is held in between.
+    std::uint32_t UpdateInterval = 1;
+    // Number of levels of the skeleton that are sampled, deeper bones hold their last transform.
+    // Every bone is sampled when 0.
+    std::uint32_t MaxDepth = 0;
+};
+
+// Animation played on a single model by **AnimationSystem**.
+struct AnimationBinding {
+    std::shared_ptr<IAnimationSampler> pAnimation;
+
+    float TimePosition = 0.f;
+    float Speed = 1.f;
+    // Wraps the time back to the start of the animation after it ends.
+    bool Loop = true;
+
+    // The LOD with the largest **MinDistance** the model is past is used, in any order.
+    // Models closer than every LOD are animated in full detail.
+    std::vector<AnimationLOD> LODs;
+
+    // Scratch memory of the last update, kept to avoid allocating every frame.
+    LocalPose Pose;
+
+    // Prevents a model that is part of several asset batches from being updated twice.
+    std::uint64_t LastUpdate = 0;
+};
+
+// Updates the bone matrices of every animated model in a scene at once.
+// Every update gathers the bound models of all asset batches and spreads them over a pool of threads,
+// jobs are sorted by animation so models playing the same animation are processed by the same thread.
+// Only models that are part of the scene are updated and only their animations move forward in time.
+// Models with LODs are sampled less often and with fewer bones as they move away from the camera,
+// their time keeps moving forward every update so they stay in sync once they come closer.
+class AnimationSystem {
+    public:
+        // Uses the shared thread pool when **numThreads** is 0.
+        // Otherwise uses **numThreads** threads, including the thread calling **Update**.
+        AnimationSystem(std::uint32_t numThreads = 0);
+        ~AnimationSystem();
+
+    public:
+        // Plays **pAnimation** on **model**, replacing the animation it was playing.
+        AnimationBinding& Bind(const Model& model, std::shared_ptr<IAnimationSampler> pAnimation, bool loop = true);
+        void Unbind(std::uint64_t modelGUID);
+        void UnbindAll() noexcept;
+
+        // Moves every animation forward by **deltaTime** and applies it to its model.
+        void Update(Scene& scene, float deltaTime);
+
+    public:
+        AnimationBinding& GetBinding(std::uint64_t modelGUID);
+
+        std::uint32_t GetNumBindings() const noexcept;
+        // Number of models sampled by the last call to **Update**.
+        std::uint32_t GetNumUpdated() const noexcept;
+        std::uint32_t GetNumThreads() const noexcept;
+
+    private:
+        struct Job {
+            Model* pModel;
+            AnimationBinding* pBinding;
+            std::uint32_t MaxDepth;
+        };
+
+        static void Advance(AnimationBinding& binding, float deltaTime) noexcept;
+        static void Execute(const Job& job);
+
+    private:
+        std::uint32_t m_numThreads;
+        // Null when using the shared pool or a single thread.
+        std::unique_ptr<ThreadPool> m_pThreadPool;
+
+        std::unordered_map<std::uint64_t, AnimationBinding> m_bindings;
+        std::vector<Job> m_jobs;
+        std::uint64_t m_numUpdates;
+};
@@ -1,29 +1,117 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <unordered_map>
 
 #include "Model.h"
 #include "Animation.h"
+#include "CompressedAnimation.h"
 
 // Hold function for dealing with the importing and exporting of assets.
 namespace AssetIO {
+    // Determines how the contents of a file are brought into memory.
+    enum class ReadMode {
+        // Reads the whole file into a temporary buffer with a single read.
+        Stream,
+        // Maps the file into memory and copies the geometry straight out of the mapped pages.
+        // Avoids the temporary buffer, so peak memory usage stays close to the size of the loaded model.
+        MemoryMapped,
+        // Maps the file and only reads the bones, materials and submesh tables.
+        // Every mesh reports its index and vertex counts but loads its geometry on the first **IMesh::UpdateBuffers**,
+        // **IMesh::RequireGeometry** or draw. The file stays mapped until all meshes are loaded.
+        // Version 1 files are loaded completely.
+        DeferredGeometry
+    };
+
     // Imports the meshes and bones from a file.
     // Uses **assimp** and should only be used to import from source files.
     // Should not be used in production code due to the high parsing costs.
-    std::shared_ptr<Model> ImportModel(std::string filePath, std::shared_ptr<Material> material, bool skinned, bool packMeshes);
+    // When **cacheDirectory** is set the result is stored there as an .roxmodl keyed on the contents of the file and the import settings,
+    // later imports of the same file load that entry instead of running **assimp** again.
+    // When **optimizeMeshes** is true every mesh is run through **IMesh::Optimize** with the default settings.
+    std::shared_ptr<Model> ImportModel(std::string filePath, std::shared_ptr<Material> material, bool skinned, bool packMeshes, std::string cacheDirectory = "", bool optimizeMeshes = false);
 
     // Imports all animations from a file.
     // Uses **assimp** and should only be used to import from source files.
     // Should not be used in production code due to the high parsing costs.
-    std::unordered_map<std::string, std::shared_ptr<Animation>> ImportAnimations(std::string filePath);
+    // When **cacheDirectory** is set the result is cached the same way as **ImportModel**, as .roxanim files.
+    std::unordered_map<std::string, std::shared_ptr<Animation>> ImportAnimations(std::string filePath, std::string cacheDirectory = "");
 
     // Imports a model from a .roxmodl file.
-    std::shared_ptr<Model> ImportRoXModl(std::string filePath, std::shared_ptr<Material> pMaterial);
+    std::shared_ptr<Model> ImportRoXModl(std::string filePath, std::shared_ptr<Material> pMaterial, ReadMode mode = ReadMode::Stream);
     // Exports a model object into an .roxmodl file.
-    void ExportRoXModl(std::shared_ptr<Model>& pModel, std::string filePath);
+    // When **compress** is true the index and vertex buffers are stored with a lossless codec,
+    // which usually makes them 2 to 4 times smaller at the cost of decoding them on import.
+    // When **quantize** is true the vertices are stored in their compact form, see VertexTypes.h,
+    // which halves their size but loses precision. They are decoded back to full vertices on import.
+    void ExportRoXModl(std::shared_ptr<Model>& pModel, std::string filePath, bool compress = false, bool quantize = false);
 
     // Imports an animation from a .roxanim file.
+    // Throws when the file holds a compressed animation or is truncated.
     std::shared_ptr<Animation> ImportRoXAnim(std::string filePath);
     // Exports an animation object into an .roxanim file.
     void ExportRoXAnim(std::shared_ptr<Animation>& pAnim, std::string filePath);
+    // Imports a compressed animation from a .roxanim file.
+    // Throws when the file does not hold a compressed animation or is truncated.
+    std::shared_ptr<CompressedAnimation> ImportCompressedRoXAnim(std::string filePath);
+    // Exports a compressed animation into an .roxanim file.
+    void ExportRoXAnim(std::shared_ptr<CompressedAnimation>& pAnim, std::string filePath);
+
+    // Imports assets on a pool of worker threads, every file is decoded as a separate task.
+    // Results are returned as futures, which can be handed to **OnCompleted** to receive them through
+    // a callback on the thread that calls **DispatchCompleted**, usually the main thread.
+    class AsyncImporter {
+        public:
+            // Uses one worker per hardware thread when **numThreads** is 0.
+            AsyncImporter(std::uint32_t numThreads = 0);
+            ~AsyncImporter();
+
+            AsyncImporter(AsyncImporter const&) = delete;
+            AsyncImporter& operator= (AsyncImporter const&) = delete;
+
+        public:
+            std::future<std::shared_ptr<Model>> ImportModel(std::string filePath, std::shared_ptr<Material> pMaterial, bool skinned, bool packMeshes, std::string cacheDirectory = "", bool optimizeMeshes = false);
+            std::future<std::unordered_map<std::string, std::shared_ptr<Animation>>> ImportAnimations(std::string filePath, std::string cacheDirectory = "");
+
+            std::future<std::shared_ptr<Model>> ImportRoXModl(std::string filePath, std::shared_ptr<Material> pMaterial, ReadMode mode = ReadMode::Stream);
+            std::future<std::shared_ptr<Animation>> ImportRoXAnim(std::string filePath);
+
+            // Queues every file at once, the futures are in the same order as **filePaths**.
+            std::vector<std::future<std::shared_ptr<Model>>> ImportRoXModls(const std::vector<std::string>& filePaths, std::shared_ptr<Material> pMaterial, ReadMode mode = ReadMode::Stream);
+            std::vector<std::future<std::shared_ptr<Animation>>> ImportRoXAnims(const std::vector<std::string>& filePaths);
+
+            // Calls **onCompleted** from **DispatchCompleted** once **future** is ready.
+            // Safe to call from a callback, the new callback runs on the next **DispatchCompleted** at the earliest.
+            template<typename T>
+            void OnCompleted(std::future<T> future, std::function<void(T)> onCompleted) {
+                auto pFuture = std::make_shared<std::future<T>>(std::move(future));
+                std::lock_guard<std::mutex> lock(m_pendingMutex);
+                m_pending.push_back([pFuture, onCompleted]() {
+                    if (pFuture->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                        return false;
+
+                    onCompleted(pFuture->get());
+                    return true;
+                });
+            }
+
+            // Runs the callbacks of every import that has finished, on the calling thread.
+            // Rethrows the exception of a failed import, its callback is dropped.
+            void DispatchCompleted();
+
+            std::uint32_t GetNumThreads() const noexcept;
+            std::uint64_t GetNumPending() const noexcept;
+
+        private:
+            // Private implementation.
+            class Impl;
+            std::unique_ptr<Impl> m_pImpl;
+
+            // Returns true once the callback has run.
+            std::vector<std::function<bool()>> m_pending;
+            mutable std::mutex m_pendingMutex;
+    };
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "Animation.h"
+
+// Animation sampled ahead of time at a fixed rate into the final bone matrices of a model.
+// Playing it back only lerps the two nearest frames, which suits looping background animations on crowds.
+// A baked animation belongs to a single skeleton and bind pose, models sharing both can share it.
+// The translation of the root bone can be moved out of the bone matrices into a separate root motion track,
+// letting the game move the model itself.
+class BakedAnimation {
+    public:
+        // Samples **animation** at **sampleRate** frames per time unit on the skeleton and inverse bind pose of **model**.
+        // The translation of the first root along **rootMotionAxes** is moved into the root motion track, relative to the first frame.
+        // The rate is raised slightly so the frames evenly span the animation, with the last one at its end.
+        BakedAnimation(Animation& animation, Model& model, float sampleRate = 30.f, DirectX::XMFLOAT3 rootMotionAxes = { 1.f, 0.f, 1.f });
+
+    public:
+        // Writes the bone matrices of **model**, **timePosition** is clamped to the clip.
+        void Apply(float timePosition, Model& model) const;
+
+        // Offset of the root at **timePosition** relative to the start of the clip.
+        DirectX::XMVECTOR GetRootMotion(float timePosition) const noexcept;
+        // Distance the root moves from **from** to **to**, wrapping around the end of the clip once when **to** is before **from**.
+        DirectX::XMVECTOR GetRootMotionDelta(float from, float to) const noexcept;
+
+    public:
+        std::string GetName() const noexcept;
+
+        float GetStartTime() const noexcept;
+        float GetEndTime() const noexcept;
+        // Rate the frames are actually spaced at, at least the requested rate.
+        float GetSampleRate() const noexcept;
+
+        std::uint32_t GetNumBones() const noexcept;
+        std::uint32_t GetNumFrames() const noexcept;
+        std::uint64_t GetSizeInBytes() const noexcept;
+
+    private:
+        // Frame at or before **timePosition** and the lerp percentage towards the next one.
+        std::uint32_t FindFrame(float timePosition, float& lerpPercent) const noexcept;
+
+    private:
+        std::string m_name;
+
+        float m_startTime;
+        float m_endTime;
+        float m_sampleRate;
+
+        std::uint32_t m_numBones;
+        std::uint32_t m_numFrames;
+
+        // [frame][bone]
+        std::vector<DirectX::XMFLOAT3X4A> m_boneMatrices;
+        // [frame]
+        std::vector<DirectX::XMFLOAT4A> m_rootMotion;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "Animation.h"
+
+// Animation resampled at a fixed rate and stored as a structure of arrays.
+// Every frame holds one plane per component, a plane contains that component of all bones.
+// Sampling interpolates 4 bones per vector instruction and uses a normalized lerp for the rotations.
+// Bone animations without keyframes result in the identity transform.
+class CompiledAnimation : public IAnimationSampler {
+    public:
+        static constexpr std::uint32_t NUM_COMPONENTS = 10;
+
+        // Resamples every bone animation of **animation** at **sampleRate** frames per time unit.
+        // The rate is raised slightly so the frames evenly span the animation, with the last one at its end.
+        CompiledAnimation(Animation& animation, float sampleRate = 30.f);
+
+    public:
+        // Writes the local transformation of every bone into **pose**.
+        void Sample(float timePosition, LocalPose& pose) const override;
+        // Samples into **pose** and builds the matrices from it.
+        void Interpolate(float timePosition, LocalPose& pose, Bone::TransformArray& toParentTransforms) const;
+
+    public:
+        std::string GetName() const noexcept;
+
+        float GetStartTime() const noexcept override;
+        float GetEndTime() const noexcept override;
+        // Rate the frames are actually spaced at, at least the requested rate.
+        float GetSampleRate() const noexcept;
+
+        std::uint32_t GetNumBones() const noexcept;
+        std::uint32_t GetNumFrames() const noexcept;
+
+    private:
+        // Order of the planes in a frame.
+        enum COMPONENT : std::uint32_t {
+            TranslationX, TranslationY, TranslationZ,
+            ScaleX, ScaleY, ScaleZ,
+            RotationX, RotationY, RotationZ, RotationW
+        };
+
+        // Plane of **component** in **frame**, holding 4 bones per vector.
+        const DirectX::XMVECTOR* GetPlane(std::uint32_t frame, std::uint32_t component) const noexcept;
+
+    private:
+        std::string m_name;
+
+        float m_startTime;
+        float m_endTime;
+        float m_sampleRate;
+
+        std::uint32_t m_numBones;
+        std::uint32_t m_numGroups;
+        std::uint32_t m_numFrames;
+
+        // [frame][component][group]
+        std::vector<DirectX::XMVECTOR> m_samples;
+};
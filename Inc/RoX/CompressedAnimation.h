@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "Animation.h"
+
+// Maximum error allowed when removing keyframes.
+// Translations and scales are measured per component, rotations as an angle in radians.
+struct CompressionTolerance {
+    float Translation = 1e-3f;
+    float Scale = 1e-3f;
+    float Rotation = 1e-3f;
+};
+
+// Translation, scale or rotation of a single bone.
+// Constant tracks store their value in **Minimum** and have a single key without data.
+// Other tracks store **NumKeys** 16 bit times followed by 3 values per key, starting at **Offset** in the data.
+// Translations and scales are quantized to 16 bits in the range [Minimum, Minimum + Extent],
+// rotations are stored as the smallest three components of the quaternion in 48 bits.
+#pragma pack(push, compressedTrack, 4)
+struct CompressedTrack {
+    std::uint32_t NumKeys;
+    std::uint32_t Offset;
+    DirectX::XMFLOAT4 Minimum;
+    DirectX::XMFLOAT4 Extent;
+};
+#pragma pack(pop, compressedTrack)
+static_assert(sizeof(CompressedTrack) == 40, "CompressedTrack size mismatch");
+
+// Animation with its keyframes reduced and quantized.
+// Keyframes that are reproduced within the tolerance by interpolating their neighbours are removed,
+// tracks that never change are stored as a single value.
+// Key times are quantized to 16 bits over the length of the clip.
+// Rotations are normalized, zero quaternions become the identity.
+// Sampling decodes the keys directly, the original keyframes are not kept.
+class CompressedAnimation : public IAnimationSampler {
+    public:
+        // Order of the tracks of a bone.
+        enum TRACK : std::uint32_t {
+            Translation,
+            Scale,
+            Rotation,
+            NUM_TRACKS
+        };
+
+    public:
+        CompressedAnimation(Animation& animation, CompressionTolerance tolerance = {});
+        // Takes over already compressed data, used when importing.
+        // Throws when a track reads past the end of **data**.
+        CompressedAnimation(
+                std::string name,
+                float startTime,
+                float endTime,
+                std::vector<CompressedTrack> tracks,
+                std::vector<std::uint16_t> data);
+
+    public:
+        void Sample(float timePosition, LocalPose& pose) const override;
+        void SampleBones(float timePosition, LocalPose& pose, const std::uint16_t* pBoneIndices, std::uint32_t numBones) const override;
+        void Interpolate(float timePosition, Bone::TransformArray& boneTransforms) const;
+        void Apply(float timePosition, Model& model, PoseBuffer& poseBuffer) const;
+
+    public:
+        std::string GetName() const noexcept;
+
+        float GetStartTime() const noexcept override;
+        float GetEndTime() const noexcept override;
+
+        std::uint32_t GetNumBoneAnimations() const noexcept;
+        // Number of keys left after the reduction, constant tracks count as one.
+        std::uint32_t GetNumKeys() const noexcept;
+        std::uint64_t GetSizeInBytes() const noexcept;
+
+        const std::vector<CompressedTrack>& GetTracks() const noexcept;
+        const std::vector<std::uint16_t>& GetData() const noexcept;
+
+    private:
+        // Reduces, quantizes and appends a track, **values** and **times** hold one entry per keyframe.
+        void CompressTrack(TRACK type, const std::vector<DirectX::XMVECTOR>& values, const std::vector<float>& times, float tolerance);
+        DirectX::XMVECTOR SampleTrack(const CompressedTrack& track, TRACK type, float quantizedTime) const;
+
+    private:
+        std::string m_name;
+
+        float m_startTime;
+        float m_endTime;
+        // Converts a time position to the quantized time of the keys.
+        float m_timeScale;
+
+        // [bone][track]
+        std::vector<CompressedTrack> m_tracks;
+        std::vector<std::uint16_t> m_data;
+};
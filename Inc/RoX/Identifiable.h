@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 
 // Abstract class that contains properties that helps the engine identify different objects.
@@ -20,7 +21,8 @@ class Identifiable {
         void SetName(std::string name) noexcept;
 
     private:
-        static std::uint64_t NEXT_GUID;
+        // Atomic so objects can be created on multiple threads at once.
+        static std::atomic<std::uint64_t> NEXT_GUID;
         const std::string m_defaultName;
 
         std::string m_name;
@@ -4,6 +4,7 @@
 
 // Contains helper functions for generating geometric primitives.
 // Adds new geometry to a existing Mesh and adds a new submesh.
+// The bounds of the new submesh are computed from the added vertices.
 namespace MeshFactory {
     enum class Geometry {
         Cube,
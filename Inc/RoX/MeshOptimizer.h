@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Model.h"
+
+// Building blocks of **IMesh::Optimize**, working on the indices of a single submesh.
+// Indices are relative to the first vertex of the submesh.
+namespace MeshOptimizer {
+    // Average number of vertices transformed per triangle with a FIFO cache of **cacheSize** entries.
+    float ComputeACMR(const std::uint32_t* pIndices, std::uint32_t numIndices, std::uint32_t cacheSize = 16);
+
+    // Reorders the triangles in place with tipsify, see "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw".
+    // When **pClusterStarts** is set it receives the first triangle of every cluster, a new cluster starts every time
+    // the order jumps to a vertex that is not part of the last fan.
+    void OptimizeTriangleOrder(std::uint32_t* pIndices, std::uint32_t numIndices, std::uint32_t cacheSize = 16, std::vector<std::uint32_t>* pClusterStarts = nullptr);
+
+    // Sorts the clusters found by **OptimizeTriangleOrder** so the ones facing away from the center of the triangles are drawn first.
+    // Positions are read from the start of every vertex in **pVertices**, which points to the first vertex of the submesh.
+    void OptimizeOverdraw(
+        std::uint32_t* pIndices,
+        std::uint32_t numIndices,
+        const std::vector<std::uint32_t>& clusterStarts,
+        const void* pVertices,
+        std::uint32_t vertexSizeInBytes);
+}
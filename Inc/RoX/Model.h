@@ -1,9 +1,13 @@
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <new>
 #include <vector>
 #include <unordered_set>
 
+#include <DirectXCollision.h>
+
 #include "Identifiable.h"
 #include "VertexTypes.h"
 #include "Material.h"
@@ -20,14 +24,13 @@ class Bone : public Identifiable {
         Bone(std::string name, std::uint32_t parentIndex) noexcept;
 
     public:
-        struct aligned_deleter { void operator()(void* p) noexcept { _aligned_free(p); }};
+        // Goes through the aligned operator new so the allocations are visible to replacement allocators.
+        struct aligned_deleter { void operator()(void* p) noexcept { ::operator delete[](p, std::align_val_t(16)); }};
 
         using TransformArray = std::unique_ptr<DirectX::XMMATRIX[], aligned_deleter>;
 
         static TransformArray MakeArray(std::uint64_t count) {
-            void* temp = _aligned_malloc(sizeof(DirectX::XMMATRIX) * count, 16);
-            if (!temp)
-                throw std::bad_alloc();
+            void* temp = ::operator new[](sizeof(DirectX::XMMATRIX) * count, std::align_val_t(16));
             return TransformArray(static_cast<DirectX::XMMATRIX*>(temp));
         }
 
@@ -42,6 +45,37 @@ class Bone : public Identifiable {
         std::uint32_t m_parentIndex;
 };
 
+// Bones of a model in breadth first order, roots first and every parent before its children.
+// Lets the hierarchy be combined in a single forward sweep without special cases for roots,
+// every level only depends on the levels before it so the bones of a level can be processed in parallel.
+// Any number of bones can be a root by having **Bone::INVALID_INDEX** as parent.
+class Skeleton {
+    public:
+        static constexpr std::uint32_t MAX_BONES = 0xFFFE;
+
+        Skeleton() noexcept = default;
+        // Throws when a parent index is out of range, the bones contain a cycle or there are more than **MAX_BONES**.
+        Skeleton(const std::vector<Bone>& bones);
+
+    public:
+        // Index into **Model::GetBones** of every position in the sweep.
+        const std::vector<std::uint16_t>& GetOrder() const noexcept;
+        // Slot of the parent of every position, 0 for roots and the position of the parent + 1 otherwise.
+        // Slot 0 of the to-root transforms holds the identity.
+        const std::vector<std::uint16_t>& GetParentSlots() const noexcept;
+        // First position of every level followed by the number of bones.
+        const std::vector<std::uint32_t>& GetLevelOffsets() const noexcept;
+
+        std::uint32_t GetNumBones() const noexcept;
+        std::uint32_t GetNumLevels() const noexcept;
+        std::uint32_t GetNumRoots() const noexcept;
+
+    private:
+        std::vector<std::uint16_t> m_order;
+        std::vector<std::uint16_t> m_parentSlots;
+        std::vector<std::uint32_t> m_levelOffsets;
+};
+
 // A submesh determines to which set for vertices in a mesh a material is applied.
 // Does not store it's material but an index into the array of materials in **Model**.
 // The location of a submesh in world space is determined by the transformation in **m_instances**.
@@ -65,6 +99,11 @@ class Submesh : public Identifiable {
 
         std::shared_ptr<Material> GetMaterial(Model& grandParent) const;
 
+        // Bounds of the vertices drawn by the submesh, in the space of its mesh.
+        // Empty at the origin until computed by **IMesh::UpdateBounds** or read from a .roxmodl.
+        const DirectX::BoundingBox& GetBoundingBox() const noexcept;
+        const DirectX::BoundingSphere& GetBoundingSphere() const noexcept;
+
         bool IsVisible() const noexcept;
 
         void SetNumberCulled(std::uint32_t amount);
@@ -72,6 +111,8 @@ class Submesh : public Identifiable {
         void SetIndexCount(std::uint32_t count) noexcept;
         void SetStartIndex(std::uint32_t index) noexcept;
         void SetVertexOffset(std::uint32_t offset) noexcept;
+        // Call **IMesh::MergeBounds** afterwards when the submesh is already part of a mesh.
+        void SetBounds(const DirectX::BoundingBox& box, const DirectX::BoundingSphere& sphere) noexcept;
         void SetVisible(bool visible) noexcept;
 
     private:
@@ -84,6 +125,9 @@ class Submesh : public Identifiable {
         std::uint32_t m_startIndex;
         std::uint32_t m_vertexOffset;
 
+        DirectX::BoundingBox m_boundingBox;
+        DirectX::BoundingSphere m_boundingSphere;
+
         bool m_visible;
 };
 
@@ -91,10 +135,45 @@ class IMesh;
 class Mesh;
 class SkinnedMesh;
 
+// What a mesh does with its vertices and indices once they are uploaded to the GPU.
+// Mutators like **IMesh::TransformVertices** restore released geometry first, it is released again by the next **IMesh::UpdateBuffers**.
+enum class GeometryResidency : std::uint8_t {
+    // Keeps the vertices and indices, the geometry is stored both on the CPU and the GPU.
+    KeepCPUCopy,
+    // Clears the vertices and indices, the copy kept by the renderer is used to recover from a lost device.
+    ReleaseAfterUpload,
+    // Keeps the vertices and indices compressed with the .roxmodl buffer codecs.
+    // Static buffers drop the copy kept by the renderer and use the compressed copy to recover from a lost device.
+    // Dynamic buffers are re-uploaded on every update, so they ignore the compressed copy and behave like **ReleaseAfterUpload**.
+    KeepCompressedCopy
+};
+
+// Settings of **IMesh::Optimize**.
+struct MeshOptimizerSettings {
+    // Number of entries of the post-transform vertex cache the triangle order is tuned for.
+    std::uint32_t CacheSize = 16;
+    // Draws the clusters of triangles facing away from the center of a submesh first, so they occlude the rest.
+    bool ReduceOverdraw = true;
+    // Merges vertices with identical contents.
+    bool DeduplicateVertices = false;
+};
+
+// Result of **IMesh::Optimize**.
+// The ACMR is the average number of vertices transformed per triangle with a FIFO cache of **MeshOptimizerSettings::CacheSize** entries,
+// which lies between 0.5 for a perfect order on a large grid and 3.
+struct MeshOptimizerStats {
+    float ACMRBefore = 0.f;
+    float ACMRAfter = 0.f;
+
+    std::uint32_t NumVerticesBefore = 0;
+    std::uint32_t NumVerticesAfter = 0;
+};
+
 // Mainly used to communicate with the renderer.
 class IMeshObserver {
     public:
         virtual void OnUseStaticBuffers(IMesh* pIMesh, bool useStaticBuffers) = 0;
+        virtual void OnSetResidency(IMesh* pIMesh, GeometryResidency residency) = 0;
         virtual void OnUpdateBuffers(IMesh* pIMesh) = 0;
 
         virtual void OnRebuildFromBuffers(Mesh* pMesh) = 0;
@@ -109,7 +188,8 @@ class IMeshObserver {
 // A mesh contains the vertices and indices of a part of a model.
 // The engine will always keep a copy of the vertices and indices to ensure that it can rebuild it's
 // own state in case of the application loses connection to the GPU.
-// The vertex and index data can safely be removed after it is loaded into the renderer.
+// The vertex and index data can safely be removed after it is loaded into the renderer,
+// **GeometryResidency** does so automatically.
 class IMesh {
     protected:
         IMesh() = default;
@@ -119,14 +199,53 @@ class IMesh {
     public:
         virtual ~IMesh() = default;
 
+        // Fills the indices and vertices of a mesh whose geometry was deferred.
+        // The mesh already counts as resident while it runs, so it can call **UpdateBounds**.
+        using GeometryLoader = std::function<void(IMesh& iMesh)>;
+
+        // Restores released geometry first.
         virtual void UseStaticBuffers(bool useStaticBuffers) = 0;
         // Only when using dynamic buffers.
+        // Loads deferred geometry first.
+        // Indices are uploaded at the current index size, call **SelectIndexSize** first to change it after editing them.
         virtual void UpdateBuffers() = 0;
 
-        virtual void TransformVertices(DirectX::XMMATRIX& M) noexcept = 0;
+        // Leaves the mesh without geometry until it is required, **numIndices** and **numVertices** are reported until then.
+        virtual void DeferGeometry(GeometryLoader loader, std::uint32_t numIndices, std::uint32_t numVertices) = 0;
+        // Loads deferred geometry and notifies the observers, does nothing when the geometry is resident.
+        // Not thread safe.
+        virtual void RequireGeometry() = 0;
+
+        // Releases the vertices and indices according to the residency, called by the renderer after uploading them.
+        virtual void ApplyResidency() = 0;
+        // Brings back the vertices and indices released by **ApplyResidency**, does nothing when they were not released.
+        // Throws when the mesh keeps no compressed copy and no renderer holds a copy either.
+        virtual void RestoreGeometry() = 0;
+
+        // Transforms the positions by **M** and the normals by its inverse transpose, loads deferred or released geometry first.
+        // Large meshes are split over the shared thread pool, so this must not be called from a task running on it, it would deadlock.
+        // Throws when the thread pool fails to schedule the work.
+        virtual void TransformVertices(DirectX::XMMATRIX& M) = 0;
+        // Reorders the triangles of every submesh for the vertex cache and overdraw, then the vertices in the order they are first used.
+        // Submeshes keep their index ranges, nothing changes when they overlap and vertices only move when the submeshes cover every index.
+        // Call **UpdateBuffers** afterwards when the mesh is already loaded by a renderer.
+        virtual MeshOptimizerStats Optimize(const MeshOptimizerSettings& settings = {}) = 0;
+        // Recomputes the bounds of **submesh** from the vertices in its index range, then merges the bounds of the mesh.
+        // Does nothing while the geometry is deferred or released, the bounds kept so far stay valid.
+        virtual void UpdateBounds(Submesh& submesh) noexcept = 0;
+        // Recomputes the bounds of every submesh.
+        virtual void UpdateBounds() noexcept = 0;
+        // Merges the bounds of the submeshes into those of the mesh without walking the vertices.
+        virtual void MergeBounds() noexcept = 0;
         virtual void ClearGeometry() noexcept = 0;
         virtual void RebuildFromBuffers() noexcept = 0;
 
+        // Appends to the indices, switching to 32-bit indices when an appended index does not fit in 16 bits.
+        // Never narrows the index size, only the appended indices are scanned.
+        // Loads deferred or released geometry first.
+        virtual void AppendIndices(const std::uint16_t* pIndices, std::uint64_t numIndices) = 0;
+        virtual void AppendIndices(const std::uint32_t* pIndices, std::uint64_t numIndices) = 0;
+
         virtual void Add(std::unique_ptr<Submesh> pSubmesh) = 0;
         virtual void RemoveSubmesh(std::uint8_t index) = 0;
 
@@ -145,13 +264,42 @@ class IMesh {
 
         virtual std::vector<std::uint32_t>& GetBoneInfluences() noexcept = 0;
         virtual std::vector<std::unique_ptr<Submesh>>& GetSubmeshes() noexcept = 0;
+        // Indices while the index size is 2, empty otherwise.
         virtual std::vector<std::uint16_t>& GetIndices() noexcept = 0;
+        // Indices while the index size is 4, empty otherwise.
+        virtual std::vector<std::uint32_t>& GetWideIndices() noexcept = 0;
+        // Size of an index on the CPU and in the GPU index buffer, either 2 or 4.
+        virtual std::uint32_t GetIndexSizeInBytes() const noexcept = 0;
+        virtual std::uint32_t GetVertexSizeInBytes() const noexcept = 0;
+
+        // Merged bounds of the submeshes that draw at least one index, in the space of the mesh.
+        virtual const DirectX::BoundingBox& GetBoundingBox() const noexcept = 0;
+        virtual const DirectX::BoundingSphere& GetBoundingSphere() const noexcept = 0;
+
+        virtual GeometryResidency GetResidency() const noexcept = 0;
+        // Memory currently used by the vertices and indices on the CPU, compressed or not.
+        virtual std::uint64_t GetGeometrySizeInBytes() const noexcept = 0;
+        // Memory saved by the residency compared to keeping the vertices and indices.
+        virtual std::uint64_t GetResidencySavingsInBytes() const noexcept = 0;
 
         virtual bool IsUsingStaticBuffers() const noexcept = 0;
         virtual bool IsVisible() const noexcept = 0;
+        // False while the geometry is deferred.
+        virtual bool IsGeometryResident() const noexcept = 0;
+        // True while the vertices and indices are released by the residency.
+        virtual bool IsGeometryReleased() const noexcept = 0;
 
         virtual void SetName(std::string name) noexcept = 0;
+        // Restores released geometry first, the new residency is applied right away when the geometry was uploaded before.
+        virtual void SetResidency(GeometryResidency residency) = 0;
         virtual void SetBoneIndex(std::uint32_t boneIndex) noexcept = 0;
+        // Moves the indices to the storage of **size**, loading deferred or released geometry first.
+        // Throws if **size** is not 2 or 4, or if an index does not fit in 16 bits.
+        virtual void SetIndexSizeInBytes(std::uint32_t size) = 0;
+        // Uses 16-bit indices when every index fits, 32-bit otherwise.
+        // Call it after editing the indices through **GetIndices** or **GetWideIndices** to narrow or widen them.
+        // Does nothing while the geometry is deferred or released.
+        virtual void SelectIndexSize() noexcept = 0;
         virtual void SetVisible(bool visible) noexcept = 0;
 };
 
@@ -164,6 +312,21 @@ class BaseMesh : public IMesh, public Identifiable {
         void UseStaticBuffers(bool useStaticBuffers) override;
         void UpdateBuffers() override;
 
+        void DeferGeometry(GeometryLoader loader, std::uint32_t numIndices, std::uint32_t numVertices) override;
+        void RequireGeometry() override;
+
+        void ApplyResidency() override;
+        void RestoreGeometry() override;
+
+        MeshOptimizerStats Optimize(const MeshOptimizerSettings& settings = {}) override;
+
+        void UpdateBounds(Submesh& submesh) noexcept override;
+        void UpdateBounds() noexcept override;
+        void MergeBounds() noexcept override;
+
+        void AppendIndices(const std::uint16_t* pIndices, std::uint64_t numIndices) override;
+        void AppendIndices(const std::uint32_t* pIndices, std::uint64_t numIndices) override;
+
         void Add(std::unique_ptr<Submesh> pSubmesh) override;
 
         void RemoveSubmesh(std::uint8_t index) override;
@@ -183,22 +346,76 @@ class BaseMesh : public IMesh, public Identifiable {
         std::vector<std::uint32_t>& GetBoneInfluences() noexcept override;
         std::vector<std::unique_ptr<Submesh>>& GetSubmeshes() noexcept override;
         std::vector<std::uint16_t>& GetIndices() noexcept override;
+        std::vector<std::uint32_t>& GetWideIndices() noexcept override;
+        std::uint32_t GetIndexSizeInBytes() const noexcept override;
+
+        const DirectX::BoundingBox& GetBoundingBox() const noexcept override;
+        const DirectX::BoundingSphere& GetBoundingSphere() const noexcept override;
+
+        GeometryResidency GetResidency() const noexcept override;
+        std::uint64_t GetGeometrySizeInBytes() const noexcept override;
+        std::uint64_t GetResidencySavingsInBytes() const noexcept override;
 
         bool IsUsingStaticBuffers() const noexcept override;
         bool IsVisible() const noexcept override;
+        bool IsGeometryResident() const noexcept override;
+        bool IsGeometryReleased() const noexcept override;
 
         void SetName(std::string name) noexcept override;
+        void SetResidency(GeometryResidency residency) override;
         void SetBoneIndex(std::uint32_t boneIndex) noexcept override;
+        void SetIndexSizeInBytes(std::uint32_t size) override;
+        void SelectIndexSize() noexcept override;
         void SetVisible(bool visible) noexcept override;
 
+    protected:
+        // Raw access to the vertices of the derived mesh, used to compress and decompress them.
+        virtual void* GetVertexData() noexcept = 0;
+        virtual void ResizeVertices(std::uint32_t numVertices) = 0;
+        // Raw access to the indices at the current index size.
+        void* GetIndexData() noexcept;
+        void ResizeIndices(std::uint32_t numIndices);
+
+        // False while the geometry is deferred or released.
+        bool HasGeometry() const noexcept;
+
+    private:
+        template<typename Index>
+        void AppendIndexArray(const Index* pIndices, std::uint64_t numIndices);
+        // Copies the indices between the 16-bit and 32-bit storage, the caller checks that they fit.
+        void ConvertIndices(std::uint32_t size);
+        // Copy of the indices as 32-bit, for the algorithms that do not care about the index size.
+        std::vector<std::uint32_t> WidenIndices() const;
+        // Stores **indices** at the current index size, widening when one of them does not fit in 16 bits.
+        void StoreIndices(std::vector<std::uint32_t> indices);
+
     protected:
         std::unordered_set<IMeshObserver*> m_iMeshObservers;
 
+        // Only set while the geometry is deferred.
+        GeometryLoader m_geometryLoader;
+        // Reported while the geometry is deferred or released.
+        std::uint32_t m_numDeferredIndices;
+        std::uint32_t m_numDeferredVertices;
+
+        GeometryResidency m_residency;
+        bool m_geometryUploaded;
+        bool m_geometryReleased;
+        // Only filled when keeping a compressed copy.
+        std::vector<std::uint8_t> m_compressedIndices;
+        std::vector<std::uint8_t> m_compressedVertices;
+
         std::uint32_t m_boneIndex;
+        std::uint32_t m_indexSizeInBytes;
 
         std::vector<std::uint32_t> m_boneInfluences;
         std::vector<std::unique_ptr<Submesh>> m_submeshes;
+        // Only one of them is used, picked by **m_indexSizeInBytes**.
         std::vector<std::uint16_t> m_indices;
+        std::vector<std::uint32_t> m_wideIndices;
+
+        DirectX::BoundingBox m_boundingBox;
+        DirectX::BoundingSphere m_boundingSphere;
 
         bool m_usingStaticBuffers;
         bool m_visible;
@@ -209,14 +426,25 @@ class Mesh : public BaseMesh {
     public:
         Mesh(std::string name = "", bool useStaticBuffers = false, bool visible = true) noexcept; 
 
-        void TransformVertices(DirectX::XMMATRIX& M) noexcept override;
+        void TransformVertices(DirectX::XMMATRIX& M) override;
         void ClearGeometry() noexcept override;
         void RebuildFromBuffers() noexcept override;
+
+        // Quantizes the vertices into **compactVertices**, positions are stored relative to the bounds of the mesh.
+        // Returns the quantization needed to decode the positions again.
+        VertexQuantization EncodeCompactVertices(std::vector<VertexPositionNormalTextureCompact>& compactVertices) const;
+        // Replaces the vertices with **numVertices** compact vertices decoded with **quantization**.
+        void DecodeCompactVertices(const VertexPositionNormalTextureCompact* pCompactVertices, std::uint32_t numVertices, const VertexQuantization& quantization);
         
     public:
         std::vector<VertexPositionNormalTexture>& GetVertices() noexcept;
 
         std::uint32_t GetNumVertices() const noexcept override;
+        std::uint32_t GetVertexSizeInBytes() const noexcept override;
+
+    protected:
+        void* GetVertexData() noexcept override;
+        void ResizeVertices(std::uint32_t numVertices) override;
 
     private:
         std::vector<VertexPositionNormalTexture> m_vertices;
@@ -227,14 +455,25 @@ class SkinnedMesh : public BaseMesh {
     public:
         SkinnedMesh(std::string name = "", bool useStaticBuffers = false, bool visible = true) noexcept; 
 
-        void TransformVertices(DirectX::XMMATRIX& M) noexcept override;
+        void TransformVertices(DirectX::XMMATRIX& M) override;
         void ClearGeometry() noexcept override;
         void RebuildFromBuffers() noexcept override;
+
+        // Quantizes the vertices into **compactVertices**, positions are stored relative to the bounds of the mesh.
+        // Returns the quantization needed to decode the positions again.
+        VertexQuantization EncodeCompactVertices(std::vector<VertexPositionNormalTextureSkinningCompact>& compactVertices) const;
+        // Replaces the vertices with **numVertices** compact vertices decoded with **quantization**.
+        void DecodeCompactVertices(const VertexPositionNormalTextureSkinningCompact* pCompactVertices, std::uint32_t numVertices, const VertexQuantization& quantization);
         
     public:
         std::vector<VertexPositionNormalTextureSkinning>& GetVertices() noexcept;
 
         std::uint32_t GetNumVertices() const noexcept override;
+        std::uint32_t GetVertexSizeInBytes() const noexcept override;
+
+    protected:
+        void* GetVertexData() noexcept override;
+        void ResizeVertices(std::uint32_t numVertices) override;
 
     private:
         std::vector<VertexPositionNormalTextureSkinning> m_vertices;
@@ -267,7 +506,30 @@ class Model : public Identifiable {
 
         void ClearGeometry() noexcept;
         void RebuildFromBuffers() noexcept;
-
+        // Loads the deferred geometry of every mesh, then merges the bounds again.
+        void RequireGeometry();
+        // Sets the residency of every mesh.
+        void SetResidency(GeometryResidency residency);
+        // Optimizes every mesh, see **IMesh::Optimize**.
+        void Optimize(const MeshOptimizerSettings& settings = {});
+        // Merges the bounds of every mesh, see **IMesh::MergeBounds**.
+        // Done when meshes are added, removed or transformed, call it after changing the geometry of a mesh in the model.
+        void MergeBounds() noexcept;
+
+        // Rebuilds the skeleton from the bones, needs to be called after changing the hierarchy.
+        void CompileSkeleton();
+
+        // Sets the transform of a bone relative to its parent.
+        // The bone is only marked dirty when **M** differs from its current transform.
+        void SetLocalTransform(std::uint32_t boneIndex, DirectX::FXMMATRIX M);
+        // Recomputes the bone matrices of every dirty bone and its descendants, other bones keep their matrices.
+        // Every bone starts out dirty with the identity as local transform.
+        // Returns the number of bones that were recomputed.
+        std::uint32_t UpdateBoneMatrices();
+        // Forces the next update to recompute every bone, needed after writing to the inverse bind pose matrices.
+        void MarkBonesDirty() noexcept;
+
+        // Both mark every bone dirty.
         void MakeBoneMatricesArray(std::uint64_t count);
         void MakeInverseBoneMatricesArray(std::uint64_t count);
 
@@ -278,8 +540,9 @@ class Model : public Identifiable {
         // Sets every instance of every submesh of every mesh to the given matrix.
         // Should only be used on models that don't use GPU instancing.
         void ApplyWorldTransform(DirectX::XMFLOAT3X4 W) noexcept;
-        // Multiply every vertex in the model with the given matrix.
-        void TransformVertices(DirectX::XMMATRIX& M) noexcept;
+        // Multiply every vertex in the model with the given matrix, normals are multiplied with its inverse transpose.
+        // Must not be called from a task running on the shared thread pool, see **IMesh::TransformVertices**.
+        void TransformVertices(DirectX::XMMATRIX& M);
 
         void Attach(IModelObserver* pIModelObserver);
         void Detach(IModelObserver* pIModelObserver) noexcept;
@@ -292,6 +555,8 @@ class Model : public Identifiable {
         std::shared_ptr<IMesh>& GetIMesh(std::uint64_t GUID);
 
         std::vector<Bone>& GetBones() noexcept;
+        // Compiles the skeleton first when the number of bones changed since the last compile.
+        const Skeleton& GetSkeleton();
 
         Bone::TransformArray& GetBoneMatrices() noexcept;
         Bone::TransformArray& GetInverseBindPoseMatrices() noexcept;
@@ -299,10 +564,16 @@ class Model : public Identifiable {
         // Return's true only if all meshes use static buffers.
         bool IsUsingStaticBuffers() const noexcept;
         bool IsVisible() const noexcept;
+        // Return's true only if no mesh has deferred geometry.
+        bool IsGeometryResident() const noexcept;
 
         // A model is skinned if it contains one material with the **Skinned** effect.
         bool IsSkinned() const noexcept;
 
+        // Bounds of every submesh of every mesh, in the space of the model before any instance transform is applied.
+        const DirectX::BoundingBox& GetBoundingBox() const noexcept;
+        const DirectX::BoundingSphere& GetBoundingSphere() const noexcept;
+
         void SetVisible(bool visible) noexcept;
 
         std::uint32_t GetNumBones() const noexcept;
@@ -311,15 +582,33 @@ class Model : public Identifiable {
         std::uint32_t GetNumMaterials() const noexcept;
         std::uint32_t GetNumVertices() const noexcept;
         std::uint32_t GetNumIndices() const noexcept;
+        // Summed over every mesh, see **IMesh::GetResidencySavingsInBytes**.
+        std::uint64_t GetResidencySavingsInBytes() const noexcept;
     
+    private:
+        // Sizes the local and to-root transforms to the bones, resetting them when the number of bones changed.
+        void ReserveBoneTransforms();
+
     private:
         std::unordered_set<IModelObserver*> m_modelObservers;
 
         std::vector<std::shared_ptr<Material>> m_materials;
         std::vector<std::shared_ptr<IMesh>> m_meshes;
         std::vector<Bone> m_bones;
+        Skeleton m_skeleton;
         Bone::TransformArray m_boneMatrices;
+        // Kept between updates so clean bones do not have to be recomputed.
+        Bone::TransformArray m_localTransforms;
+        // Indexed by skeleton slot, see **Skeleton::GetParentSlots**.
+        Bone::TransformArray m_toRootTransforms;
+        // Per bone, in the order of **m_bones**.
+        std::vector<std::uint8_t> m_dirtyBones;
+        // Per skeleton slot, set when the bone in that slot was recomputed during the current update.
+        std::vector<std::uint8_t> m_dirtySlots;
         Bone::TransformArray m_inverseBindPoseMatrices;
 
+        DirectX::BoundingBox m_boundingBox;
+        DirectX::BoundingSphere m_boundingSphere;
+
         bool m_visible;
 };
@@ -105,3 +105,74 @@ struct VertexPositionNormalTextureSkinning {
 #pragma pack(pop, vpnts)
 
 static_assert(sizeof(VertexPositionNormalTextureSkinning) == 52);
+
+// Maps the positions of compact vertices back to the space of their mesh: position = stored position * Scale + Offset.
+// Offset is the center of the bounds of the mesh and Scale their half extents.
+struct VertexQuantization {
+    DirectX::XMFLOAT3 Offset;
+    DirectX::XMFLOAT3 Scale;
+};
+
+// Compact form of VertexPositionNormalTexture.
+// The position is stored as snorm16 relative to the bounds of its mesh, see VertexQuantization, with w set to 1.
+// The normal is octahedral encoded into two snorm16 values and the texture coordinate is stored as half floats.
+#pragma pack(push, vpntc, 4)
+struct VertexPositionNormalTextureCompact {
+    VertexPositionNormalTextureCompact() = default;
+
+    VertexPositionNormalTextureCompact(const VertexPositionNormalTextureCompact&) = default;
+    VertexPositionNormalTextureCompact& operator=(const VertexPositionNormalTextureCompact&) = default;
+
+    VertexPositionNormalTextureCompact(VertexPositionNormalTextureCompact&&) = default;
+    VertexPositionNormalTextureCompact& operator=(VertexPositionNormalTextureCompact&&) = default;
+
+    DirectX::PackedVector::XMSHORTN4 position;
+    DirectX::PackedVector::XMSHORTN2 normal;
+    DirectX::PackedVector::XMHALF2 textureCoordinate;
+
+    static constexpr D3D12_INPUT_ELEMENT_DESC InputElements[] = {
+        { "SV_Position", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "NORMAL",      0, DXGI_FORMAT_R16G16_SNORM,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD",    0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    };
+    static constexpr D3D12_INPUT_LAYOUT_DESC InputLayout = {
+        InputElements, 3
+    };
+};
+#pragma pack(pop, vpntc)
+
+static_assert(sizeof(VertexPositionNormalTextureCompact) == 16);
+
+// Compact form of VertexPositionNormalTextureSkinning.
+// Stores the position, normal and texture coordinate like VertexPositionNormalTextureCompact,
+// the blend indices as they are in VertexPositionNormalTextureSkinning and the blend weights as unorm8.
+#pragma pack(push, vpntsc, 4)
+struct VertexPositionNormalTextureSkinningCompact {
+    VertexPositionNormalTextureSkinningCompact() = default;
+
+    VertexPositionNormalTextureSkinningCompact(const VertexPositionNormalTextureSkinningCompact&) = default;
+    VertexPositionNormalTextureSkinningCompact& operator=(const VertexPositionNormalTextureSkinningCompact&) = default;
+
+    VertexPositionNormalTextureSkinningCompact(VertexPositionNormalTextureSkinningCompact&&) = default;
+    VertexPositionNormalTextureSkinningCompact& operator=(VertexPositionNormalTextureSkinningCompact&&) = default;
+
+    DirectX::PackedVector::XMSHORTN4 position;
+    DirectX::PackedVector::XMSHORTN2 normal;
+    DirectX::PackedVector::XMHALF2 textureCoordinate;
+    std::uint32_t indices;
+    DirectX::PackedVector::XMUBYTEN4 weights;
+
+    static constexpr D3D12_INPUT_ELEMENT_DESC InputElements[] = {
+        { "SV_Position",  0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "NORMAL",       0, DXGI_FORMAT_R16G16_SNORM,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT,      0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+        { "BLENDWEIGHT",  0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    };
+    static constexpr D3D12_INPUT_LAYOUT_DESC InputLayout = {
+        InputElements, 5
+    };
+};
+#pragma pack(pop, vpntsc)
+
+static_assert(sizeof(VertexPositionNormalTextureSkinningCompact) == 24);
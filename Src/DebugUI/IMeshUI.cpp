@@ -62,6 +62,19 @@ void IMeshUI::Menu(IMesh& iMesh) {
             UpdateScheduler::Get().Add([&](){ iMesh.ClearGeometry(); });
     }
 
+    static const char* residencies[] = { "Keep CPU copy", "Release after upload", "Keep compressed copy" };
+    int residency = static_cast<int>(iMesh.GetResidency());
+    if (ImGui::Combo(Util::GUIDLabel("Residency", iMesh.GetGUID()).c_str(), &residency, residencies, IM_ARRAYSIZE(residencies)))
+        UpdateScheduler::Get().Add([&, residency](){ iMesh.SetResidency(static_cast<GeometryResidency>(residency)); });
+    ImGui::Text("Geometry: %llu bytes, saved %llu bytes", iMesh.GetGeometrySizeInBytes(), iMesh.GetResidencySavingsInBytes());
+
+    if (!iMesh.IsUsingStaticBuffers() && ImGui::Button(Util::GUIDLabel("Optimize", iMesh.GetGUID()).c_str())) {
+        UpdateScheduler::Get().Add([&](){ 
+            iMesh.Optimize(); 
+            iMesh.UpdateBuffers();
+        });
+    }
+
     if (auto pMesh = dynamic_cast<Mesh*>(&iMesh)) {
         ImGui::SeparatorText("Identifiers");
         IdentifiableUI::Menu(*pMesh);
@@ -76,8 +89,12 @@ void IMeshUI::Menu(IMesh& iMesh) {
             MathUI::Vertices(pSkinnedMesh->GetVertices());
 
     }
-    if (ImGui::CollapsingHeader("Indices"))
-        MathUI::Indices(iMesh.GetIndices(), iMesh.GetNumVertices());
+    if (ImGui::CollapsingHeader("Indices")) {
+        if (iMesh.GetIndexSizeInBytes() == sizeof(std::uint16_t))
+            MathUI::Indices(iMesh.GetIndices(), iMesh.GetNumVertices());
+        else
+            MathUI::Indices(iMesh.GetWideIndices(), iMesh.GetNumVertices());
+    }
 }
 
 void IMeshUI::CreatorPopupMenu(Model& model) {
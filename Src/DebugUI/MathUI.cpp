@@ -97,7 +97,9 @@ void MathUI::Vertices(std::vector<VertexPositionNormalTextureSkinning>& vertices
         Vertex(vertices[index]);
 }
 
-void MathUI::Indices(std::vector<std::uint16_t>& indices, std::uint16_t numVertices) {
+// Shared by the 16-bit and 32-bit indices, **dataType** matches **Index**.
+template<typename Index>
+void IndexArray(std::vector<Index>& indices, std::uint32_t numVertices, ImGuiDataType dataType) {
     static std::uint32_t index = 0;
     if (index < 0)
         index = 0;
@@ -114,23 +116,31 @@ void MathUI::Indices(std::vector<std::uint16_t>& indices, std::uint16_t numVerti
         }
     };
     ImGui::Text("Indices: %lu", (unsigned long)indices.size());
-    ImGui::Text("Vertices: %d", numVertices);
+    ImGui::Text("Vertices: %u", numVertices);
 
     ImGui::Separator();
     GeneralUI::ArrayControls("index##Indices", &index, onAdd, onRemove);
     if (index >= 0 && index < indices.size()) {
-        std::uint16_t selectedIndex = indices[index];
+        Index selectedIndex = indices[index];
         if (selectedIndex < 0)
             selectedIndex = 0;
         if (selectedIndex >= numVertices)
-            selectedIndex = numVertices - 1;
-        if (ImGui::DragScalar("vertex index", ImGuiDataType_U16, &selectedIndex)) {
+            selectedIndex = static_cast<Index>(numVertices - 1);
+        if (ImGui::DragScalar("vertex index", dataType, &selectedIndex)) {
             if (selectedIndex >= 0 && index < numVertices) 
                 indices[index] = selectedIndex;
         }
     }
 }
 
+void MathUI::Indices(std::vector<std::uint16_t>& indices, std::uint32_t numVertices) {
+    IndexArray(indices, numVertices, ImGuiDataType_U16);
+}
+
+void MathUI::Indices(std::vector<std::uint32_t>& indices, std::uint32_t numVertices) {
+    IndexArray(indices, numVertices, ImGuiDataType_U32);
+}
+
 void MathUI::Matrix(DirectX::XMMATRIX& matrix) {
     DirectX::XMFLOAT4X4 M;
     DirectX::XMStoreFloat4x4(&M, matrix);
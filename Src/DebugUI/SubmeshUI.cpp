@@ -71,6 +71,12 @@ void SubmeshUI::VertexIndexing(Submesh& submesh) {
     if (ImGui::InputScalar("Vertex offset", ImGuiDataType_U32, &vertexOffset, &steps))
         submesh.SetVertexOffset(vertexOffset);
     ImGui::PopItemWidth();
+
+    const DirectX::BoundingBox& box = submesh.GetBoundingBox();
+    const DirectX::BoundingSphere& sphere = submesh.GetBoundingSphere();
+    ImGui::Text("Box center:    %.3f %.3f %.3f", box.Center.x, box.Center.y, box.Center.z);
+    ImGui::Text("Box extents:   %.3f %.3f %.3f", box.Extents.x, box.Extents.y, box.Extents.z);
+    ImGui::Text("Sphere radius: %.3f", sphere.Radius);
 }
 
 void SubmeshUI::Selector(std::uint32_t& index, const std::vector<std::unique_ptr<Submesh>>& submeshes) {
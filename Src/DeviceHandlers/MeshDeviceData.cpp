@@ -1,14 +1,36 @@
 #include "MeshDeviceData.h"
 
+// Indices of **iMesh** at its index size.
+const void* GetIndexData(IMesh& iMesh) {
+    if (iMesh.GetIndexSizeInBytes() == sizeof(std::uint16_t))
+        return iMesh.GetIndices().data();
+    return iMesh.GetWideIndices().data();
+}
+
+// Copies **numIndices** indices of **indexSizeInBytes** back into the storage of **iMesh** for that size.
+void CopyIndices(IMesh& iMesh, const void* pSource, std::uint32_t numIndices, std::uint32_t indexSizeInBytes) {
+    iMesh.SetIndexSizeInBytes(indexSizeInBytes);
+    if (indexSizeInBytes == sizeof(std::uint16_t)) {
+        iMesh.GetIndices().resize(numIndices);
+        memcpy(iMesh.GetIndices().data(), pSource, static_cast<std::uint64_t>(numIndices) * indexSizeInBytes);
+    } else {
+        iMesh.GetWideIndices().resize(numIndices);
+        memcpy(iMesh.GetWideIndices().data(), pSource, static_cast<std::uint64_t>(numIndices) * indexSizeInBytes);
+    }
+}
+
 MeshDeviceData::MeshDeviceData(DeviceResources& deviceResources, IMesh& iMesh) 
     : m_deviceResources(deviceResources),
+    m_iMesh(iMesh),
     m_indexBufferSizeInBytes(0),
     m_vertexBufferSizeInBytes(0),
     m_numIndices(iMesh.GetNumIndices()),
     m_numVertices(iMesh.GetNumVertices()),
     m_primitiveType(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST),
-    m_indexFormat(DXGI_FORMAT_R16_UINT),
-    m_usingStaticBuffers(iMesh.IsUsingStaticBuffers())
+    m_indexFormat(iMesh.GetIndexSizeInBytes() == sizeof(std::uint16_t) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT),
+    m_usingStaticBuffers(iMesh.IsUsingStaticBuffers()),
+    m_geometryPending(!iMesh.IsGeometryResident()),
+    m_restoreFromMesh(false)
 {
     m_deviceResources.Attach(this);
     iMesh.Attach(this);
@@ -18,13 +40,19 @@ MeshDeviceData::MeshDeviceData(DeviceResources& deviceResources, IMesh& iMesh)
         OnAdd(iMesh.GetSubmeshes()[i]);
     }
 
+    if (m_geometryPending)
+        return;
+
+    // The mesh may already be uploaded and released by another batch.
+    iMesh.RestoreGeometry();
     LoadIndexBuffer(&iMesh);
     LoadVertexBuffer(&iMesh);
 
     if (m_usingStaticBuffers) {
-        LoadStaticIndexBuffer(true);
-        LoadStaticVertexBuffer(true);
+        LoadStaticIndexBuffer(KeepsUploadBuffers());
+        LoadStaticVertexBuffer(KeepsUploadBuffers());
     }
+    iMesh.ApplyResidency();
 }
 
 MeshDeviceData::~MeshDeviceData() {
@@ -32,11 +60,17 @@ MeshDeviceData::~MeshDeviceData() {
 }
 
 void MeshDeviceData::OnDeviceLost() {
-    m_indexData.resize(m_indexBufferSizeInBytes);
-    memcpy(m_indexData.data(), m_indexBuffer.Memory(), m_indexBufferSizeInBytes);
+    if (m_geometryPending)
+        return;
 
-    m_vertexData.resize(m_vertexBufferSizeInBytes);
-    memcpy(m_vertexData.data(), m_vertexBuffer.Memory(), m_vertexBufferSizeInBytes);
+    m_restoreFromMesh = !m_indexBuffer || !m_vertexBuffer;
+    if (!m_restoreFromMesh) {
+        m_indexData.resize(m_indexBufferSizeInBytes);
+        memcpy(m_indexData.data(), m_indexBuffer.Memory(), m_indexBufferSizeInBytes);
+
+        m_vertexData.resize(m_vertexBufferSizeInBytes);
+        memcpy(m_vertexData.data(), m_vertexBuffer.Memory(), m_vertexBufferSizeInBytes);
+    }
 
     m_indexBuffer.Reset();
     m_vertexBuffer.Reset();
@@ -45,39 +79,72 @@ void MeshDeviceData::OnDeviceLost() {
 }
 
 void MeshDeviceData::OnDeviceRestored() {
+    if (m_geometryPending)
+        return;
+
     ID3D12Device* pDevice = m_deviceResources.GetDevice();
 
-    m_indexBuffer = DirectX::GraphicsMemory::Get(pDevice).Allocate(m_indexBufferSizeInBytes, 16, DirectX::GraphicsMemory::TAG_INDEX);
-    memcpy(m_indexBuffer.Memory(), m_indexData.data(), m_indexBufferSizeInBytes);
+    if (m_restoreFromMesh) {
+        m_iMesh.RestoreGeometry();
+        LoadIndexBuffer(&m_iMesh);
+        LoadVertexBuffer(&m_iMesh);
+    } else {
+        m_indexBuffer = DirectX::GraphicsMemory::Get(pDevice).Allocate(m_indexBufferSizeInBytes, 16, DirectX::GraphicsMemory::TAG_INDEX);
+        memcpy(m_indexBuffer.Memory(), m_indexData.data(), m_indexBufferSizeInBytes);
 
-    m_vertexBuffer = DirectX::GraphicsMemory::Get(pDevice).Allocate(m_vertexBufferSizeInBytes, 16, DirectX::GraphicsMemory::TAG_VERTEX);
-    memcpy(m_vertexBuffer.Memory(), m_vertexData.data(), m_vertexBufferSizeInBytes);
+        m_vertexBuffer = DirectX::GraphicsMemory::Get(pDevice).Allocate(m_vertexBufferSizeInBytes, 16, DirectX::GraphicsMemory::TAG_VERTEX);
+        memcpy(m_vertexBuffer.Memory(), m_vertexData.data(), m_vertexBufferSizeInBytes);
+    }
 
     if (m_usingStaticBuffers) {
-        LoadStaticIndexBuffer(true);
-        LoadStaticVertexBuffer(true);
+        LoadStaticIndexBuffer(KeepsUploadBuffers());
+        LoadStaticVertexBuffer(KeepsUploadBuffers());
     }
     m_indexData.clear();
     m_vertexData.clear();
+
+    if (m_restoreFromMesh)
+        m_iMesh.ApplyResidency();
+    m_restoreFromMesh = false;
 }
 
 void MeshDeviceData::OnUseStaticBuffers(IMesh* pIMesh, bool useStaticBuffers) {
     m_usingStaticBuffers = useStaticBuffers;
+    if (m_geometryPending)
+        return;
 
     m_deviceResources.WaitForGpu();
 
     if (!m_indexBuffer && !m_vertexBuffer) {
+        pIMesh->RestoreGeometry();
         LoadIndexBuffer(pIMesh);
         LoadVertexBuffer(pIMesh);
     }
 
     if (useStaticBuffers && !m_pStaticIndexBuffer && !m_pStaticVertexBuffer) {
-        LoadStaticIndexBuffer(true);
-        LoadStaticVertexBuffer(true);
+        LoadStaticIndexBuffer(KeepsUploadBuffers());
+        LoadStaticVertexBuffer(KeepsUploadBuffers());
     } else {
         m_pStaticIndexBuffer.Reset();
         m_pStaticVertexBuffer.Reset();
     }
+    pIMesh->ApplyResidency();
+}
+
+void MeshDeviceData::OnSetResidency(IMesh* pIMesh, GeometryResidency residency) {
+    if (m_geometryPending)
+        return;
+
+    m_deviceResources.WaitForGpu();
+
+    // The mesh restores its geometry before notifying, so the upload buffers can be rebuilt from it.
+    if (KeepsUploadBuffers() && (!m_indexBuffer || !m_vertexBuffer)) {
+        LoadIndexBuffer(pIMesh);
+        LoadVertexBuffer(pIMesh);
+    } else if (!KeepsUploadBuffers() && m_pStaticIndexBuffer && m_pStaticVertexBuffer) {
+        m_indexBuffer.Reset();
+        m_vertexBuffer.Reset();
+    }
 }
 
 void MeshDeviceData::OnUpdateBuffers(IMesh* pIMesh) {
@@ -86,23 +153,35 @@ void MeshDeviceData::OnUpdateBuffers(IMesh* pIMesh) {
     m_numIndices = pIMesh->GetNumIndices();
     m_numVertices = pIMesh->GetNumVertices();
 
-    if (m_indexBuffer && m_vertexBuffer) {
+    if (m_geometryPending) {
+        LoadIndexBuffer(pIMesh);
+        LoadVertexBuffer(pIMesh);
+        if (m_usingStaticBuffers) {
+            LoadStaticIndexBuffer(KeepsUploadBuffers());
+            LoadStaticVertexBuffer(KeepsUploadBuffers());
+        }
+        m_geometryPending = false;
+    } else if (m_indexBuffer && m_vertexBuffer) {
         LoadIndexBuffer(pIMesh);
         LoadVertexBuffer(pIMesh);
     }
 }
 
 void MeshDeviceData::OnRebuildFromBuffers(Mesh* pMesh) {
-    pMesh->GetIndices().resize(m_numIndices);
-    memcpy(pMesh->GetIndices().data(), m_indexBuffer.Memory(), m_indexBufferSizeInBytes);
+    if (m_geometryPending || !m_indexBuffer || !m_vertexBuffer)
+        return;
+
+    CopyIndices(*pMesh, m_indexBuffer.Memory(), m_numIndices, GetIndexSizeInBytes());
 
     pMesh->GetVertices().resize(m_numVertices);
     memcpy(pMesh->GetVertices().data(), m_vertexBuffer.Memory(), m_vertexBufferSizeInBytes);
 }
 
 void MeshDeviceData::OnRebuildFromBuffers(SkinnedMesh* pMesh) {
-    pMesh->GetIndices().resize(m_numIndices);
-    memcpy(pMesh->GetIndices().data(), m_indexBuffer.Memory(), m_indexBufferSizeInBytes);
+    if (m_geometryPending || !m_indexBuffer || !m_vertexBuffer)
+        return;
+
+    CopyIndices(*pMesh, m_indexBuffer.Memory(), m_numIndices, GetIndexSizeInBytes());
 
     pMesh->GetVertices().resize(m_numVertices);
     memcpy(pMesh->GetVertices().data(), m_vertexBuffer.Memory(), m_vertexBufferSizeInBytes);
@@ -120,13 +199,16 @@ void MeshDeviceData::OnRemoveSubmesh(std::uint8_t index) {
 void MeshDeviceData::LoadIndexBuffer(IMesh* pIMesh) {
     ID3D12Device* pDevice = m_deviceResources.GetDevice();
 
-    std::uint32_t sizeInBytes = static_cast<std::uint32_t>(pIMesh->GetNumIndices()) * sizeof(std::uint16_t);
-    if (sizeInBytes > static_cast<std::uint32_t>(D3D12_REQ_RESOURCE_SIZE_IN_MEGABYTES_EXPRESSION_A_TERM * 1024u * 1024u))
+    std::uint32_t indexSizeInBytes = pIMesh->GetIndexSizeInBytes();
+
+    std::uint64_t sizeInBytes = static_cast<std::uint64_t>(pIMesh->GetNumIndices()) * indexSizeInBytes;
+    if (sizeInBytes > static_cast<std::uint64_t>(D3D12_REQ_RESOURCE_SIZE_IN_MEGABYTES_EXPRESSION_A_TERM * 1024u * 1024u))
         throw std::invalid_argument("IB too large for DirectX 12");
 
-    m_indexBufferSizeInBytes = sizeInBytes;
-    m_indexBuffer = DirectX::GraphicsMemory::Get(pDevice).Allocate(sizeInBytes, 16, DirectX::GraphicsMemory::TAG_INDEX);
-    memcpy(m_indexBuffer.Memory(), pIMesh->GetIndices().data(), sizeInBytes);
+    m_indexFormat = indexSizeInBytes == sizeof(std::uint16_t) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    m_indexBufferSizeInBytes = static_cast<std::uint32_t>(sizeInBytes);
+    m_indexBuffer = DirectX::GraphicsMemory::Get(pDevice).Allocate(m_indexBufferSizeInBytes, 16, DirectX::GraphicsMemory::TAG_INDEX);
+    memcpy(m_indexBuffer.Memory(), GetIndexData(*pIMesh), m_indexBufferSizeInBytes);
 }
 
 void MeshDeviceData::LoadVertexBuffer(IMesh* pIMesh) {
@@ -144,11 +226,6 @@ void MeshDeviceData::LoadVertexBuffer(IMesh* pIMesh) {
         throw std::runtime_error("Mesh failed to downcast.");
     }
 
-    if (pIMesh->GetNumVertices() >= USHRT_MAX)
-        throw std::invalid_argument("Too many vertices for a 16-bit index buffer");
-    if (pIMesh->GetNumIndices() > UINT32_MAX)
-        throw std::invalid_argument("Too many indices");
-
     std::uint32_t sizeInBytes = static_cast<std::uint32_t>(pIMesh->GetNumVertices()) * m_vertexStride;
     if (sizeInBytes > static_cast<std::uint32_t>(D3D12_REQ_RESOURCE_SIZE_IN_MEGABYTES_EXPRESSION_A_TERM * 1024u * 1024u))
         throw std::invalid_argument("VB too large for DirectX 12");
@@ -236,6 +313,14 @@ std::uint32_t MeshDeviceData::GetIndexBufferSize() const noexcept {
     return m_indexBufferSizeInBytes;
 }
 
+std::uint32_t MeshDeviceData::GetIndexSizeInBytes() const noexcept {
+    return m_indexFormat == DXGI_FORMAT_R16_UINT ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+}
+
+DXGI_FORMAT MeshDeviceData::GetIndexFormat() const noexcept {
+    return m_indexFormat;
+}
+
 std::uint32_t MeshDeviceData::GetVertexBufferSize() const noexcept {
     return m_vertexBufferSizeInBytes;
 }
@@ -276,3 +361,11 @@ std::uint32_t MeshDeviceData::GetNumSubmeshes() const noexcept {
     return m_submeshes.size();
 }
 
+bool MeshDeviceData::IsGeometryPending() const noexcept {
+    return m_geometryPending;
+}
+
+bool MeshDeviceData::KeepsUploadBuffers() const noexcept {
+    return !m_usingStaticBuffers || m_iMesh.GetResidency() != GeometryResidency::KeepCompressedCopy;
+}
+
@@ -11,6 +11,8 @@
 // Manages index and vertex buffers for a mesh.
 // **m_indexBuffer** and **m_vertexBuffer** will ALWAYS contain data, even when using static buffers.
 // This so that the object can rebuild itself after the device is lost.
+// The only exception are static buffers of a mesh that keeps a compressed copy of its geometry,
+// those are rebuilt from the mesh instead.
 class MeshDeviceData : public IDeviceObserver, public IMeshObserver {
     public:
         MeshDeviceData(DeviceResources& deviceResources, IMesh& iMesh);
@@ -21,6 +23,7 @@ class MeshDeviceData : public IDeviceObserver, public IMeshObserver {
         void OnDeviceRestored() override;
 
         void OnUseStaticBuffers(IMesh* pIMesh, bool useStaticBuffers) override;
+        void OnSetResidency(IMesh* pIMesh, GeometryResidency residency) override;
         void OnUpdateBuffers(IMesh* pIMesh) override;
 
         void OnRebuildFromBuffers(Mesh* pMesh) override;
@@ -43,6 +46,8 @@ class MeshDeviceData : public IDeviceObserver, public IMeshObserver {
         std::vector<std::unique_ptr<SubmeshDeviceData>>& GetSubmeshes() noexcept;
 
         std::uint32_t GetIndexBufferSize() const noexcept;
+        std::uint32_t GetIndexSizeInBytes() const noexcept;
+        DXGI_FORMAT GetIndexFormat() const noexcept;
         std::uint32_t GetVertexBufferSize() const noexcept;
 
         DirectX::SharedGraphicsResource& GetIndexBuffer() noexcept;
@@ -59,8 +64,13 @@ class MeshDeviceData : public IDeviceObserver, public IMeshObserver {
 
         std::uint32_t GetNumSubmeshes() const noexcept;
 
+        bool IsGeometryPending() const noexcept;
+        // False when the static buffers are the only copy on the GPU.
+        bool KeepsUploadBuffers() const noexcept;
+
     private:
         DeviceResources& m_deviceResources;
+        IMesh& m_iMesh;
 
         std::vector<std::unique_ptr<SubmeshDeviceData>> m_submeshes;
 
@@ -75,6 +85,8 @@ class MeshDeviceData : public IDeviceObserver, public IMeshObserver {
         DXGI_FORMAT m_indexFormat;
 
         bool m_usingStaticBuffers;
+        // Set while the geometry of the mesh is deferred, the buffers are loaded on the first **OnUpdateBuffers**.
+        bool m_geometryPending;
         DirectX::SharedGraphicsResource m_indexBuffer;
         DirectX::SharedGraphicsResource m_vertexBuffer;
         Microsoft::WRL::ComPtr<ID3D12Resource> m_pStaticIndexBuffer;
@@ -84,4 +96,6 @@ class MeshDeviceData : public IDeviceObserver, public IMeshObserver {
         // Outside of this use case these vectors should NOT store any data.
         std::vector<char> m_vertexData;
         std::vector<char> m_indexData;
+        // Set when the device was lost without upload buffers to copy from, the buffers are rebuilt from the mesh.
+        bool m_restoreFromMesh;
 };
@@ -94,6 +94,8 @@ void ModelDeviceData::LoadStaticBuffers(ID3D12Device* pDevice, DirectX::Resource
 
     for (auto it = uniqueMeshes.cbegin(); it != uniqueMeshes.cend(); ++it) {
         MeshDeviceData* pMeshData = *it;
+        if (pMeshData->IsGeometryPending())
+            continue;
 
         if (!pMeshData->GetStaticVertexBuffer()) {
             if (!pMeshData->GetVertexBuffer())
@@ -0,0 +1,279 @@
+#include "BufferCodec.h"
+
+namespace {
+    std::uint32_t ZigzagEncode(std::int32_t value) noexcept {
+        return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+    }
+
+    std::int32_t ZigzagDecode(std::uint32_t value) noexcept {
+        return static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+    }
+
+    std::uint8_t ZigzagEncode(std::uint8_t delta) noexcept {
+        return static_cast<std::uint8_t>((delta << 1) ^ (static_cast<std::int8_t>(delta) >> 7));
+    }
+
+    std::uint8_t ZigzagDecode(std::uint8_t value) noexcept {
+        return static_cast<std::uint8_t>((value >> 1) ^ -(value & 1));
+    }
+
+    std::uint32_t ReadIndex(const std::uint8_t* pIndices, std::uint64_t i, std::uint32_t indexSizeInBytes) noexcept {
+        if (indexSizeInBytes == sizeof(std::uint16_t)) {
+            std::uint16_t index;
+            memcpy(&index, pIndices + i * sizeof(std::uint16_t), sizeof(std::uint16_t));
+            return index;
+        }
+        std::uint32_t index;
+        memcpy(&index, pIndices + i * sizeof(std::uint32_t), sizeof(std::uint32_t));
+        return index;
+    }
+
+    void ValidateIndexSize(std::uint32_t indexSizeInBytes) {
+        if (indexSizeInBytes != sizeof(std::uint16_t) && indexSizeInBytes != sizeof(std::uint32_t))
+            throw std::invalid_argument("Unsupported index size: " + std::to_string(indexSizeInBytes));
+    }
+
+    // Bits per value for every width code.
+    constexpr std::uint32_t GROUP_BITS[4] = { 0, 2, 4, 8 };
+
+    std::uint32_t SelectWidthCode(const std::uint8_t* pGroup) noexcept {
+        std::uint8_t combined = 0;
+        for (std::uint32_t i = 0; i < BufferCodec::GROUP_SIZE; ++i) {
+            combined |= pGroup[i];
+        }
+
+        if (combined == 0)
+            return 0;
+        if (combined < (1 << 2))
+            return 1;
+        if (combined < (1 << 4))
+            return 2;
+        return 3;
+    }
+
+    void PackGroup(const std::uint8_t* pGroup, std::uint32_t bits, std::vector<std::uint8_t>& data) {
+        if (bits == 0)
+            return;
+        if (bits == 8) {
+            data.insert(data.end(), pGroup, pGroup + BufferCodec::GROUP_SIZE);
+            return;
+        }
+
+        std::uint32_t valuesPerByte = 8 / bits;
+        for (std::uint32_t i = 0; i < BufferCodec::GROUP_SIZE; i += valuesPerByte) {
+            std::uint8_t byte = 0;
+            for (std::uint32_t j = 0; j < valuesPerByte; ++j) {
+                byte |= pGroup[i + j] << (j * bits);
+            }
+            data.push_back(byte);
+        }
+    }
+
+    // Adds the zigzag encoded deltas in **pVertex** to **pPrevious** and writes the result to both.
+    void ResolveDeltas(std::uint8_t* pVertex, std::uint8_t* pPrevious, std::uint32_t vertexSizeInBytes) noexcept {
+        std::uint32_t k = 0;
+#ifdef _XM_SSE_INTRINSICS_
+        // SSE2 has no 8 bit shift, the 16 bit shift is masked instead.
+        const __m128i lowBits = _mm_set1_epi8(0x7F);
+        const __m128i one = _mm_set1_epi8(1);
+        for (; k + 16 <= vertexSizeInBytes; k += 16) {
+            __m128i encoded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pVertex + k));
+            __m128i magnitude = _mm_and_si128(_mm_srli_epi16(encoded, 1), lowBits);
+            __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(encoded, one));
+            __m128i delta = _mm_xor_si128(magnitude, sign);
+
+            __m128i value = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pPrevious + k)), delta);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pPrevious + k), value);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pVertex + k), value);
+        }
+#endif
+        for (; k < vertexSizeInBytes; ++k) {
+            pPrevious[k] = static_cast<std::uint8_t>(pPrevious[k] + ZigzagDecode(pVertex[k]));
+            pVertex[k] = pPrevious[k];
+        }
+    }
+
+    void UnpackGroup(const std::uint8_t* pData, std::uint32_t bits, std::uint8_t* pGroup) noexcept {
+        switch (bits) {
+            case 0:
+                memset(pGroup, 0, BufferCodec::GROUP_SIZE);
+                break;
+            case 2:
+                for (std::uint32_t i = 0; i < BufferCodec::GROUP_SIZE / 4; ++i) {
+                    std::uint8_t byte = pData[i];
+                    pGroup[i * 4 + 0] = byte & 0x3;
+                    pGroup[i * 4 + 1] = (byte >> 2) & 0x3;
+                    pGroup[i * 4 + 2] = (byte >> 4) & 0x3;
+                    pGroup[i * 4 + 3] = byte >> 6;
+                }
+                break;
+            case 4:
+                for (std::uint32_t i = 0; i < BufferCodec::GROUP_SIZE / 2; ++i) {
+                    std::uint8_t byte = pData[i];
+                    pGroup[i * 2 + 0] = byte & 0xF;
+                    pGroup[i * 2 + 1] = byte >> 4;
+                }
+                break;
+            default:
+                memcpy(pGroup, pData, BufferCodec::GROUP_SIZE);
+                break;
+        }
+    }
+}
+
+std::vector<std::uint8_t> BufferCodec::EncodeIndices(const void* pIndices, std::uint64_t numIndices, std::uint32_t indexSizeInBytes) {
+    ValidateIndexSize(indexSizeInBytes);
+
+    std::vector<std::uint8_t> data;
+    data.reserve(numIndices + numIndices / 4);
+
+    auto pBytes = static_cast<const std::uint8_t*>(pIndices);
+    std::uint32_t previous = 0;
+    for (std::uint64_t i = 0; i < numIndices; ++i) {
+        std::uint32_t index = ReadIndex(pBytes, i, indexSizeInBytes);
+        std::uint32_t value = ZigzagEncode(static_cast<std::int32_t>(index - previous));
+        previous = index;
+
+        while (value >= 0x80) {
+            data.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        data.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    return data;
+}
+
+void BufferCodec::DecodeIndices(void* pIndices, std::uint64_t numIndices, std::uint32_t indexSizeInBytes, const std::uint8_t* pData, std::uint64_t sizeInBytes) {
+    ValidateIndexSize(indexSizeInBytes);
+
+    const std::uint8_t* pEnd = pData + sizeInBytes;
+    auto pBytes = static_cast<std::uint8_t*>(pIndices);
+    std::uint32_t previous = 0;
+    for (std::uint64_t i = 0; i < numIndices; ++i) {
+        std::uint32_t value = 0;
+        for (std::uint32_t shift = 0; ; shift += 7) {
+            if (pData == pEnd || shift > 28)
+                throw std::runtime_error("Malformed index buffer.");
+
+            std::uint8_t byte = *pData++;
+            value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+
+        previous += static_cast<std::uint32_t>(ZigzagDecode(value));
+        if (indexSizeInBytes == sizeof(std::uint16_t)) {
+            std::uint16_t index = static_cast<std::uint16_t>(previous);
+            memcpy(pBytes + i * sizeof(std::uint16_t), &index, sizeof(std::uint16_t));
+        } else
+            memcpy(pBytes + i * sizeof(std::uint32_t), &previous, sizeof(std::uint32_t));
+    }
+
+    if (pData != pEnd)
+        throw std::runtime_error("Malformed index buffer.");
+}
+
+std::vector<std::uint8_t> BufferCodec::EncodeVertices(const void* pVertices, std::uint64_t numVertices, std::uint32_t vertexSizeInBytes) {
+    std::vector<std::uint8_t> data;
+    data.reserve(numVertices * vertexSizeInBytes / 2);
+
+    auto pBytes = static_cast<const std::uint8_t*>(pVertices);
+    std::vector<std::uint8_t> previous(vertexSizeInBytes, 0);
+    std::uint8_t plane[BLOCK_SIZE];
+
+    for (std::uint64_t blockStart = 0; blockStart < numVertices; blockStart += BLOCK_SIZE) {
+        std::uint32_t blockCount = static_cast<std::uint32_t>(std::min<std::uint64_t>(BLOCK_SIZE, numVertices - blockStart));
+        std::uint32_t numGroups = (blockCount + GROUP_SIZE - 1) / GROUP_SIZE;
+
+        for (std::uint32_t k = 0; k < vertexSizeInBytes; ++k) {
+            // Padding of the last group decodes to a delta of 0 and is ignored.
+            memset(plane, 0, sizeof(plane));
+            for (std::uint32_t i = 0; i < blockCount; ++i) {
+                std::uint8_t byte = pBytes[(blockStart + i) * vertexSizeInBytes + k];
+                plane[i] = ZigzagEncode(static_cast<std::uint8_t>(byte - previous[k]));
+                previous[k] = byte;
+            }
+
+            std::uint64_t headerOffset = data.size();
+            data.resize(data.size() + (numGroups + 3) / 4, 0);
+            for (std::uint32_t g = 0; g < numGroups; ++g) {
+                std::uint32_t code = SelectWidthCode(plane + g * GROUP_SIZE);
+                data[headerOffset + g / 4] |= static_cast<std::uint8_t>(code << ((g % 4) * 2));
+                PackGroup(plane + g * GROUP_SIZE, GROUP_BITS[code], data);
+            }
+        }
+    }
+
+    return data;
+}
+
+void BufferCodec::DecodeVertices(void* pVertices, std::uint64_t numVertices, std::uint32_t vertexSizeInBytes, const std::uint8_t* pData, std::uint64_t sizeInBytes) {
+    const std::uint8_t* pEnd = pData + sizeInBytes;
+    auto pBytes = static_cast<std::uint8_t*>(pVertices);
+    std::vector<std::uint8_t> previous(vertexSizeInBytes, 0);
+
+    // Planes are decoded 4 at a time so every vertex receives a 4 byte store instead of 4 single byte stores.
+    const std::uint8_t* pHeaders[4];
+    const std::uint8_t* pPayloads[4];
+    std::uint8_t groups[4][GROUP_SIZE];
+
+    for (std::uint64_t blockStart = 0; blockStart < numVertices; blockStart += BLOCK_SIZE) {
+        std::uint32_t blockCount = static_cast<std::uint32_t>(std::min<std::uint64_t>(BLOCK_SIZE, numVertices - blockStart));
+        std::uint32_t numGroups = (blockCount + GROUP_SIZE - 1) / GROUP_SIZE;
+        std::uint32_t numHeaderBytes = (numGroups + 3) / 4;
+        std::uint8_t* pBlock = pBytes + blockStart * vertexSizeInBytes;
+
+        // Scatters the encoded deltas of every plane into place first.
+        for (std::uint32_t k = 0; k < vertexSizeInBytes; k += 4) {
+            std::uint32_t numPlanes = std::min(4u, vertexSizeInBytes - k);
+
+            for (std::uint32_t j = 0; j < numPlanes; ++j) {
+                if (static_cast<std::uint64_t>(pEnd - pData) < numHeaderBytes)
+                    throw std::runtime_error("Malformed vertex buffer.");
+                pHeaders[j] = pData;
+                pData += numHeaderBytes;
+
+                std::uint64_t payloadSizeInBytes = 0;
+                for (std::uint32_t g = 0; g < numGroups; ++g) {
+                    payloadSizeInBytes += GROUP_BITS[(pHeaders[j][g / 4] >> ((g % 4) * 2)) & 0x3] * GROUP_SIZE / 8;
+                }
+                if (static_cast<std::uint64_t>(pEnd - pData) < payloadSizeInBytes)
+                    throw std::runtime_error("Malformed vertex buffer.");
+                pPayloads[j] = pData;
+                pData += payloadSizeInBytes;
+            }
+
+            for (std::uint32_t g = 0; g < numGroups; ++g) {
+                for (std::uint32_t j = 0; j < numPlanes; ++j) {
+                    std::uint32_t bits = GROUP_BITS[(pHeaders[j][g / 4] >> ((g % 4) * 2)) & 0x3];
+                    UnpackGroup(pPayloads[j], bits, groups[j]);
+                    pPayloads[j] += bits * GROUP_SIZE / 8;
+                }
+
+                std::uint32_t groupCount = std::min(GROUP_SIZE, blockCount - g * GROUP_SIZE);
+                std::uint8_t* pDestination = pBlock + g * GROUP_SIZE * vertexSizeInBytes + k;
+                if (numPlanes == 4) {
+                    for (std::uint32_t i = 0; i < groupCount; ++i) {
+                        std::uint32_t word = groups[0][i] | (groups[1][i] << 8) | (groups[2][i] << 16) | (static_cast<std::uint32_t>(groups[3][i]) << 24);
+                        memcpy(pDestination + i * vertexSizeInBytes, &word, sizeof(std::uint32_t));
+                    }
+                } else {
+                    for (std::uint32_t j = 0; j < numPlanes; ++j) {
+                        for (std::uint32_t i = 0; i < groupCount; ++i) {
+                            pDestination[i * vertexSizeInBytes + j] = groups[j][i];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Then resolves the deltas one vertex at a time, every byte of a vertex is independent of the others.
+        for (std::uint32_t i = 0; i < blockCount; ++i) {
+            ResolveDeltas(pBlock + i * vertexSizeInBytes, previous.data(), vertexSizeInBytes);
+        }
+    }
+
+    if (pData != pEnd)
+        throw std::runtime_error("Malformed vertex buffer.");
+}
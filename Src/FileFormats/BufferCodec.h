@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../Util/pch.h"
+
+// Lossless codecs for the index and vertex buffers stored in an .roxmodl.
+//
+// Indices are stored as the zigzag encoded difference with the previous index, written as a LEB128 varint.
+// Neighbouring triangles share vertices, so most deltas fit in a single byte.
+//
+// Vertices are split into blocks of BLOCK_SIZE vertices. Every byte of the vertex is handled as a separate plane,
+// which holds the zigzag encoded difference of that byte with the same byte of the previous vertex.
+// Each plane is split into groups of 16 bytes that are bit packed with the smallest width that fits the group,
+// the widths are stored as 2 bit codes in front of the groups of a plane.
+//  0 = all zero, 1 = 2 bits, 2 = 4 bits, 3 = 8 bits
+namespace BufferCodec {
+    static constexpr std::uint32_t BLOCK_SIZE = 256;
+    static constexpr std::uint32_t GROUP_SIZE = 16;
+
+    // Supports 2 and 4 byte indices.
+    std::vector<std::uint8_t> EncodeIndices(const void* pIndices, std::uint64_t numIndices, std::uint32_t indexSizeInBytes);
+    // Throws if **pData** does not hold exactly **numIndices** indices.
+    void DecodeIndices(void* pIndices, std::uint64_t numIndices, std::uint32_t indexSizeInBytes, const std::uint8_t* pData, std::uint64_t sizeInBytes);
+
+    std::vector<std::uint8_t> EncodeVertices(const void* pVertices, std::uint64_t numVertices, std::uint32_t vertexSizeInBytes);
+    // Throws if **pData** does not hold exactly **numVertices** vertices.
+    void DecodeVertices(void* pVertices, std::uint64_t numVertices, std::uint32_t vertexSizeInBytes, const std::uint8_t* pData, std::uint64_t sizeInBytes);
+}
@@ -10,6 +10,13 @@
 //      ROXANIM::BONE_ANIM_HEADER[ROXANIM::ANIM_HEADER.NumBoneAnimations] boneAnimation 
 //          Keyframe[ROXANIM::BONE_ANIM_HEADER.NumKeyframes] keyframes
 //
+// Compressed animations start with ROXANIM::COMPRESSED_MAGIC instead.
+//
+//  ROXANIM::COMPRESSED_HEADER
+//      char[ROXANIM::COMPRESSED_HEADER.NameSizeInBytes] animationName
+//      CompressedTrack[ROXANIM::COMPRESSED_HEADER.NumTracks] tracks
+//      std::uint16_t[ROXANIM::COMPRESSED_HEADER.NumValues] data
+//
 
 namespace ROXANIM {
 #pragma pack(push, animHeader, 1)
@@ -29,4 +36,22 @@ namespace ROXANIM {
 #pragma pack(pop, boneAnimHeader)
 
     static_assert(sizeof(BONE_ANIM_HEADER) == 12, "ROXANIM::BONE_ANIM_HEADER size mismatch");
+
+    // "RXAC" when read as bytes.
+    static constexpr std::uint32_t COMPRESSED_MAGIC = 0x43415852;
+
+#pragma pack(push, compressedHeader, 4)
+    struct COMPRESSED_HEADER {
+        std::uint32_t Magic;
+        std::uint32_t NameSizeInBytes;
+
+        float StartTime;
+        float EndTime;
+
+        std::uint32_t NumTracks;
+        std::uint32_t NumValues;
+    };
+#pragma pack(pop, compressedHeader)
+
+    static_assert(sizeof(COMPRESSED_HEADER) == 24, "ROXANIM::COMPRESSED_HEADER size mismatch");
 }
@@ -3,6 +3,8 @@
 #include "../Util/pch.h"
 
 // Describes how an .roxmodl is constructed.
+//
+// Version 1 of the format.
 // All arrays are stored in order.
 //
 //  ROXMODL::HEADER
@@ -91,3 +93,174 @@ namespace ROXMODL {
     static_assert(sizeof(VERTEX_BUFFER_HEADER) == 12, "ROXMODL::VERTEX_BUFFER_HEADER size mismatch");
 }
 
+
+// Version 2 of the format.
+// Starts with a table of contents so a reader can seek straight to the data it needs instead of
+// walking every name in the file. Every chunk and every index and vertex buffer starts on a 16 byte boundary.
+// All structures use their natural alignment, offsets are relative to the start of the file.
+//
+//  ROXMODL::V2::HEADER
+//  ROXMODL::V2::CHUNK[ROXMODL::V2::HEADER.NumChunks]
+//  Chunks in the order they are written:
+//      CHUNK_TYPE::Strings                     char[] names, referenced through ROXMODL::V2::STRING
+//      CHUNK_TYPE::Bones                       ROXMODL::V2::BONE[ROXMODL::V2::HEADER.NumBones]
+//      CHUNK_TYPE::BoneMatrices                DirectX::XMFLOAT4X4[ROXMODL::V2::HEADER.NumBones]
+//      CHUNK_TYPE::InverseBindPoseMatrices     DirectX::XMFLOAT4X4[ROXMODL::V2::HEADER.NumBones]
+//      CHUNK_TYPE::Meshes                      ROXMODL::V2::MESH[ROXMODL::V2::HEADER.NumMeshes]
+//      CHUNK_TYPE::Submeshes                   ROXMODL::V2::SUBMESH[ROXMODL::V2::HEADER.NumSubmeshes]
+//      CHUNK_TYPE::SubmeshBounds               ROXMODL::V2::SUBMESH_BOUNDS[ROXMODL::V2::HEADER.NumSubmeshes], optional
+//      CHUNK_TYPE::BoneInfluences              std::uint32_t[] bone influences of every mesh
+//      CHUNK_TYPE::Indices                     index buffers of every mesh
+//      CHUNK_TYPE::Vertices                    vertex buffers of every mesh
+//      CHUNK_TYPE::VertexQuantization          ROXMODL::V2::VERTEX_QUANTIZATION[ROXMODL::V2::HEADER.NumMeshes], optional
+//
+// When the CHUNK_TYPE::VertexQuantization chunk is present the vertex buffers hold compact vertices,
+// VertexPositionNormalTextureCompact or VertexPositionNormalTextureSkinningCompact, decoded with the record of their mesh.
+// Files written before the CHUNK_TYPE::SubmeshBounds chunk existed leave the reader to compute the bounds from the vertices.
+
+namespace ROXMODL::V2 {
+    static constexpr std::uint16_t VERSION = 2;
+    static constexpr std::uint64_t ALIGNMENT = 16;
+
+    enum class CHUNK_TYPE : std::uint32_t {
+        Strings,
+        Bones,
+        BoneMatrices,
+        InverseBindPoseMatrices,
+        Meshes,
+        Submeshes,
+        BoneInfluences,
+        Indices,
+        Vertices,
+        VertexQuantization,
+        SubmeshBounds
+    };
+
+    struct HEADER {
+        // Shares its offset with ROXMODL::HEADER::Version so both versions can be told apart.
+        std::uint16_t Version;
+        std::uint16_t NumChunks;
+
+        std::uint32_t NameOffset;
+        std::uint32_t NameSizeInBytes;
+
+        std::uint32_t NumBones;
+        std::uint32_t NumMeshes;
+        std::uint32_t NumSubmeshes;
+        std::uint32_t NumMaterials;
+
+        std::uint32_t Reserved;
+    };
+
+    static_assert(sizeof(HEADER) == 32, "ROXMODL::V2::HEADER size mismatch");
+
+    struct CHUNK {
+        CHUNK_TYPE Type;
+        std::uint32_t Reserved;
+
+        std::uint64_t OffsetInBytes;
+        std::uint64_t SizeInBytes;
+    };
+
+    static_assert(sizeof(CHUNK) == 24, "ROXMODL::V2::CHUNK size mismatch");
+
+    // Location of a name in the CHUNK_TYPE::Strings chunk, relative to the start of that chunk.
+    struct STRING {
+        std::uint32_t OffsetInBytes;
+        std::uint32_t SizeInBytes;
+    };
+
+    static_assert(sizeof(STRING) == 8, "ROXMODL::V2::STRING size mismatch");
+
+    struct BONE {
+        STRING Name;
+        std::uint32_t ParentIndex;
+        std::uint32_t Reserved;
+    };
+
+    static_assert(sizeof(BONE) == 16, "ROXMODL::V2::BONE size mismatch");
+
+    // How the contents of an index or vertex buffer are stored, see BufferCodec.h.
+    enum class BUFFER_ENCODING : std::uint32_t {
+        Raw,
+        // Indices only.
+        DeltaVarint,
+        // Vertices only.
+        BytePlane
+    };
+
+    // SizeInBytes is the size of the buffer as stored in the file, which is smaller than
+    // IndexSizeInBytes * NumIndices when the buffer is encoded.
+    // IndexSizeInBytes is 2 or 4, matching the index format used on the GPU.
+    struct INDEX_BUFFER_HEADER {
+        std::uint64_t OffsetInBytes;
+        std::uint64_t SizeInBytes;
+        std::uint64_t NumIndices;
+
+        std::uint32_t IndexSizeInBytes;
+        BUFFER_ENCODING Encoding;
+    };
+
+    static_assert(sizeof(INDEX_BUFFER_HEADER) == 32, "ROXMODL::V2::INDEX_BUFFER_HEADER size mismatch");
+
+    // SizeInBytes is the size of the buffer as stored in the file, which is smaller than
+    // VertexSizeInBytes * NumVertices when the buffer is encoded.
+    struct VERTEX_BUFFER_HEADER {
+        std::uint64_t OffsetInBytes;
+        std::uint64_t SizeInBytes;
+        std::uint64_t NumVertices;
+
+        std::uint32_t VertexSizeInBytes;
+        BUFFER_ENCODING Encoding;
+    };
+
+    static_assert(sizeof(VERTEX_BUFFER_HEADER) == 32, "ROXMODL::V2::VERTEX_BUFFER_HEADER size mismatch");
+
+    struct MESH {
+        STRING Name;
+        std::uint32_t IsSkinned;
+        std::uint32_t BoneIndex;
+
+        // Index into the CHUNK_TYPE::Submeshes chunk.
+        std::uint32_t FirstSubmesh;
+        std::uint32_t NumSubmeshes;
+
+        // Index into the CHUNK_TYPE::BoneInfluences chunk.
+        std::uint32_t FirstBoneInfluence;
+        std::uint32_t NumBoneInfluences;
+
+        INDEX_BUFFER_HEADER IndexBuffer;
+        VERTEX_BUFFER_HEADER VertexBuffer;
+    };
+
+    static_assert(sizeof(MESH) == 96, "ROXMODL::V2::MESH size mismatch");
+
+    struct SUBMESH {
+        STRING Name;
+        std::uint32_t MaterialIndex;
+        std::uint32_t IndexCount;
+        std::uint32_t StartIndex;
+        std::uint32_t VertexOffset;
+    };
+
+    static_assert(sizeof(SUBMESH) == 24, "ROXMODL::V2::SUBMESH size mismatch");
+
+    // Bounds of the vertices drawn by the submesh with the same index, in the space of its mesh.
+    struct SUBMESH_BOUNDS {
+        DirectX::XMFLOAT3 BoxCenter;
+        DirectX::XMFLOAT3 BoxExtents;
+
+        DirectX::XMFLOAT3 SphereCenter;
+        float SphereRadius;
+    };
+
+    static_assert(sizeof(SUBMESH_BOUNDS) == 40, "ROXMODL::V2::SUBMESH_BOUNDS size mismatch");
+
+    // Maps the positions of the compact vertices of a mesh back to the space of the mesh, see VertexQuantization.
+    struct VERTEX_QUANTIZATION {
+        DirectX::XMFLOAT3 Offset;
+        DirectX::XMFLOAT3 Scale;
+    };
+
+    static_assert(sizeof(VERTEX_QUANTIZATION) == 24, "ROXMODL::V2::VERTEX_QUANTIZATION size mismatch");
+}
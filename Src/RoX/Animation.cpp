@@ -1,5 +1,7 @@
 #include "RoX/Animation.h"
 
+#include <algorithm>
+
 // ---------------------------------------------------------------- //
 //                          Keyframe
 // ---------------------------------------------------------------- //
@@ -23,47 +25,152 @@ bool Keyframe::operator> (const Keyframe& other) const noexcept {
 //                          BoneAnimation
 // ---------------------------------------------------------------- //
 
-void BoneAnimation::Interpolate(float timePosition, DirectX::XMMATRIX& M) const {
-    DirectX::XMVECTOR zero = DirectX::XMVectorSet(0.f, 0.f, 0.f, 1.f);
+// Number of keyframes a cursor steps over before it falls back to a binary search.
+static constexpr std::uint32_t MAX_CURSOR_STEPS = 4;
+
+// Last keyframe in [first, last) at or before **timePosition**.
+// The keyframe at **first** must be at or before **timePosition**.
+template<typename GetTime>
+std::uint32_t SearchKeyframe(std::uint32_t first, std::uint32_t last, float timePosition, const GetTime& getTime) {
+    while (last - first > 1) {
+        std::uint32_t middle = first + (last - first) / 2;
+        if (getTime(middle) <= timePosition)
+            first = middle;
+        else
+            last = middle;
+    }
+    return first;
+}
+
+// Steps **cursor** forward to the last keyframe at or before **timePosition**, searching the rest when it is too far ahead.
+// The keyframe at **cursor** must be at or before **timePosition**.
+template<typename GetTime>
+std::uint32_t AdvanceCursor(std::uint32_t cursor, std::uint32_t numKeyframes, float timePosition, const GetTime& getTime) {
+    for (std::uint32_t step = 0; cursor < numKeyframes - 2 && getTime(cursor + 1) <= timePosition; ++step) {
+        if (step == MAX_CURSOR_STEPS)
+            return SearchKeyframe(cursor, numKeyframes - 1, timePosition, getTime);
+        ++cursor;
+    }
+    return cursor;
+}
+
+// Translation, scale and rotation between the keyframe at **index** and the next one.
+// Times outside of that pair are clamped to it.
+void SampleKeyframes(
+        const std::vector<Keyframe>& keyframes,
+        std::uint32_t index,
+        float timePosition,
+        DirectX::XMVECTOR& T,
+        DirectX::XMVECTOR& S,
+        DirectX::XMVECTOR& R)
+{
+    if (keyframes.empty()) {
+        T = DirectX::XMVectorZero();
+        S = DirectX::XMVectorSet(1.f, 1.f, 1.f, 0.f);
+        R = DirectX::XMQuaternionIdentity();
+        return;
+    }
+
+    const Keyframe& currentFrame = keyframes[index];
+    const Keyframe& nextFrame = keyframes[std::min<std::uint32_t>(index + 1, keyframes.size() - 1)];
+
+    if (keyframes.size() == 1 || timePosition <= currentFrame.TimePosition) {
+        T = DirectX::XMLoadFloat3(&currentFrame.Translation);
+        S = DirectX::XMLoadFloat3(&currentFrame.Scale);
+        R = DirectX::XMLoadFloat4(&currentFrame.RotationQuaternion);
+        return;
+    }
+    if (timePosition >= nextFrame.TimePosition) {
+        T = DirectX::XMLoadFloat3(&nextFrame.Translation);
+        S = DirectX::XMLoadFloat3(&nextFrame.Scale);
+        R = DirectX::XMLoadFloat4(&nextFrame.RotationQuaternion);
+        return;
+    }
 
-    if (timePosition <= GetStartTime()) {
-        DirectX::XMVECTOR S = DirectX::XMLoadFloat3(&Keyframes.front().Scale);
-        DirectX::XMVECTOR T = DirectX::XMLoadFloat3(&Keyframes.front().Translation);
-        DirectX::XMVECTOR R = DirectX::XMLoadFloat4(&Keyframes.front().RotationQuaternion);
+    float lerpPercent = (timePosition - currentFrame.TimePosition) / (nextFrame.TimePosition - currentFrame.TimePosition);
 
-        M = DirectX::XMMatrixAffineTransformation(S, zero, R, T);
-    } else if (timePosition >= GetEndTime()) {
-        DirectX::XMVECTOR S = DirectX::XMLoadFloat3(&Keyframes.back().Scale);
-        DirectX::XMVECTOR T = DirectX::XMLoadFloat3(&Keyframes.back().Translation);
-        DirectX::XMVECTOR R = DirectX::XMLoadFloat4(&Keyframes.back().RotationQuaternion);
+    DirectX::XMVECTOR s0 = DirectX::XMLoadFloat3(&currentFrame.Scale);
+    DirectX::XMVECTOR s1 = DirectX::XMLoadFloat3(&nextFrame.Scale);
 
-        M = DirectX::XMMatrixAffineTransformation(S, zero, R, T);
-    } else {
-        for(std::uint32_t i = 0; i < Keyframes.size() - 1; ++i) {
-            const Keyframe& currentFrame = Keyframes[i];
-            const Keyframe& nextFrame = Keyframes[i + 1];
+    DirectX::XMVECTOR p0 = DirectX::XMLoadFloat3(&currentFrame.Translation);
+    DirectX::XMVECTOR p1 = DirectX::XMLoadFloat3(&nextFrame.Translation);
 
-            if (timePosition >= currentFrame.TimePosition && timePosition <= nextFrame.TimePosition) {
-                float lerpPercent = (timePosition - currentFrame.TimePosition) / (nextFrame.TimePosition - currentFrame.TimePosition);
+    DirectX::XMVECTOR q0 = DirectX::XMLoadFloat4(&currentFrame.RotationQuaternion);
+    DirectX::XMVECTOR q1 = DirectX::XMLoadFloat4(&nextFrame.RotationQuaternion);
 
-                DirectX::XMVECTOR s0 = DirectX::XMLoadFloat3(&currentFrame.Scale);
-                DirectX::XMVECTOR s1 = DirectX::XMLoadFloat3(&nextFrame.Scale);
+    S = DirectX::XMVectorLerp(s0, s1, lerpPercent);
+    T = DirectX::XMVectorLerp(p0, p1, lerpPercent);
+    R = DirectX::XMQuaternionSlerp(q0, q1, lerpPercent);
+}
 
-                DirectX::XMVECTOR p0 = DirectX::XMLoadFloat3(&currentFrame.Translation);
-                DirectX::XMVECTOR p1 = DirectX::XMLoadFloat3(&nextFrame.Translation);
+void InterpolateKeyframes(const std::vector<Keyframe>& keyframes, std::uint32_t index, float timePosition, DirectX::XMMATRIX& M) {
+    DirectX::XMVECTOR zero = DirectX::XMVectorSet(0.f, 0.f, 0.f, 1.f);
+    DirectX::XMVECTOR T, S, R;
+    SampleKeyframes(keyframes, index, timePosition, T, S, R);
 
-                DirectX::XMVECTOR q0 = DirectX::XMLoadFloat4(&currentFrame.RotationQuaternion);
-                DirectX::XMVECTOR q1 = DirectX::XMLoadFloat4(&nextFrame.RotationQuaternion);
+    M = DirectX::XMMatrixAffineTransformation(S, zero, R, T);
+}
 
-                DirectX::XMVECTOR S =  DirectX::XMVectorLerp(s0, s1, lerpPercent);
-                DirectX::XMVECTOR T =  DirectX::XMVectorLerp(p0, p1, lerpPercent);
-                DirectX::XMVECTOR R =  DirectX::XMQuaternionSlerp(q0, q1, lerpPercent);
+void BoneAnimation::Interpolate(float timePosition, DirectX::XMMATRIX& M, KeyframeSearch search) const {
+    InterpolateKeyframes(Keyframes, FindKeyframe(timePosition, search), timePosition, M);
+}
 
-                M = DirectX::XMMatrixAffineTransformation(S, zero, R, T);
+void BoneAnimation::Interpolate(float timePosition, DirectX::XMMATRIX& M, std::uint32_t& cursor) const {
+    InterpolateKeyframes(Keyframes, FindKeyframe(timePosition, cursor), timePosition, M);
+}
 
-                break;
-            }
+void BoneAnimation::Sample(float timePosition, DirectX::XMVECTOR& T, DirectX::XMVECTOR& S, DirectX::XMVECTOR& R, KeyframeSearch search) const {
+    SampleKeyframes(Keyframes, FindKeyframe(timePosition, search), timePosition, T, S, R);
+}
+
+void BoneAnimation::Sample(float timePosition, DirectX::XMVECTOR& T, DirectX::XMVECTOR& S, DirectX::XMVECTOR& R, std::uint32_t& cursor) const {
+    SampleKeyframes(Keyframes, FindKeyframe(timePosition, cursor), timePosition, T, S, R);
+}
+
+std::uint32_t BoneAnimation::FindKeyframe(float timePosition, KeyframeSearch search) const {
+    std::uint32_t numKeyframes = Keyframes.size();
+    if (numKeyframes < 2)
+        return 0;
+
+    if (search == KeyframeSearch::Linear) {
+        for (std::uint32_t i = 0; i < numKeyframes - 2; ++i) {
+            if (timePosition < Keyframes[i + 1].TimePosition)
+                return i;
         }
+        return numKeyframes - 2;
+    }
+
+    if (timePosition <= Keyframes.front().TimePosition)
+        return 0;
+    if (TimePositions.size() == numKeyframes)
+        return SearchKeyframe(0, numKeyframes - 1, timePosition, [this](std::uint32_t i) { return TimePositions[i]; });
+    return SearchKeyframe(0, numKeyframes - 1, timePosition, [this](std::uint32_t i) { return Keyframes[i].TimePosition; });
+}
+
+std::uint32_t BoneAnimation::FindKeyframe(float timePosition, std::uint32_t& cursor) const {
+    std::uint32_t numKeyframes = Keyframes.size();
+    if (numKeyframes < 2) {
+        cursor = 0;
+        return 0;
+    }
+
+    // Playback moved backwards or looped.
+    if (cursor > numKeyframes - 2 || timePosition < Keyframes[cursor].TimePosition) {
+        cursor = FindKeyframe(timePosition, KeyframeSearch::Binary);
+        return cursor;
+    }
+
+    if (TimePositions.size() == numKeyframes)
+        cursor = AdvanceCursor(cursor, numKeyframes, timePosition, [this](std::uint32_t i) { return TimePositions[i]; });
+    else
+        cursor = AdvanceCursor(cursor, numKeyframes, timePosition, [this](std::uint32_t i) { return Keyframes[i].TimePosition; });
+    return cursor;
+}
+
+void BoneAnimation::UpdateTimePositions() {
+    TimePositions.resize(Keyframes.size());
+    for (std::uint32_t i = 0; i < Keyframes.size(); ++i) {
+        TimePositions[i] = Keyframes[i].TimePosition;
     }
 }
 
@@ -79,6 +186,84 @@ std::uint32_t BoneAnimation::GetNumKeyframes() const noexcept {
     return Keyframes.size();
 }
 
+// ---------------------------------------------------------------- //
+//                          LocalPose
+// ---------------------------------------------------------------- //
+
+void LocalPose::Resize(std::uint32_t numBones) {
+    Translations.resize(numBones);
+    Scales.resize(numBones);
+    RotationQuaternions.resize(numBones);
+}
+
+void LocalPose::ToMatrices(Bone::TransformArray& toParentTransforms) const {
+    for (std::uint32_t i = 0; i < Translations.size(); ++i) {
+        toParentTransforms[i] = ToMatrix(i);
+    }
+}
+
+DirectX::XMMATRIX LocalPose::ToMatrix(std::uint32_t boneIndex) const {
+    DirectX::XMVECTOR zero = DirectX::XMVectorSet(0.f, 0.f, 0.f, 1.f);
+    DirectX::XMVECTOR S = DirectX::XMLoadFloat4A(&Scales[boneIndex]);
+    DirectX::XMVECTOR T = DirectX::XMLoadFloat4A(&Translations[boneIndex]);
+    DirectX::XMVECTOR R = DirectX::XMLoadFloat4A(&RotationQuaternions[boneIndex]);
+
+    return DirectX::XMMatrixAffineTransformation(S, zero, R, T);
+}
+
+std::uint32_t LocalPose::GetNumBones() const noexcept {
+    return Translations.size();
+}
+
+// ---------------------------------------------------------------- //
+//                          IAnimationSampler
+// ---------------------------------------------------------------- //
+
+void IAnimationSampler::SampleBones(float timePosition, LocalPose& pose, const std::uint16_t* pBoneIndices, std::uint32_t numBones) const {
+    Sample(timePosition, pose);
+}
+
+// ---------------------------------------------------------------- //
+//                          PlaybackCursor
+// ---------------------------------------------------------------- //
+
+void PlaybackCursor::Reset() noexcept {
+    std::fill(KeyframeIndices.begin(), KeyframeIndices.end(), 0);
+}
+
+// ---------------------------------------------------------------- //
+//                          PoseBuffer
+// ---------------------------------------------------------------- //
+
+PoseBuffer::PoseBuffer(std::uint32_t numBones) 
+    : m_capacity(0)
+{
+    Reserve(numBones);
+}
+
+void PoseBuffer::Reserve(std::uint32_t numBones) {
+    if (numBones <= m_capacity && m_toParentTransforms)
+        return;
+
+    m_toParentTransforms = Bone::MakeArray(numBones);
+    m_capacity = numBones;
+}
+
+void PoseBuffer::ComposeBoneMatrices(Model& model) {
+    for (std::uint32_t i = 0; i < model.GetNumBones(); ++i) {
+        model.SetLocalTransform(i, m_toParentTransforms[i]);
+    }
+    model.UpdateBoneMatrices();
+}
+
+Bone::TransformArray& PoseBuffer::GetToParentTransforms() noexcept {
+    return m_toParentTransforms;
+}
+
+std::uint32_t PoseBuffer::GetCapacity() const noexcept {
+    return m_capacity;
+}
+
 // ---------------------------------------------------------------- //
 //                          Animation
 // ---------------------------------------------------------------- //
@@ -89,41 +274,118 @@ Animation::Animation(std::string name)
 
 }
 
-void Animation::Interpolate(float timePosition, Bone::TransformArray& boneTransforms) const {
+void Animation::Interpolate(float timePosition, Bone::TransformArray& boneTransforms, KeyframeSearch search) const {
+    for (std::uint32_t i = 0; i < m_boneAnimations.size(); ++i) {
+        m_boneAnimations[i].Interpolate(timePosition, boneTransforms[i], search);
+    }
+}
+
+void Animation::Interpolate(float timePosition, Bone::TransformArray& boneTransforms, PlaybackCursor& cursor) const {
+    if (cursor.KeyframeIndices.size() != m_boneAnimations.size())
+        cursor.KeyframeIndices.assign(m_boneAnimations.size(), 0);
+
     for (std::uint32_t i = 0; i < m_boneAnimations.size(); ++i) {
-        m_boneAnimations[i].Interpolate(timePosition, boneTransforms[i]);
+        m_boneAnimations[i].Interpolate(timePosition, boneTransforms[i], cursor.KeyframeIndices[i]);
     }
 }
 
-void Animation::Apply(float timePosition, Model& model) const {
-    Bone::TransformArray toParentTransforms = Bone::MakeArray(model.GetNumBones());
-    Interpolate(timePosition, toParentTransforms);
+void Animation::Sample(float timePosition, LocalPose& pose) const {
+    if (pose.GetNumBones() != m_boneAnimations.size())
+        pose.Resize(m_boneAnimations.size());
 
-    Bone::TransformArray toRootTransforms = Bone::MakeArray(model.GetNumBones());
-    toRootTransforms[0] = toParentTransforms[0];
+    for (std::uint32_t i = 0; i < m_boneAnimations.size(); ++i) {
+        DirectX::XMVECTOR T, S, R;
+        m_boneAnimations[i].Sample(timePosition, T, S, R);
+        DirectX::XMStoreFloat4A(&pose.Translations[i], T);
+        DirectX::XMStoreFloat4A(&pose.Scales[i], S);
+        DirectX::XMStoreFloat4A(&pose.RotationQuaternions[i], R);
+    }
+}
 
-    for (std::uint32_t i = 1; i < model.GetNumBones(); ++i) {
-        DirectX::XMMATRIX toParent = toParentTransforms[i];
-        DirectX::XMMATRIX parentToRoot = toRootTransforms[model.GetBones()[i].GetParentIndex()];
-        DirectX::XMMATRIX toRoot = toParent * parentToRoot;
-        toRootTransforms[i] = toRoot;
+void Animation::Sample(float timePosition, LocalPose& pose, PlaybackCursor& cursor) const {
+    if (cursor.KeyframeIndices.size() != m_boneAnimations.size())
+        cursor.KeyframeIndices.assign(m_boneAnimations.size(), 0);
+    if (pose.GetNumBones() != m_boneAnimations.size())
+        pose.Resize(m_boneAnimations.size());
+
+    for (std::uint32_t i = 0; i < m_boneAnimations.size(); ++i) {
+        DirectX::XMVECTOR T, S, R;
+        m_boneAnimations[i].Sample(timePosition, T, S, R, cursor.KeyframeIndices[i]);
+        DirectX::XMStoreFloat4A(&pose.Translations[i], T);
+        DirectX::XMStoreFloat4A(&pose.Scales[i], S);
+        DirectX::XMStoreFloat4A(&pose.RotationQuaternions[i], R);
     }
+}
 
-    for (std::uint32_t i = 0; i < model.GetNumBones(); ++i) {
-        DirectX::XMMATRIX offset = model.GetInverseBindPoseMatrices()[i];
-        DirectX::XMMATRIX toRoot = toRootTransforms[i];
-        DirectX::XMMATRIX final = offset * toRoot;
+void Animation::SampleBones(float timePosition, LocalPose& pose, const std::uint16_t* pBoneIndices, std::uint32_t numBones) const {
+    if (pose.GetNumBones() != m_boneAnimations.size())
+        pose.Resize(m_boneAnimations.size());
+
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        std::uint32_t boneIndex = pBoneIndices[i];
+        if (boneIndex >= m_boneAnimations.size())
+            continue;
 
-        model.GetBoneMatrices()[i] = final;
+        DirectX::XMVECTOR T, S, R;
+        m_boneAnimations[boneIndex].Sample(timePosition, T, S, R);
+        DirectX::XMStoreFloat4A(&pose.Translations[boneIndex], T);
+        DirectX::XMStoreFloat4A(&pose.Scales[boneIndex], S);
+        DirectX::XMStoreFloat4A(&pose.RotationQuaternions[boneIndex], R);
+    }
+}
+
+void Animation::Apply(float timePosition, Model& model, KeyframeSearch search) const {
+    PoseBuffer poseBuffer(model.GetNumBones());
+    Apply(timePosition, model, poseBuffer, search);
+}
+
+void Animation::Apply(float timePosition, Model& model, PlaybackCursor& cursor) const {
+    PoseBuffer poseBuffer(model.GetNumBones());
+    Apply(timePosition, model, poseBuffer, cursor);
+}
+
+void Animation::Apply(float timePosition, Model& model, PoseBuffer& poseBuffer, KeyframeSearch search) const {
+    poseBuffer.Reserve(std::max(model.GetNumBones(), GetNumBoneAnimations()));
+    Interpolate(timePosition, poseBuffer.GetToParentTransforms(), search);
+    poseBuffer.ComposeBoneMatrices(model);
+}
+
+void Animation::Apply(float timePosition, Model& model, PoseBuffer& poseBuffer, PlaybackCursor& cursor) const {
+    poseBuffer.Reserve(std::max(model.GetNumBones(), GetNumBoneAnimations()));
+    Interpolate(timePosition, poseBuffer.GetToParentTransforms(), cursor);
+    poseBuffer.ComposeBoneMatrices(model);
+}
+
+void Animation::UpdateTimePositions() {
+    for (BoneAnimation& boneAnimation : m_boneAnimations) {
+        boneAnimation.UpdateTimePositions();
     }
 }
 
 float Animation::GetStartTime() const {
-    return m_boneAnimations.front().GetStartTime();
+    bool hasKeyframes = false;
+    float startTime = 0.f;
+    for (const BoneAnimation& boneAnimation : m_boneAnimations) {
+        if (boneAnimation.Keyframes.empty())
+            continue;
+
+        startTime = hasKeyframes ? std::min(startTime, boneAnimation.GetStartTime()) : boneAnimation.GetStartTime();
+        hasKeyframes = true;
+    }
+    return startTime;
 }
 
 float Animation::GetEndTime() const {
-    return m_boneAnimations.back().GetEndTime();
+    bool hasKeyframes = false;
+    float endTime = 0.f;
+    for (const BoneAnimation& boneAnimation : m_boneAnimations) {
+        if (boneAnimation.Keyframes.empty())
+            continue;
+
+        endTime = hasKeyframes ? std::max(endTime, boneAnimation.GetEndTime()) : boneAnimation.GetEndTime();
+        hasKeyframes = true;
+    }
+    return endTime;
 }
 
 std::uint32_t Animation::GetNumBoneAnimations() const noexcept {
@@ -0,0 +1,139 @@
+#include "RoX/AnimationMixer.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Resets the bones in [first, last) to the identity transform.
+void SetIdentity(LocalPose& pose, std::uint32_t first, std::uint32_t last) {
+    for (std::uint32_t i = first; i < last; ++i) {
+        DirectX::XMStoreFloat4A(&pose.Translations[i], DirectX::XMVectorZero());
+        DirectX::XMStoreFloat4A(&pose.Scales[i], DirectX::XMVectorSet(1.f, 1.f, 1.f, 0.f));
+        DirectX::XMStoreFloat4A(&pose.RotationQuaternions[i], DirectX::XMQuaternionIdentity());
+    }
+}
+
+std::uint32_t AnimationMixer::AddLayer(std::shared_ptr<IAnimationSampler> pSampler, float weight, std::vector<float> boneMask) {
+    if (!pSampler)
+        throw std::invalid_argument("Layer needs a sampler.");
+
+    AnimationLayer layer;
+    layer.pSampler = std::move(pSampler);
+    layer.Weight = weight;
+    layer.BoneMask = std::move(boneMask);
+    m_layers.push_back(std::move(layer));
+
+    return m_layers.size() - 1;
+}
+
+void AnimationMixer::RemoveLayer(std::uint32_t index) {
+    if (index >= m_layers.size())
+        throw std::out_of_range("Layer index " + std::to_string(index) + " is out of range.");
+
+    m_layers.erase(m_layers.begin() + index);
+}
+
+void AnimationMixer::ClearLayers() noexcept {
+    m_layers.clear();
+}
+
+void AnimationMixer::Advance(float deltaTime) noexcept {
+    for (AnimationLayer& layer : m_layers) {
+        layer.TimePosition += deltaTime;
+    }
+}
+
+void AnimationMixer::Blend(std::uint32_t numBones, LocalPose& pose) {
+    // Layers below one that replaces every bone do not need to be sampled.
+    std::uint32_t firstLayer = 0;
+    for (std::uint32_t i = 0; i < m_layers.size(); ++i) {
+        if (m_layers[i].Weight >= 1.f && m_layers[i].BoneMask.empty())
+            firstLayer = i;
+    }
+
+    bool hasBase = false;
+    for (std::uint32_t l = firstLayer; l < m_layers.size(); ++l) {
+        const AnimationLayer& layer = m_layers[l];
+        if (layer.Weight <= 0.f)
+            continue;
+
+        if (!hasBase) {
+            // The bottom layer is sampled straight into the result.
+            layer.pSampler->Sample(layer.TimePosition, pose);
+            std::uint32_t numSampled = std::min(pose.GetNumBones(), numBones);
+            pose.Resize(numBones);
+            SetIdentity(pose, numSampled, numBones);
+            hasBase = true;
+            continue;
+        }
+
+        layer.pSampler->Sample(layer.TimePosition, m_layerPose);
+
+        std::uint32_t numBlended = std::min(m_layerPose.GetNumBones(), numBones);
+        for (std::uint32_t i = 0; i < numBlended; ++i) {
+            float weight = layer.Weight * (i < layer.BoneMask.size() ? layer.BoneMask[i] : 1.f);
+            if (weight <= 0.f)
+                continue;
+
+            DirectX::XMVECTOR W = DirectX::XMVectorReplicate(std::min(weight, 1.f));
+
+            DirectX::XMVECTOR T0 = DirectX::XMLoadFloat4A(&pose.Translations[i]);
+            DirectX::XMVECTOR T1 = DirectX::XMLoadFloat4A(&m_layerPose.Translations[i]);
+            DirectX::XMStoreFloat4A(&pose.Translations[i], DirectX::XMVectorLerpV(T0, T1, W));
+
+            DirectX::XMVECTOR S0 = DirectX::XMLoadFloat4A(&pose.Scales[i]);
+            DirectX::XMVECTOR S1 = DirectX::XMLoadFloat4A(&m_layerPose.Scales[i]);
+            DirectX::XMStoreFloat4A(&pose.Scales[i], DirectX::XMVectorLerpV(S0, S1, W));
+
+            // Takes the shortest path by flipping **R1** into the hemisphere of **R0**.
+            DirectX::XMVECTOR R0 = DirectX::XMLoadFloat4A(&pose.RotationQuaternions[i]);
+            DirectX::XMVECTOR R1 = DirectX::XMLoadFloat4A(&m_layerPose.RotationQuaternions[i]);
+            DirectX::XMVECTOR isOpposite = DirectX::XMVectorLess(DirectX::XMVector4Dot(R0, R1), DirectX::XMVectorZero());
+            R1 = DirectX::XMVectorSelect(R1, DirectX::XMVectorNegate(R1), isOpposite);
+            DirectX::XMStoreFloat4A(&pose.RotationQuaternions[i], DirectX::XMVector4Normalize(DirectX::XMVectorLerpV(R0, R1, W)));
+        }
+    }
+
+    if (!hasBase) {
+        pose.Resize(numBones);
+        SetIdentity(pose, 0, numBones);
+    }
+}
+
+void AnimationMixer::Apply(Model& model, PoseBuffer& poseBuffer) {
+    Blend(model.GetNumBones(), m_pose);
+
+    poseBuffer.Reserve(model.GetNumBones());
+    m_pose.ToMatrices(poseBuffer.GetToParentTransforms());
+    poseBuffer.ComposeBoneMatrices(model);
+}
+
+std::vector<float> AnimationMixer::MakeBoneMask(Model& model, std::uint32_t rootIndex) {
+    if (rootIndex >= model.GetNumBones())
+        throw std::out_of_range("Bone index " + std::to_string(rootIndex) + " is out of range.");
+
+    const Skeleton& skeleton = model.GetSkeleton();
+    const std::vector<std::uint16_t>& order = skeleton.GetOrder();
+    const std::vector<std::uint16_t>& parentSlots = skeleton.GetParentSlots();
+
+    // Weight of every slot of the sweep, slot 0 is the parent of the roots.
+    std::vector<float> slotMask(skeleton.GetNumBones() + 1, 0.f);
+    std::vector<float> mask(model.GetNumBones(), 0.f);
+    for (std::uint32_t i = 0; i < skeleton.GetNumBones(); ++i) {
+        slotMask[i + 1] = order[i] == rootIndex ? 1.f : slotMask[parentSlots[i]];
+        mask[order[i]] = slotMask[i + 1];
+    }
+    return mask;
+}
+
+AnimationLayer& AnimationMixer::GetLayer(std::uint32_t index) {
+    return m_layers.at(index);
+}
+
+std::vector<AnimationLayer>& AnimationMixer::GetLayers() noexcept {
+    return m_layers;
+}
+
+std::uint32_t AnimationMixer::GetNumLayers() const noexcept {
+    return m_layers.size();
+}
@@ -0,0 +1,166 @@
+#include "RoX/AnimationSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "../Util/ThreadPool.h"
+
+// Position of the first instance of **model**, models are expected to move all their instances together.
+DirectX::XMVECTOR GetModelPosition(Model& model) {
+    for (std::shared_ptr<IMesh>& pIMesh : model.GetMeshes()) {
+        for (std::unique_ptr<Submesh>& pSubmesh : pIMesh->GetSubmeshes()) {
+            if (pSubmesh->GetInstances().empty())
+                continue;
+
+            const DirectX::XMFLOAT3X4& W = pSubmesh->GetInstances()[0];
+            return DirectX::XMVectorSet(W._14, W._24, W._34, 0.f);
+        }
+    }
+    return DirectX::XMVectorZero();
+}
+
+// Picks the LOD with the largest minimum distance that **model** is past, full detail when there is none.
+AnimationLOD SelectLOD(const std::vector<AnimationLOD>& LODs, Model& model, DirectX::FXMVECTOR eye) {
+    AnimationLOD selected;
+    if (LODs.empty())
+        return selected;
+
+    float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(GetModelPosition(model), eye)));
+    bool isFound = false;
+    for (const AnimationLOD& LOD : LODs) {
+        if (distance >= LOD.MinDistance && (!isFound || LOD.MinDistance > selected.MinDistance)) {
+            selected = LOD;
+            isFound = true;
+        }
+    }
+    return selected;
+}
+
+AnimationSystem::AnimationSystem(std::uint32_t numThreads)
+    : m_numThreads(numThreads),
+    m_pThreadPool(nullptr),
+    m_numUpdates(0)
+{
+    if (m_numThreads == 0)
+        m_numThreads = ThreadPool::Get().GetNumThreads() + 1;
+    else if (m_numThreads > 1)
+        m_pThreadPool = std::make_unique<ThreadPool>(m_numThreads - 1);
+}
+
+AnimationSystem::~AnimationSystem() {
+
+}
+
+AnimationBinding& AnimationSystem::Bind(const Model& model, std::shared_ptr<IAnimationSampler> pAnimation, bool loop) {
+    if (!pAnimation)
+        throw std::invalid_argument("Binding needs an animation.");
+
+    AnimationBinding& binding = m_bindings[model.GetGUID()];
+    binding.pAnimation = std::move(pAnimation);
+    binding.TimePosition = binding.pAnimation->GetStartTime();
+    binding.Loop = loop;
+    // Makes the next update sample the new animation, whatever the LOD.
+    binding.Pose.Resize(0);
+
+    return binding;
+}
+
+void AnimationSystem::Unbind(std::uint64_t modelGUID) {
+    m_bindings.erase(modelGUID);
+}
+
+void AnimationSystem::UnbindAll() noexcept {
+    m_bindings.clear();
+}
+
+void AnimationSystem::Update(Scene& scene, float deltaTime) {
+    ++m_numUpdates;
+    DirectX::XMVECTOR eye = DirectX::XMLoadFloat3(&scene.GetCamera().GetPosition());
+
+    m_jobs.clear();
+    for (std::shared_ptr<AssetBatch>& pBatch : scene.GetAssetBatches()) {
+        for (auto& [GUID, pModel] : pBatch->GetModels()) {
+            auto it = m_bindings.find(GUID);
+            if (it == m_bindings.end() || it->second.LastUpdate == m_numUpdates || pModel->GetNumBones() == 0)
+                continue;
+
+            AnimationBinding& binding = it->second;
+            binding.LastUpdate = m_numUpdates;
+            Advance(binding, deltaTime);
+
+            // Offset by the GUID so models with the same interval are not all sampled during the same update.
+            // Models that were never sampled are sampled right away.
+            AnimationLOD LOD = SelectLOD(binding.LODs, *pModel, eye);
+            bool isDue = LOD.UpdateInterval <= 1 || (m_numUpdates + GUID) % LOD.UpdateInterval == 0;
+            if (!isDue && binding.Pose.GetNumBones() > 0)
+                continue;
+
+            m_jobs.push_back({ pModel.get(), &binding, LOD.MaxDepth });
+        }
+    }
+
+    // Models playing the same animation end up next to each other and share its data in cache.
+    std::sort(m_jobs.begin(), m_jobs.end(), [](const Job& a, const Job& b) {
+        return a.pBinding->pAnimation.get() < b.pBinding->pAnimation.get();
+    });
+
+    auto body = [this](std::size_t i) { Execute(m_jobs[i]); };
+    if (m_pThreadPool)
+        m_pThreadPool->ParallelFor(0, m_jobs.size(), body);
+    else if (m_numThreads > 1)
+        ThreadPool::Get().ParallelFor(0, m_jobs.size(), body);
+    else
+        std::for_each(m_jobs.begin(), m_jobs.end(), Execute);
+}
+
+void AnimationSystem::Advance(AnimationBinding& binding, float deltaTime) noexcept {
+    binding.TimePosition += deltaTime * binding.Speed;
+    if (binding.Loop) {
+        float startTime = binding.pAnimation->GetStartTime();
+        float duration = binding.pAnimation->GetEndTime() - startTime;
+        if (duration > 0.f) {
+            float offset = std::fmod(binding.TimePosition - startTime, duration);
+            binding.TimePosition = startTime + (offset < 0.f ? offset + duration : offset);
+        }
+    }
+}
+
+void AnimationSystem::Execute(const Job& job) {
+    AnimationBinding& binding = *job.pBinding;
+    Model& model = *job.pModel;
+
+    // The skeleton is sorted by depth, so the bones above the cut-off are a prefix of its order.
+    const Skeleton& skeleton = model.GetSkeleton();
+    std::uint32_t numBones = skeleton.GetNumBones();
+    if (job.MaxDepth > 0 && job.MaxDepth < skeleton.GetNumLevels())
+        numBones = skeleton.GetLevelOffsets()[job.MaxDepth];
+
+    const std::uint16_t* pBoneIndices = skeleton.GetOrder().data();
+    binding.pAnimation->SampleBones(binding.TimePosition, binding.Pose, pBoneIndices, numBones);
+
+    // Bones the animation does not cover are set to the identity.
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        if (pBoneIndices[i] < binding.Pose.GetNumBones())
+            model.SetLocalTransform(pBoneIndices[i], binding.Pose.ToMatrix(pBoneIndices[i]));
+        else
+            model.SetLocalTransform(pBoneIndices[i], DirectX::XMMatrixIdentity());
+    }
+    model.UpdateBoneMatrices();
+}
+
+AnimationBinding& AnimationSystem::GetBinding(std::uint64_t modelGUID) {
+    return m_bindings.at(modelGUID);
+}
+
+std::uint32_t AnimationSystem::GetNumBindings() const noexcept {
+    return m_bindings.size();
+}
+
+std::uint32_t AnimationSystem::GetNumUpdated() const noexcept {
+    return m_jobs.size();
+}
+
+std::uint32_t AnimationSystem::GetNumThreads() const noexcept {
+    return m_numThreads;
+}
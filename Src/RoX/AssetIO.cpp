@@ -2,39 +2,88 @@
 
 #include "../Util/pch.h"
 
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <thread>
+
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
 #define ASSIMP_LOAD_FLAGS (aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_JoinIdenticalVertices | aiProcess_ConvertToLeftHanded)
 
+#include "../FileFormats/BufferCodec.h"
 #include "../FileFormats/RoXModl.h"
 #include "../FileFormats/RoXAnim.h"
+#include "../Util/Logger.h"
+#include "../Util/MappedFile.h"
+#include "../Util/ThreadPool.h"
 
 using BoneNameToAiBone = std::unordered_map<std::string, const aiBone*>;
+// Index of every bone in Model::GetBones, which is the depth first order of the node hierarchy.
+using BoneNameToIndex = std::unordered_map<std::string, std::uint32_t>;
+
+// Bone influences of every vertex in a scene, 4 per vertex in flat arrays.
+// Keeps the 4 strongest influences of a vertex, a new influence replaces the weakest one if it is stronger.
+class VertexBoneData {
+    public:
+        static constexpr std::uint32_t MAX_INFLUENCES = 4;
+
+    public:
+        // Empty slots have a weight of 0 so they are always the first to be replaced.
+        void Resize(std::uint64_t numVertices) {
+            m_indices.assign(numVertices * MAX_INFLUENCES, 0);
+            m_weights.assign(numVertices * MAX_INFLUENCES, 0.f);
+        }
 
-struct VertexBoneData {
-    std::uint8_t CurrentIndex = 0;
-    std::vector<std::uint32_t> Indices = { 0, 0, 0, 0 };
-    std::vector<float> Weights = { 0.f, 0.f, 0.f, 0.f }; 
+        void AddBone(std::uint64_t vertexIndex, std::uint32_t boneIndex, float weight) noexcept {
+            std::uint8_t* pIndices = &m_indices[vertexIndex * MAX_INFLUENCES];
+            float* pWeights = &m_weights[vertexIndex * MAX_INFLUENCES];
 
-    void AddBone(std::uint32_t index, float weight) {
-        if (CurrentIndex > 3)
-            return;
+            std::uint32_t weakest = 0;
+            for (std::uint32_t i = 1; i < MAX_INFLUENCES; ++i) {
+                if (pWeights[i] < pWeights[weakest])
+                    weakest = i;
+            }
 
-        Indices[CurrentIndex] = index;
-        Weights[CurrentIndex++] = weight;
-    }
+            if (weight <= pWeights[weakest])
+                return;
+
+            pIndices[weakest] = static_cast<std::uint8_t>(boneIndex);
+            pWeights[weakest] = weight;
+        }
 
-    void Calibrate() {
-        float total = Weights[0] + Weights[1] + Weights[2] + Weights[3];
+        // Scales the weights of every vertex so they sum up to 1.
+        // A vertex without influences is bound to the first bone.
+        void Normalize() noexcept {
+            for (std::uint64_t i = 0; i < m_weights.size(); i += MAX_INFLUENCES) {
+                float* pWeights = &m_weights[i];
+                float total = pWeights[0] + pWeights[1] + pWeights[2] + pWeights[3];
+                if (total <= 0.f) {
+                    pWeights[0] = 1.f;
+                    continue;
+                }
 
-        int i = 0;
-        while (total < 1.f) {
-            Weights[i % CurrentIndex] += 0.00001;
-            total = Weights[0] + Weights[1] + Weights[2] + Weights[3];
+                float scale = 1.f / total;
+                for (std::uint32_t j = 0; j < MAX_INFLUENCES; ++j) {
+                    pWeights[j] *= scale;
+                }
+            }
         }
-    }
+
+        void Apply(std::uint64_t vertexIndex, VertexPositionNormalTextureSkinning& vertex) const noexcept {
+            const std::uint8_t* pIndices = &m_indices[vertexIndex * MAX_INFLUENCES];
+            const float* pWeights = &m_weights[vertexIndex * MAX_INFLUENCES];
+
+            vertex.SetBlendIndices({ pIndices[0], pIndices[1], pIndices[2], pIndices[3] });
+            vertex.SetBlendWeights({ pWeights[0], pWeights[1], pWeights[2], pWeights[3] });
+        }
+
+    private:
+        // Blend indices are stored as DXGI_FORMAT_R8G8B8A8_UINT on the GPU.
+        std::vector<std::uint8_t> m_indices;
+        std::vector<float> m_weights;
 };
 
 std::string GetNameFromFilePath(std::string filePath) {
@@ -69,6 +118,7 @@ bool IsBone(const aiNode* pNode, BoneNameToAiBone& boneNameToAiBone) {
 void ParseBonesRecursive(
         const aiNode* pNode, 
         BoneNameToAiBone& boneNameToAiBone, 
+        BoneNameToIndex& boneNameToIndex,
         Model& model, 
         std::uint32_t parentIndex, 
         const DirectX::XMMATRIX& parentTransform)
@@ -83,6 +133,7 @@ void ParseBonesRecursive(
         model.GetBones().push_back(bone);
 
         index = model.GetNumBones() - 1;
+        boneNameToIndex.emplace(pNode->mName.C_Str(), index);
 
         DirectX::XMMATRIX offset = ParseMatrix(&boneNameToAiBone.at(pNode->mName.C_Str())->mOffsetMatrix);
         model.GetInverseBindPoseMatrices()[index] = offset;
@@ -93,51 +144,53 @@ void ParseBonesRecursive(
     }
 
     for (int i = 0; i < pNode->mNumChildren; ++i) {
-        ParseBonesRecursive(pNode->mChildren[i], boneNameToAiBone, model, index, globalTransform);
+        ParseBonesRecursive(pNode->mChildren[i], boneNameToAiBone, boneNameToIndex, model, index, globalTransform);
     }
 }
 
-void ParseBones(const aiScene* pScene, Model& model) {
+void ParseBones(const aiScene* pScene, Model& model, BoneNameToIndex& boneNameToIndex) {
     BoneNameToAiBone boneNameToAiBone;
     ParseBoneNameToAiBone(pScene, boneNameToAiBone);
     model.MakeBoneMatricesArray(boneNameToAiBone.size());
     model.MakeInverseBoneMatricesArray(boneNameToAiBone.size());
+    boneNameToIndex.reserve(boneNameToAiBone.size());
     ParseBonesRecursive(
             pScene->mRootNode, 
             boneNameToAiBone, 
+            boneNameToIndex,
             model, 
             -1, 
             DirectX::XMMatrixIdentity());
+    model.CompileSkeleton();
 }
 
-void ParseVertexBoneData(const aiScene* pScene, std::vector<VertexBoneData>& vertexBoneData, std::vector<std::uint32_t>& startVertices, std::vector<Bone>& bones) {
+void ParseVertexBoneData(const aiScene* pScene, VertexBoneData& vertexBoneData, std::vector<std::uint32_t>& startVertices, const BoneNameToIndex& boneNameToIndex) {
     std::uint32_t totalVertices = 0;
 
     startVertices.resize(pScene->mNumMeshes);
     for (std::uint32_t meshIndex = 0; meshIndex < pScene->mNumMeshes; ++meshIndex) {
-        const aiMesh* pMesh = pScene->mMeshes[meshIndex];
-
         startVertices[meshIndex] = totalVertices;
-        totalVertices += pMesh->mNumVertices;
-        vertexBoneData.resize(totalVertices);
+        totalVertices += pScene->mMeshes[meshIndex]->mNumVertices;
+    }
+    vertexBoneData.Resize(totalVertices);
+
+    for (std::uint32_t meshIndex = 0; meshIndex < pScene->mNumMeshes; ++meshIndex) {
+        const aiMesh* pMesh = pScene->mMeshes[meshIndex];
 
         for (std::uint32_t boneIndex = 0; boneIndex < pMesh->mNumBones; ++boneIndex) {
             const aiBone* pBone = pMesh->mBones[boneIndex];
 
-            std::uint32_t boneId = 0;
-            for (std::uint32_t i = 0; i < bones.size(); ++i) {
-                if (bones[i].GetName() == pBone->mName.C_Str()) {
-                    boneId = i;
-                    break;
-                }
-            }
+            auto it = boneNameToIndex.find(pBone->mName.C_Str());
+            std::uint32_t boneId = it != boneNameToIndex.end() ? it->second : 0;
 
             for (std::uint32_t weightIndex = 0; weightIndex < pBone->mNumWeights; ++weightIndex) {
                 const aiVertexWeight weight = pBone->mWeights[weightIndex];
-                vertexBoneData[startVertices[meshIndex] + weight.mVertexId].AddBone(boneId, weight.mWeight);
+                vertexBoneData.AddBone(startVertices[meshIndex] + weight.mVertexId, boneId, weight.mWeight);
             }
         }
     }
+
+    vertexBoneData.Normalize();
 }
 
 void ParseVertices(const aiMesh* pMesh, std::vector<VertexPositionNormalTexture>& vertices) {
@@ -162,7 +215,7 @@ void ParseSkinnedVertices(const aiMesh* pMesh, std::vector<VertexPositionNormalT
     }
 }
 
-void ParseIndices(const aiMesh* pMesh, std::vector<std::uint16_t>& indices) {
+void ParseIndices(const aiMesh* pMesh, std::vector<std::uint32_t>& indices) {
     indices.reserve((pMesh->mNumFaces * 3) + indices.capacity());
     for (int faceIndex = 0; faceIndex < pMesh->mNumFaces; ++faceIndex) {
         for (int faceIndicesIndex = 0; faceIndicesIndex < pMesh->mFaces[faceIndex].mNumIndices; ++faceIndicesIndex) {
@@ -171,11 +224,11 @@ void ParseIndices(const aiMesh* pMesh, std::vector<std::uint16_t>& indices) {
     }
 }
 
-void ParseModel(const aiScene* pScene, Model& model, bool skinned) {
-    std::vector<VertexBoneData> vertexBoneData;
+void ParseModel(const aiScene* pScene, Model& model, bool skinned, const BoneNameToIndex& boneNameToIndex) {
+    VertexBoneData vertexBoneData;
     std::vector<std::uint32_t> startVertices;
-    std::unordered_map<std::string, std::uint32_t> boneNameToIndex;
-    ParseVertexBoneData(pScene, vertexBoneData, startVertices, model.GetBones()); 
+    if (skinned)
+        ParseVertexBoneData(pScene, vertexBoneData, startVertices, boneNameToIndex); 
 
     for (int meshIndex = 0; meshIndex < pScene->mNumMeshes; ++meshIndex) {
         const aiMesh* pAIMesh = pScene->mMeshes[meshIndex];
@@ -184,15 +237,14 @@ void ParseModel(const aiScene* pScene, Model& model, bool skinned) {
         auto pSkinnedMesh = std::make_shared<SkinnedMesh>(pAIMesh->mName.C_Str());
 
         auto pSubmesh = std::make_unique<Submesh>(std::string(pAIMesh->mName.C_Str()) + "_submesh", 0);
+        std::vector<std::uint32_t> indices;
+        ParseIndices(pAIMesh, indices);
         if (skinned) {
             ParseSkinnedVertices(pAIMesh, pSkinnedMesh->GetVertices());
-            ParseIndices(pAIMesh, pSkinnedMesh->GetIndices());
+            pSkinnedMesh->AppendIndices(indices.data(), indices.size());
 
-            for (int vertexIndex = 0; vertexIndex < pSkinnedMesh->GetNumVertices(); ++vertexIndex) {
-                VertexBoneData& bd = vertexBoneData[startVertices[meshIndex] + vertexIndex];
-                bd.Calibrate();
-                pSkinnedMesh->GetVertices()[vertexIndex].SetBlendIndices({ bd.Indices[0], bd.Indices[1], bd.Indices[2], bd.Indices[3] });
-                pSkinnedMesh->GetVertices()[vertexIndex].SetBlendWeights({ bd.Weights[0], bd.Weights[1], bd.Weights[2], bd.Weights[3] });
+            for (std::uint32_t vertexIndex = 0; vertexIndex < pSkinnedMesh->GetNumVertices(); ++vertexIndex) {
+                vertexBoneData.Apply(startVertices[meshIndex] + vertexIndex, pSkinnedMesh->GetVertices()[vertexIndex]);
             }
 
             pSubmesh->SetIndexCount(pSkinnedMesh->GetNumIndices());
@@ -201,7 +253,7 @@ void ParseModel(const aiScene* pScene, Model& model, bool skinned) {
             model.Add(std::move(pSkinnedMesh));
         } else {
             ParseVertices(pAIMesh, pMesh->GetVertices());
-            ParseIndices(pAIMesh, pMesh->GetIndices());
+            pMesh->AppendIndices(indices.data(), indices.size());
 
             pSubmesh->SetIndexCount(pMesh->GetNumIndices());
 
@@ -211,10 +263,10 @@ void ParseModel(const aiScene* pScene, Model& model, bool skinned) {
     }
 }
 
-void ParsePackedModel(const aiScene* pScene, Model& model, bool skinned) {
+void ParsePackedModel(const aiScene* pScene, Model& model, bool skinned, const BoneNameToIndex& boneNameToIndex) {
     std::vector<VertexPositionNormalTexture> vertices;
     std::vector<VertexPositionNormalTextureSkinning> skinnedVertices;
-    std::vector<std::uint16_t> indices;
+    std::vector<std::uint32_t> indices;
 
     auto pMesh = std::make_shared<Mesh>(model.GetName() + "_mesh");
     auto pSkinnedMesh = std::make_shared<SkinnedMesh>(model.GetName() + "_mesh");
@@ -240,29 +292,74 @@ void ParsePackedModel(const aiScene* pScene, Model& model, bool skinned) {
     }
     
     if (skinned) {
-        std::vector<VertexBoneData> vertexBoneData;
+        VertexBoneData vertexBoneData;
         std::vector<std::uint32_t> startVertices;
-        std::unordered_map<std::string, std::uint32_t> boneNameToIndex;
 
-        ParseVertexBoneData(pScene, vertexBoneData, startVertices, model.GetBones()); 
-        for (int i = 0; i < skinnedVertices.size(); ++i) {
-            VertexBoneData& bd = vertexBoneData[i];
-            bd.Calibrate();
-            skinnedVertices[i].SetBlendIndices({ bd.Indices[0], bd.Indices[1], bd.Indices[2], bd.Indices[3] });
-            skinnedVertices[i].SetBlendWeights({ bd.Weights[0], bd.Weights[1], bd.Weights[2], bd.Weights[3] });
+        ParseVertexBoneData(pScene, vertexBoneData, startVertices, boneNameToIndex); 
+        for (std::uint64_t i = 0; i < skinnedVertices.size(); ++i) {
+            vertexBoneData.Apply(i, skinnedVertices[i]);
         }
 
         pSkinnedMesh->GetVertices() = skinnedVertices;
-        pSkinnedMesh->GetIndices() = indices;
+        pSkinnedMesh->AppendIndices(indices.data(), indices.size());
         model.Add(std::move(pSkinnedMesh));
     } else {
         pMesh->GetVertices() = vertices;
-        pMesh->GetIndices() = indices;
+        pMesh->AppendIndices(indices.data(), indices.size());
         model.Add(std::move(pMesh));
     }
 }
 
-std::shared_ptr<Model> AssetIO::ImportModel(std::string filePath, std::shared_ptr<Material> material, bool skinned, bool packMeshes) {
+// Part of every cache key, bump it whenever the output of **ImportModel** or **ImportAnimations** changes
+// so entries written by an older importer are not served anymore.
+static constexpr std::uint64_t IMPORT_CACHE_VERSION = 1;
+
+// Content hash of a source file combined with the settings used to import it, formatted as hex.
+// FNV-1a applied to 8 bytes at a time, only used to name cache entries.
+std::string HashImport(const std::string& filePath, std::initializer_list<std::uint64_t> settings) {
+    static constexpr std::uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325;
+    static constexpr std::uint64_t FNV_PRIME = 0x100000001B3;
+
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    auto combine = [&hash](std::uint64_t value) {
+        hash ^= value;
+        hash *= FNV_PRIME;
+    };
+
+    MappedFile file(filePath);
+    const char* pData = file.GetData();
+    std::uint64_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= file.GetSizeInBytes(); i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        memcpy(&word, pData + i, sizeof(std::uint64_t));
+        combine(word);
+    }
+    for (; i < file.GetSizeInBytes(); ++i) {
+        combine(static_cast<std::uint8_t>(pData[i]));
+    }
+
+    combine(file.GetSizeInBytes());
+    combine(ASSIMP_LOAD_FLAGS);
+    for (std::uint64_t setting : settings) {
+        combine(setting);
+    }
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return hex;
+}
+
+// Failing to write the cache only costs the next import its speed, so it is logged instead of thrown.
+void ReportCacheWriteFailure(const std::filesystem::path& cachePath, const std::string& reason) {
+    Logger::Warning("Failed to write import cache entry '" + cachePath.string() + "': " + reason);
+}
+
+// Unique per thread so concurrent imports of the same file never write to the same temporary path.
+std::string GetTemporaryPath(const std::filesystem::path& path) {
+    return path.string() + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+}
+
+std::shared_ptr<Model> ImportModelWithAssimp(std::string filePath, std::shared_ptr<Material> material, bool skinned, bool packMeshes, bool optimizeMeshes) {
     Assimp::Importer importer;
     const aiScene* pScene = importer.ReadFile(filePath.c_str(), ASSIMP_LOAD_FLAGS);
 
@@ -270,113 +367,115 @@ std::shared_ptr<Model> AssetIO::ImportModel(std::string filePath, std::shared_pt
         throw std::runtime_error("Error parsing '" + filePath + "': " + importer.GetErrorString());
 
     Model model(material, GetNameFromFilePath(filePath));
-    ParseBones(pScene, model);
+    BoneNameToIndex boneNameToIndex;
+    ParseBones(pScene, model, boneNameToIndex);
     if (packMeshes)
-        ParsePackedModel(pScene, model, skinned);
+        ParsePackedModel(pScene, model, skinned, boneNameToIndex);
     else 
-        ParseModel(pScene, model, skinned);
+        ParseModel(pScene, model, skinned, boneNameToIndex);
+
+    if (optimizeMeshes)
+        model.Optimize();
+
+    for (std::shared_ptr<IMesh>& pMesh : model.GetMeshes()) {
+        pMesh->UpdateBounds();
+    }
+    model.MergeBounds();
 
     return std::make_shared<Model>(model);
 }
 
-void ParseKeyframes(const aiNodeAnim* pNodeAnim, std::vector<Keyframe>& keyframes) {
-    for (std::uint32_t i = 0; i < pNodeAnim->mNumScalingKeys; ++i) {
-        const aiVectorKey key = pNodeAnim->mScalingKeys[i];
-
-        std::uint32_t keyframeIndex = -1;
-        for (std::uint32_t j = 0; j < keyframes.size(); ++j) {
-            if (keyframes[j].TimePosition == key.mTime) {
-                keyframeIndex = j;
-                break;
-            }
-        }
-
-        if (keyframeIndex != -1)
-            keyframes[keyframeIndex].Scale = { key.mValue.x, key.mValue.y, key.mValue.z };
-        else {
-            Keyframe keyframe = { (float)key.mTime };
-            keyframe.Scale = { key.mValue.x, key.mValue.y, key.mValue.z };
-            keyframes.push_back(keyframe);
-        }
-    }
-    for (std::uint32_t i = 0; i < pNodeAnim->mNumPositionKeys; ++i) {
-        const aiVectorKey key = pNodeAnim->mPositionKeys[i];
+std::shared_ptr<Model> AssetIO::ImportModel(std::string filePath, std::shared_ptr<Material> material, bool skinned, bool packMeshes, std::string cacheDirectory, bool optimizeMeshes) {
+    if (cacheDirectory.empty())
+        return ImportModelWithAssimp(filePath, material, skinned, packMeshes, optimizeMeshes);
 
-        std::uint32_t keyframeIndex = -1;
-        for (std::uint32_t j = 0; j < keyframes.size(); ++j) {
-            if (keyframes[j].TimePosition == key.mTime) {
-                keyframeIndex = j;
-                break;
-            }
-        }
+    std::string key = HashImport(filePath, { IMPORT_CACHE_VERSION, ROXMODL::V2::VERSION, skinned, packMeshes, optimizeMeshes });
+    std::filesystem::path cachePath = std::filesystem::path(cacheDirectory) / (key + ".roxmodl");
 
-        if (keyframeIndex != -1)
-            keyframes[keyframeIndex].Translation = { key.mValue.x, key.mValue.y, key.mValue.z };
-        else {
-            Keyframe keyframe = { (float)key.mTime };
-            keyframe.Translation = { key.mValue.x, key.mValue.y, key.mValue.z };
-            keyframes.push_back(keyframe);
+    if (std::filesystem::exists(cachePath)) {
+        try {
+            return ImportRoXModl(cachePath.string(), material, ReadMode::MemoryMapped);
+        } catch (const std::exception&) {
+            // A damaged entry is replaced by a fresh import below.
         }
     }
-    for (std::uint32_t i = 0; i < pNodeAnim->mNumRotationKeys; ++i) {
-        const aiQuatKey key = pNodeAnim->mRotationKeys[i];
 
-        std::uint32_t keyframeIndex = -1;
-        for (std::uint32_t j = 0; j < keyframes.size(); ++j) {
-            if (keyframes[j].TimePosition == key.mTime) {
-                keyframeIndex = j;
-                break;
-            }
-        }
-
-        if (keyframeIndex != -1)
-            keyframes[keyframeIndex].RotationQuaternion = { key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w };
-        else {
-            Keyframe keyframe = { (float)key.mTime };
-            keyframe.RotationQuaternion = { key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w };
-            keyframes.push_back(keyframe);
-        }
+    std::shared_ptr<Model> pModel = ImportModelWithAssimp(filePath, material, skinned, packMeshes, optimizeMeshes);
+
+    // The model itself is valid even when the cache entry cannot be written.
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+    std::string temporaryPath = GetTemporaryPath(cachePath);
+    try {
+        ExportRoXModl(pModel, temporaryPath);
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        if (error)
+            ReportCacheWriteFailure(cachePath, error.message());
+    } catch (const std::exception& e) {
+        ReportCacheWriteFailure(cachePath, e.what());
     }
+    std::filesystem::remove(temporaryPath, error);
 
-    std::sort(keyframes.begin(), keyframes.end());
+    return pModel;
 }
 
-void FillMissingBoneAnimations(
-        const aiNode* pNode, 
-        BoneNameToAiBone& boneNameToAiBone, 
-        std::vector<BoneAnimation>& boneAnimations, 
-        std::vector<std::string>& nodeAnimNames,
-        std::uint32_t& boneAnimationIndex) 
-{
-    if (IsBone(pNode, boneNameToAiBone)) {
-        bool hasAnimation = false;
-        std::uint32_t animationIndex = -1;
-        for (std::uint32_t i = 0; i < nodeAnimNames.size(); ++i) {
-            if (nodeAnimNames[i] == pNode->mName.C_Str()) {
-                hasAnimation = true;
-                animationIndex = i;
-                break;
-            }
+// Merges the scaling, position and rotation keys into keyframes in a single pass.
+// Assimp stores the keys of every channel sorted on time, so the earliest remaining key of the three channels
+// is always the next keyframe. Channels without a key at that time keep the default value of the keyframe.
+void ParseKeyframes(const aiNodeAnim* pNodeAnim, std::vector<Keyframe>& keyframes) {
+    std::uint32_t scalingIndex = 0;
+    std::uint32_t positionIndex = 0;
+    std::uint32_t rotationIndex = 0;
+
+    keyframes.reserve(keyframes.size() + std::max({ pNodeAnim->mNumScalingKeys, pNodeAnim->mNumPositionKeys, pNodeAnim->mNumRotationKeys }));
+
+    while (scalingIndex < pNodeAnim->mNumScalingKeys || 
+            positionIndex < pNodeAnim->mNumPositionKeys || 
+            rotationIndex < pNodeAnim->mNumRotationKeys) 
+    {
+        double time = std::numeric_limits<double>::max();
+        if (scalingIndex < pNodeAnim->mNumScalingKeys)
+            time = std::min(time, pNodeAnim->mScalingKeys[scalingIndex].mTime);
+        if (positionIndex < pNodeAnim->mNumPositionKeys)
+            time = std::min(time, pNodeAnim->mPositionKeys[positionIndex].mTime);
+        if (rotationIndex < pNodeAnim->mNumRotationKeys)
+            time = std::min(time, pNodeAnim->mRotationKeys[rotationIndex].mTime);
+
+        // Only a NaN time matches no channel, which would stall the merge.
+        if (time == std::numeric_limits<double>::max())
+            throw std::runtime_error("Invalid key time in channel: '" + std::string(pNodeAnim->mNodeName.C_Str()) + "'");
+
+        Keyframe keyframe = { (float)time };
+
+        // Duplicate keys at the same time are collapsed, the last one wins.
+        while (scalingIndex < pNodeAnim->mNumScalingKeys && pNodeAnim->mScalingKeys[scalingIndex].mTime == time) {
+            const aiVector3D& value = pNodeAnim->mScalingKeys[scalingIndex++].mValue;
+            keyframe.Scale = { value.x, value.y, value.z };
         }
-
-        if (hasAnimation && (animationIndex != boneAnimationIndex)) {
-            std::swap(boneAnimations[animationIndex], boneAnimations[boneAnimationIndex]);
-            std::swap(nodeAnimNames[animationIndex], nodeAnimNames[boneAnimationIndex]);
+        while (positionIndex < pNodeAnim->mNumPositionKeys && pNodeAnim->mPositionKeys[positionIndex].mTime == time) {
+            const aiVector3D& value = pNodeAnim->mPositionKeys[positionIndex++].mValue;
+            keyframe.Translation = { value.x, value.y, value.z };
         }
-
-        if (!hasAnimation) {
-            boneAnimations.insert(boneAnimations.begin() + boneAnimationIndex, BoneAnimation());    
-            nodeAnimNames.insert(nodeAnimNames.begin() + boneAnimationIndex, pNode->mName.C_Str());
+        while (rotationIndex < pNodeAnim->mNumRotationKeys && pNodeAnim->mRotationKeys[rotationIndex].mTime == time) {
+            const aiQuaternion& value = pNodeAnim->mRotationKeys[rotationIndex++].mValue;
+            keyframe.RotationQuaternion = { value.x, value.y, value.z, value.w };
         }
-        ++boneAnimationIndex;
+
+        keyframes.push_back(keyframe);
     }
+}
+
+// Numbers the bones in the same depth first order as ParseBones, without building a model.
+void ParseBoneNameToIndex(const aiNode* pNode, BoneNameToAiBone& boneNameToAiBone, BoneNameToIndex& boneNameToIndex, std::uint32_t& boneIndex) {
+    if (IsBone(pNode, boneNameToAiBone))
+        boneNameToIndex.emplace(pNode->mName.C_Str(), boneIndex++);
 
     for (std::uint32_t i = 0; i < pNode->mNumChildren; ++i) {
-        FillMissingBoneAnimations(pNode->mChildren[i], boneNameToAiBone, boneAnimations, nodeAnimNames, boneAnimationIndex);
+        ParseBoneNameToIndex(pNode->mChildren[i], boneNameToAiBone, boneNameToIndex, boneIndex);
     } 
 }
 
-std::unordered_map<std::string, std::shared_ptr<Animation>> AssetIO::ImportAnimations(std::string filePath) {
+std::unordered_map<std::string, std::shared_ptr<Animation>> ImportAnimationsWithAssimp(std::string filePath) {
     Assimp::Importer importer;
     const aiScene* pScene = importer.ReadFile(filePath.c_str(), ASSIMP_LOAD_FLAGS);
 
@@ -388,6 +487,10 @@ std::unordered_map<std::string, std::shared_ptr<Animation>> AssetIO::ImportAnima
     BoneNameToAiBone boneNameToAiBone;
     ParseBoneNameToAiBone(pScene, boneNameToAiBone);
 
+    BoneNameToIndex boneNameToIndex;
+    std::uint32_t numBones = 0;
+    ParseBoneNameToIndex(pScene->mRootNode, boneNameToAiBone, boneNameToIndex, numBones);
+
     for (std::uint32_t animationIndex = 0; animationIndex < pScene->mNumAnimations; ++animationIndex) {
         const aiAnimation* pAiAnimation = pScene->mAnimations[animationIndex];
 
@@ -395,16 +498,17 @@ std::unordered_map<std::string, std::shared_ptr<Animation>> AssetIO::ImportAnima
         if (!pAnimation)
             pAnimation = std::make_shared<Animation>(pAiAnimation->mName.C_Str());
 
-        std::vector<std::string> nodeAnimNames;
+        // Bone animations are stored in the order of the bones, bones without a channel keep an empty animation.
+        std::vector<BoneAnimation>& boneAnimations = pAnimation->GetBoneAnimations();
+        boneAnimations.resize(numBones);
 
         for (std::uint32_t nodeAnimIndex = 0; nodeAnimIndex < pAiAnimation->mNumChannels; ++nodeAnimIndex) {
             const aiNodeAnim* pNodeAnim = pAiAnimation->mChannels[nodeAnimIndex];
 
-            if (boneNameToAiBone.find(pNodeAnim->mNodeName.C_Str()) == boneNameToAiBone.end())
+            auto it = boneNameToIndex.find(pNodeAnim->mNodeName.C_Str());
+            if (it == boneNameToIndex.end())
                 continue;
 
-            nodeAnimNames.push_back(pNodeAnim->mNodeName.C_Str());
-
             BoneAnimation boneAnimation;
             ParseKeyframes(pNodeAnim, boneAnimation.Keyframes);
             if (boneAnimation.Keyframes.size() == 1) // A BoneAnimation need at least 2 keyframes.
@@ -413,83 +517,253 @@ std::unordered_map<std::string, std::shared_ptr<Animation>> AssetIO::ImportAnima
             for (Keyframe& key : boneAnimation.Keyframes) {
                 key.TimePosition /= pAiAnimation->mTicksPerSecond == 0 ? 30 : pAiAnimation->mTicksPerSecond;
             }
+            boneAnimation.UpdateTimePositions();
 
-            pAnimation->GetBoneAnimations().push_back(std::move(boneAnimation));
+            boneAnimations[it->second] = std::move(boneAnimation);
         }
+    }
+
+    return animations;
+}
+
+// Cache entries for animations are directories holding one .roxanim per animation.
+std::unordered_map<std::string, std::shared_ptr<Animation>> AssetIO::ImportAnimations(std::string filePath, std::string cacheDirectory) {
+    if (cacheDirectory.empty())
+        return ImportAnimationsWithAssimp(filePath);
 
-        std::uint32_t startIndex = 0;
-        FillMissingBoneAnimations(pScene->mRootNode, boneNameToAiBone, pAnimation->GetBoneAnimations(), nodeAnimNames, startIndex);
+    std::string key = HashImport(filePath, { IMPORT_CACHE_VERSION, ROXMODL::V2::VERSION, sizeof(Keyframe) });
+    std::filesystem::path cachePath = std::filesystem::path(cacheDirectory) / key;
+
+    std::error_code error;
+    if (std::filesystem::is_directory(cachePath, error)) {
+        try {
+            std::unordered_map<std::string, std::shared_ptr<Animation>> animations;
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(cachePath)) {
+                if (entry.path().extension() != ".roxanim")
+                    continue;
+
+                std::shared_ptr<Animation> pAnimation = ImportRoXAnim(entry.path().string());
+                animations[pAnimation->GetName()] = pAnimation;
+            }
+            return animations;
+        } catch (const std::exception&) {
+            std::filesystem::remove_all(cachePath, error);
+        }
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<Animation>> animations = ImportAnimationsWithAssimp(filePath);
+
+    // The entry is written to a temporary directory first so a partially written entry is never picked up.
+    std::filesystem::path temporaryPath = GetTemporaryPath(cachePath);
+    try {
+        std::filesystem::create_directories(temporaryPath);
+
+        std::uint32_t i = 0;
+        for (auto& [name, pAnimation] : animations) {
+            ExportRoXAnim(pAnimation, (temporaryPath / (std::to_string(i++) + ".roxanim")).string());
+        }
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        if (error)
+            ReportCacheWriteFailure(cachePath, error.message());
+    } catch (const std::exception& e) {
+        ReportCacheWriteFailure(cachePath, e.what());
     }
+    std::filesystem::remove_all(temporaryPath, error);
 
     return animations;
 }
 
-std::shared_ptr<Model> AssetIO::ImportRoXModl(std::string filePath, std::shared_ptr<Material> pMaterial) {
-    std::ifstream fin(filePath, std::ios::binary);
-    if (!fin.is_open())
-        throw std::runtime_error("Failed to open file: '" + filePath + "'");
+// Sequential reader over a file that is completely available in memory.
+// Every read is bounds checked against the size of the file.
+class BinaryReader {
+    public:
+        BinaryReader(const char* pData, std::uint64_t sizeInBytes, const std::string& filePath) noexcept
+            : m_pData(pData),
+            m_sizeInBytes(sizeInBytes),
+            m_offset(0),
+            m_filePath(filePath)
+        {}
+
+        const char* Advance(std::uint64_t sizeInBytes) {
+            if (sizeInBytes > m_sizeInBytes - m_offset)
+                throw std::runtime_error("Unexpected end of file: '" + m_filePath + "'");
+
+            const char* pCurrent = m_pData + m_offset;
+            m_offset += sizeInBytes;
+            return pCurrent;
+        }
 
-    fin.seekg(0);
+        template<typename T>
+        T Read() {
+            T value;
+            memcpy(&value, Advance(sizeof(T)), sizeof(T));
+            return value;
+        }
 
-    ROXMODL::HEADER modelHeader = {};
-    fin.read(reinterpret_cast<char*>(&modelHeader), sizeof(ROXMODL::HEADER));
+        void Read(void* pDestination, std::uint64_t sizeInBytes) {
+            if (sizeInBytes)
+                memcpy(pDestination, Advance(sizeInBytes), sizeInBytes);
+        }
 
-    char* modelName = new char[modelHeader.NameSizeInBytes + 1];
-    fin.read(modelName, modelHeader.NameSizeInBytes);
-    modelName[modelHeader.NameSizeInBytes] = '\0';
+        std::string ReadString(std::uint64_t sizeInBytes) {
+            return std::string(Advance(sizeInBytes), sizeInBytes);
+        }
 
-    std::vector<Bone> bones;
-    bones.reserve(modelHeader.NumBones);
-    for (std::uint8_t i = 0; i < modelHeader.NumBones; ++i) {
-        ROXMODL::BONE_HEADER boneHeader = {};
-        fin.read(reinterpret_cast<char*>(&boneHeader), sizeof(ROXMODL::BONE_HEADER));
+        // Random access into the file, does not move the read position.
+        const char* View(std::uint64_t offsetInBytes, std::uint64_t sizeInBytes) const {
+            if (offsetInBytes > m_sizeInBytes || sizeInBytes > m_sizeInBytes - offsetInBytes)
+                throw std::runtime_error("Offset out of bounds in file: '" + m_filePath + "'");
+            return m_pData + offsetInBytes;
+        }
+
+        const std::string& GetFilePath() const noexcept {
+            return m_filePath;
+        }
+
+    private:
+        const char* m_pData;
+        std::uint64_t m_sizeInBytes;
+        std::uint64_t m_offset;
+        const std::string& m_filePath;
+};
+
+// Copies the contents of a buffer out of the file, decoding it if needed.
+void ReadBuffer(
+        void* pDestination, 
+        std::uint32_t elementSizeInBytes, 
+        std::uint64_t numElements, 
+        const char* pSource, 
+        std::uint64_t sizeInBytes, 
+        ROXMODL::V2::BUFFER_ENCODING encoding) 
+{
+    auto pData = reinterpret_cast<const std::uint8_t*>(pSource);
+    switch (encoding) {
+        case ROXMODL::V2::BUFFER_ENCODING::Raw:
+            if (sizeInBytes < elementSizeInBytes * numElements)
+                throw std::runtime_error("Buffer is too small.");
+            if (numElements)
+                memcpy(pDestination, pSource, elementSizeInBytes * numElements);
+            break;
+        case ROXMODL::V2::BUFFER_ENCODING::DeltaVarint:
+            BufferCodec::DecodeIndices(pDestination, numElements, elementSizeInBytes, pData, sizeInBytes);
+            break;
+        case ROXMODL::V2::BUFFER_ENCODING::BytePlane:
+            BufferCodec::DecodeVertices(pDestination, numElements, elementSizeInBytes, pData, sizeInBytes);
+            break;
+        default:
+            throw std::runtime_error("Unsupported buffer encoding: " + std::to_string(static_cast<std::uint32_t>(encoding)));
+    }
+}
 
-        char* boneName = new char[boneHeader.NameSizeInBytes + 1];
-        fin.read(boneName, boneHeader.NameSizeInBytes);
-        boneName[boneHeader.NameSizeInBytes] = '\0';
+void ReadIndices(
+        const char* pIndices, 
+        std::uint64_t sizeInBytes, 
+        std::uint32_t indexSizeInBytes, 
+        std::uint64_t numIndices, 
+        IMesh& iMesh, 
+        ROXMODL::V2::BUFFER_ENCODING encoding = ROXMODL::V2::BUFFER_ENCODING::Raw) 
+{
+    if (indexSizeInBytes != sizeof(std::uint16_t) && indexSizeInBytes != sizeof(std::uint32_t))
+        throw std::runtime_error("Unsupported index size: " + std::to_string(indexSizeInBytes));
+
+    iMesh.SetIndexSizeInBytes(indexSizeInBytes);
+    if (indexSizeInBytes == sizeof(std::uint16_t)) {
+        iMesh.GetIndices().resize(numIndices);
+        ReadBuffer(iMesh.GetIndices().data(), indexSizeInBytes, numIndices, pIndices, sizeInBytes, encoding);
+    } else {
+        iMesh.GetWideIndices().resize(numIndices);
+        ReadBuffer(iMesh.GetWideIndices().data(), indexSizeInBytes, numIndices, pIndices, sizeInBytes, encoding);
+    }
+}
+
+// Copies a buffer of compact vertices out of the file and decodes them into **mesh**.
+template<typename CompactVertex, typename MeshType>
+void ReadCompactVertices(
+        const char* pVertices, 
+        std::uint64_t sizeInBytes, 
+        std::uint32_t vertexSizeInBytes, 
+        std::uint64_t numVertices, 
+        MeshType& mesh, 
+        ROXMODL::V2::BUFFER_ENCODING encoding,
+        const ROXMODL::V2::VERTEX_QUANTIZATION& quantization) 
+{
+    if (vertexSizeInBytes != sizeof(CompactVertex))
+        throw std::runtime_error("Vertex size mismatch: " + std::to_string(vertexSizeInBytes));
+
+    std::vector<CompactVertex> compactVertices(numVertices);
+    ReadBuffer(compactVertices.data(), vertexSizeInBytes, numVertices, pVertices, sizeInBytes, encoding);
+    mesh.DecodeCompactVertices(compactVertices.data(), static_cast<std::uint32_t>(numVertices), { quantization.Offset, quantization.Scale });
+}
 
-        bones.push_back({ boneName, boneHeader.ParentIndex });
-        delete [] boneName;
+// When **pQuantization** is set the buffer holds compact vertices.
+void ReadVertices(
+        const char* pVertices, 
+        std::uint64_t sizeInBytes, 
+        std::uint32_t vertexSizeInBytes, 
+        std::uint64_t numVertices, 
+        IMesh& iMesh, 
+        ROXMODL::V2::BUFFER_ENCODING encoding = ROXMODL::V2::BUFFER_ENCODING::Raw,
+        const ROXMODL::V2::VERTEX_QUANTIZATION* pQuantization = nullptr) 
+{
+    if (pQuantization) {
+        if (auto p = dynamic_cast<Mesh*>(&iMesh))
+            ReadCompactVertices<VertexPositionNormalTextureCompact>(pVertices, sizeInBytes, vertexSizeInBytes, numVertices, *p, encoding, *pQuantization);
+        else if (auto p = dynamic_cast<SkinnedMesh*>(&iMesh))
+            ReadCompactVertices<VertexPositionNormalTextureSkinningCompact>(pVertices, sizeInBytes, vertexSizeInBytes, numVertices, *p, encoding, *pQuantization);
+        else
+            throw std::runtime_error("Failed to downcast IMesh.");
+        return;
     }
 
-    std::vector<DirectX::XMFLOAT4X4> boneMatrices;
-    boneMatrices.resize(modelHeader.NumBones);
-    fin.read(reinterpret_cast<char*>(boneMatrices.data()), sizeof(DirectX::XMFLOAT4X4) * modelHeader.NumBones);
+    if (auto p = dynamic_cast<Mesh*>(&iMesh)) {
+        if (vertexSizeInBytes != sizeof(VertexPositionNormalTexture))
+            throw std::runtime_error("Vertex size mismatch: " + std::to_string(vertexSizeInBytes));
+
+        p->GetVertices().resize(numVertices);
+        ReadBuffer(p->GetVertices().data(), vertexSizeInBytes, numVertices, pVertices, sizeInBytes, encoding);
+    } else if (auto p = dynamic_cast<SkinnedMesh*>(&iMesh)) {
+        if (vertexSizeInBytes != sizeof(VertexPositionNormalTextureSkinning))
+            throw std::runtime_error("Vertex size mismatch: " + std::to_string(vertexSizeInBytes));
+
+        p->GetVertices().resize(numVertices);
+        ReadBuffer(p->GetVertices().data(), vertexSizeInBytes, numVertices, pVertices, sizeInBytes, encoding);
+    } else
+        throw std::runtime_error("Failed to downcast IMesh.");
+}
+
+std::shared_ptr<Model> ParseRoXModlV1(BinaryReader& reader, std::shared_ptr<Material> pMaterial) {
+    ROXMODL::HEADER modelHeader = reader.Read<ROXMODL::HEADER>();
+    std::string modelName = reader.ReadString(modelHeader.NameSizeInBytes);
+
+    std::vector<Bone> bones;
+    bones.reserve(modelHeader.NumBones);
+    for (std::uint32_t i = 0; i < modelHeader.NumBones; ++i) {
+        ROXMODL::BONE_HEADER boneHeader = reader.Read<ROXMODL::BONE_HEADER>();
+        bones.push_back({ reader.ReadString(boneHeader.NameSizeInBytes), boneHeader.ParentIndex });
+    }
 
-    std::vector<DirectX::XMFLOAT4X4> inverseBoneMatrices;
-    inverseBoneMatrices.resize(modelHeader.NumBones);
-    fin.read(reinterpret_cast<char*>(inverseBoneMatrices.data()), sizeof(DirectX::XMFLOAT4X4) * modelHeader.NumBones);
+    const char* pBoneMatrices = reader.Advance(sizeof(DirectX::XMFLOAT4X4) * modelHeader.NumBones);
+    const char* pInverseBoneMatrices = reader.Advance(sizeof(DirectX::XMFLOAT4X4) * modelHeader.NumBones);
 
     std::vector<std::shared_ptr<IMesh>> meshes;
     meshes.reserve(modelHeader.NumMeshes);
     for (std::uint32_t i = 0; i < modelHeader.NumMeshes; ++i) {
-        ROXMODL::MESH_HEADER meshHeader = {};
-        fin.read(reinterpret_cast<char*>(&meshHeader), sizeof(ROXMODL::MESH_HEADER));
-
-        char* meshName = new char[meshHeader.NameSizeInBytes + 1];
-        fin.read(meshName, meshHeader.NameSizeInBytes);
-        meshName[meshHeader.NameSizeInBytes] = '\0';
+        ROXMODL::MESH_HEADER meshHeader = reader.Read<ROXMODL::MESH_HEADER>();
+        std::string meshName = reader.ReadString(meshHeader.NameSizeInBytes);
 
         std::shared_ptr<IMesh> pMesh;
         if (!meshHeader.IsSkinned)
             pMesh = std::make_shared<Mesh>(meshName);
         else
             pMesh = std::make_shared<SkinnedMesh>(meshName);
-        delete [] meshName;
 
-        pMesh->GetBoneInfluences().resize(sizeof(std::uint32_t) * meshHeader.NumBoneInfluences);
-        fin.read(reinterpret_cast<char*>(pMesh->GetBoneInfluences().data()), sizeof(std::uint32_t) * meshHeader.NumBoneInfluences);
+        pMesh->GetBoneInfluences().resize(meshHeader.NumBoneInfluences);
+        reader.Read(pMesh->GetBoneInfluences().data(), sizeof(std::uint32_t) * meshHeader.NumBoneInfluences);
 
         for (std::uint32_t j = 0; j < meshHeader.NumSubmeshes; ++j) {
-            ROXMODL::SUBMESH_HEADER submeshHeader = {};
-            fin.read(reinterpret_cast<char*>(&submeshHeader), sizeof(ROXMODL::SUBMESH_HEADER));
-
-            char* submeshName = new char[submeshHeader.NameSizeInBytes + 1];
-            fin.read(submeshName, submeshHeader.NameSizeInBytes);
-            submeshName[submeshHeader.NameSizeInBytes] = '\0';
+            ROXMODL::SUBMESH_HEADER submeshHeader = reader.Read<ROXMODL::SUBMESH_HEADER>();
             
-            auto pSubmesh = std::make_unique<Submesh>(submeshName, submeshHeader.MaterialIndex);
-            delete [] submeshName;
+            auto pSubmesh = std::make_unique<Submesh>(reader.ReadString(submeshHeader.NameSizeInBytes), submeshHeader.MaterialIndex);
             pSubmesh->SetIndexCount(submeshHeader.IndexCount);
             pSubmesh->SetStartIndex(submeshHeader.StartIndex);
             pSubmesh->SetVertexOffset(submeshHeader.VertexOffset);
@@ -497,166 +771,569 @@ std::shared_ptr<Model> AssetIO::ImportRoXModl(std::string filePath, std::shared_
             pMesh->Add(std::move(pSubmesh));
         }
 
-        ROXMODL::INDEX_BUFFER_HEADER ibHeader = {};
-        fin.read(reinterpret_cast<char*>(&ibHeader), sizeof(ROXMODL::INDEX_BUFFER_HEADER));
-
-        pMesh->GetIndices().resize(ibHeader.NumIndices);
-        fin.read(reinterpret_cast<char*>(pMesh->GetIndices().data()), ibHeader.IndexSizeInBytes * ibHeader.NumIndices);
+        ROXMODL::INDEX_BUFFER_HEADER ibHeader = reader.Read<ROXMODL::INDEX_BUFFER_HEADER>();
 
-        ROXMODL::VERTEX_BUFFER_HEADER vbHeader = {};
-        fin.read(reinterpret_cast<char*>(&vbHeader), sizeof(ROXMODL::VERTEX_BUFFER_HEADER));
+        std::uint64_t indicesSizeInBytes = ibHeader.IndexSizeInBytes * ibHeader.NumIndices;
+        ReadIndices(reader.Advance(indicesSizeInBytes), indicesSizeInBytes, ibHeader.IndexSizeInBytes, ibHeader.NumIndices, *pMesh);
 
-        if (auto p = dynamic_cast<Mesh*>(pMesh.get())) {
-            p->GetVertices().resize(vbHeader.NumVertices);
-            fin.read(reinterpret_cast<char*>(p->GetVertices().data()), vbHeader.VertexSizeInBytes * vbHeader.NumVertices);
-        } else if (auto p = dynamic_cast<SkinnedMesh*>(pMesh.get())) {
-            p->GetVertices().resize(vbHeader.NumVertices);
-            fin.read(reinterpret_cast<char*>(p->GetVertices().data()), vbHeader.VertexSizeInBytes * vbHeader.NumVertices);
-        } else
-            throw std::runtime_error("Failed to downcast IMesh.");
+        ROXMODL::VERTEX_BUFFER_HEADER vbHeader = reader.Read<ROXMODL::VERTEX_BUFFER_HEADER>();
+        std::uint64_t verticesSizeInBytes = vbHeader.VertexSizeInBytes * vbHeader.NumVertices;
+        ReadVertices(reader.Advance(verticesSizeInBytes), verticesSizeInBytes, vbHeader.VertexSizeInBytes, vbHeader.NumVertices, *pMesh);
+        pMesh->UpdateBounds();
  
         meshes.push_back(std::move(pMesh));
     }
 
-    fin.close();
-
     auto pModel = std::make_shared<Model>(pMaterial, modelName);
-    delete [] modelName;
     pModel->GetMeshes() = std::move(meshes);
+    pModel->MergeBounds();
     pModel->GetBones() = std::move(bones);
-    pModel->MakeBoneMatricesArray(pModel->GetNumBones());;
-    for (std::uint8_t i = 0; i < pModel->GetNumBones(); ++i) {
-        pModel->GetBoneMatrices()[i] = DirectX::XMLoadFloat4x4(&boneMatrices[i]);
+    pModel->CompileSkeleton();
+
+    DirectX::XMFLOAT4X4 matrix;
+    pModel->MakeBoneMatricesArray(pModel->GetNumBones());
+    for (std::uint32_t i = 0; i < pModel->GetNumBones(); ++i) {
+        memcpy(&matrix, pBoneMatrices + i * sizeof(DirectX::XMFLOAT4X4), sizeof(DirectX::XMFLOAT4X4));
+        pModel->GetBoneMatrices()[i] = DirectX::XMLoadFloat4x4(&matrix);
     }
-    pModel->MakeInverseBoneMatricesArray(pModel->GetNumBones());;
-    for (std::uint8_t i = 0; i < pModel->GetNumBones(); ++i) {
-        pModel->GetInverseBindPoseMatrices()[i] = DirectX::XMLoadFloat4x4(&inverseBoneMatrices[i]);
+    pModel->MakeInverseBoneMatricesArray(pModel->GetNumBones());
+    for (std::uint32_t i = 0; i < pModel->GetNumBones(); ++i) {
+        memcpy(&matrix, pInverseBoneMatrices + i * sizeof(DirectX::XMFLOAT4X4), sizeof(DirectX::XMFLOAT4X4));
+        pModel->GetInverseBindPoseMatrices()[i] = DirectX::XMLoadFloat4x4(&matrix);
     }
 
     return pModel;
 }
 
-void AssetIO::ExportRoXModl(std::shared_ptr<Model>& pModel, std::string filePath) {
-    std::ofstream fout(filePath, std::ios::binary);
-    if (!fout.is_open())
-        throw std::runtime_error("Failed to open file: '" + filePath + ".roxmodl'");
+// Finds a chunk in the table of contents of a version 2 file, returns nullptr when the chunk is missing.
+// Throws when the chunk is smaller than **minSizeInBytes**.
+const char* FindOptionalChunk(
+        BinaryReader& reader, 
+        const std::vector<ROXMODL::V2::CHUNK>& chunks, 
+        ROXMODL::V2::CHUNK_TYPE type, 
+        std::uint64_t minSizeInBytes,
+        std::uint64_t* pSizeInBytes = nullptr) 
+{
+    for (const ROXMODL::V2::CHUNK& chunk : chunks) {
+        if (chunk.Type != type)
+            continue;
+
+        if (chunk.SizeInBytes < minSizeInBytes)
+            throw std::runtime_error("Chunk " + std::to_string(static_cast<std::uint32_t>(type)) + " is too small in file: '" + reader.GetFilePath() + "'");
+        if (pSizeInBytes)
+            *pSizeInBytes = chunk.SizeInBytes;
+        return reader.View(chunk.OffsetInBytes, chunk.SizeInBytes);
+    }
+    return nullptr;
+}
 
-    fout.seekp(0);
+// Finds a chunk in the table of contents of a version 2 file.
+// Throws when the chunk is missing or smaller than **minSizeInBytes**.
+const char* FindChunk(
+        BinaryReader& reader, 
+        const std::vector<ROXMODL::V2::CHUNK>& chunks, 
+        ROXMODL::V2::CHUNK_TYPE type, 
+        std::uint64_t minSizeInBytes,
+        std::uint64_t* pSizeInBytes = nullptr) 
+{
+    if (const char* pChunk = FindOptionalChunk(reader, chunks, type, minSizeInBytes, pSizeInBytes))
+        return pChunk;
+    throw std::runtime_error("Missing chunk " + std::to_string(static_cast<std::uint32_t>(type)) + " in file: '" + reader.GetFilePath() + "'");
+}
 
-    ROXMODL::HEADER modelHeader;
-    modelHeader.Version = 1;
-    modelHeader.NameSizeInBytes = pModel->GetName().length();
-    modelHeader.NumBones = pModel->GetNumBones();
-    modelHeader.NumMeshes = pModel->GetNumMeshes();
-    modelHeader.NumMaterials = pModel->GetNumMaterials();
-    fout.write(reinterpret_cast<char*>(&modelHeader), sizeof(ROXMODL::HEADER));
-    fout.write(pModel->GetName().c_str(), modelHeader.NameSizeInBytes);
+// When **pFile** is set the geometry is deferred and read from **pFile** once a mesh requires it.
+std::shared_ptr<Model> ParseRoXModlV2(BinaryReader& reader, std::shared_ptr<Material> pMaterial, std::shared_ptr<MappedFile> pFile) {
+    using namespace ROXMODL::V2;
 
-    for (Bone& bone : pModel->GetBones()) {
-        ROXMODL::BONE_HEADER boneHeader;
-        boneHeader.NameSizeInBytes = bone.GetName().length();
-        boneHeader.ParentIndex = bone.GetParentIndex();
+    HEADER header = reader.Read<HEADER>();
 
-        fout.write(reinterpret_cast<char*>(&boneHeader), sizeof(ROXMODL::BONE_HEADER));
-        fout.write(bone.GetName().c_str(), boneHeader.NameSizeInBytes);
+    std::vector<CHUNK> chunks(header.NumChunks);
+    reader.Read(chunks.data(), sizeof(CHUNK) * header.NumChunks);
+
+    std::uint64_t stringsSizeInBytes = 0;
+    const char* pStrings = FindChunk(reader, chunks, CHUNK_TYPE::Strings, 0, &stringsSizeInBytes);
+    auto readString = [&](const STRING& string) {
+        if (string.OffsetInBytes > stringsSizeInBytes || string.SizeInBytes > stringsSizeInBytes - string.OffsetInBytes)
+            throw std::runtime_error("String out of bounds in file: '" + reader.GetFilePath() + "'");
+        return std::string(pStrings + string.OffsetInBytes, string.SizeInBytes);
+    };
+
+    const char* pBones = FindChunk(reader, chunks, CHUNK_TYPE::Bones, sizeof(BONE) * header.NumBones);
+    const char* pBoneMatrices = FindChunk(reader, chunks, CHUNK_TYPE::BoneMatrices, sizeof(DirectX::XMFLOAT4X4) * header.NumBones);
+    const char* pInverseBoneMatrices = FindChunk(reader, chunks, CHUNK_TYPE::InverseBindPoseMatrices, sizeof(DirectX::XMFLOAT4X4) * header.NumBones);
+    const char* pMeshes = FindChunk(reader, chunks, CHUNK_TYPE::Meshes, sizeof(MESH) * header.NumMeshes);
+    const char* pSubmeshes = FindChunk(reader, chunks, CHUNK_TYPE::Submeshes, sizeof(SUBMESH) * header.NumSubmeshes);
+    const char* pSubmeshBounds = FindOptionalChunk(reader, chunks, CHUNK_TYPE::SubmeshBounds, sizeof(SUBMESH_BOUNDS) * header.NumSubmeshes);
+
+    std::uint64_t boneInfluencesSizeInBytes = 0;
+    const char* pBoneInfluences = FindChunk(reader, chunks, CHUNK_TYPE::BoneInfluences, 0, &boneInfluencesSizeInBytes);
+    const char* pQuantizations = FindOptionalChunk(reader, chunks, CHUNK_TYPE::VertexQuantization, sizeof(VERTEX_QUANTIZATION) * header.NumMeshes);
+
+    auto pModel = std::make_shared<Model>(pMaterial, readString({ header.NameOffset, header.NameSizeInBytes }));
+
+    pModel->GetBones().reserve(header.NumBones);
+    pModel->MakeBoneMatricesArray(header.NumBones);
+    pModel->MakeInverseBoneMatricesArray(header.NumBones);
+    for (std::uint32_t i = 0; i < header.NumBones; ++i) {
+        BONE bone;
+        memcpy(&bone, pBones + i * sizeof(BONE), sizeof(BONE));
+        pModel->GetBones().push_back({ readString(bone.Name), bone.ParentIndex });
+
+        DirectX::XMFLOAT4X4 matrix;
+        memcpy(&matrix, pBoneMatrices + i * sizeof(DirectX::XMFLOAT4X4), sizeof(DirectX::XMFLOAT4X4));
+        pModel->GetBoneMatrices()[i] = DirectX::XMLoadFloat4x4(&matrix);
+
+        memcpy(&matrix, pInverseBoneMatrices + i * sizeof(DirectX::XMFLOAT4X4), sizeof(DirectX::XMFLOAT4X4));
+        pModel->GetInverseBindPoseMatrices()[i] = DirectX::XMLoadFloat4x4(&matrix);
     }
+    // The file may store the bones in any order, the skeleton sorts parents before their children.
+    pModel->CompileSkeleton();
 
-    std::vector<DirectX::XMFLOAT4X4> boneMatrices;
-    boneMatrices.resize(pModel->GetNumBones());
-    for (std::uint8_t i = 0; i < pModel->GetNumBones(); ++i) {
-        DirectX::XMStoreFloat4x4(&boneMatrices[i], pModel->GetBoneMatrices()[i]);
+    pModel->GetMeshes().reserve(header.NumMeshes);
+    for (std::uint32_t i = 0; i < header.NumMeshes; ++i) {
+        MESH meshHeader;
+        memcpy(&meshHeader, pMeshes + i * sizeof(MESH), sizeof(MESH));
+
+        std::shared_ptr<IMesh> pMesh;
+        if (!meshHeader.IsSkinned)
+            pMesh = std::make_shared<Mesh>(readString(meshHeader.Name));
+        else
+            pMesh = std::make_shared<SkinnedMesh>(readString(meshHeader.Name));
+        pMesh->SetBoneIndex(meshHeader.BoneIndex);
+
+        if ((static_cast<std::uint64_t>(meshHeader.FirstBoneInfluence) + meshHeader.NumBoneInfluences) * sizeof(std::uint32_t) > boneInfluencesSizeInBytes)
+            throw std::runtime_error("Bone influences out of bounds in file: '" + reader.GetFilePath() + "'");
+        pMesh->GetBoneInfluences().resize(meshHeader.NumBoneInfluences);
+        if (meshHeader.NumBoneInfluences)
+            memcpy(pMesh->GetBoneInfluences().data(), pBoneInfluences + meshHeader.FirstBoneInfluence * sizeof(std::uint32_t), meshHeader.NumBoneInfluences * sizeof(std::uint32_t));
+
+        if (static_cast<std::uint64_t>(meshHeader.FirstSubmesh) + meshHeader.NumSubmeshes > header.NumSubmeshes)
+            throw std::runtime_error("Submeshes out of bounds in file: '" + reader.GetFilePath() + "'");
+        for (std::uint32_t j = meshHeader.FirstSubmesh; j < meshHeader.FirstSubmesh + meshHeader.NumSubmeshes; ++j) {
+            SUBMESH submeshHeader;
+            memcpy(&submeshHeader, pSubmeshes + j * sizeof(SUBMESH), sizeof(SUBMESH));
+
+            auto pSubmesh = std::make_unique<Submesh>(readString(submeshHeader.Name), submeshHeader.MaterialIndex);
+            pSubmesh->SetIndexCount(submeshHeader.IndexCount);
+            pSubmesh->SetStartIndex(submeshHeader.StartIndex);
+            pSubmesh->SetVertexOffset(submeshHeader.VertexOffset);
+
+            if (pSubmeshBounds) {
+                SUBMESH_BOUNDS bounds;
+                memcpy(&bounds, pSubmeshBounds + j * sizeof(SUBMESH_BOUNDS), sizeof(SUBMESH_BOUNDS));
+                pSubmesh->SetBounds({ bounds.BoxCenter, bounds.BoxExtents }, { bounds.SphereCenter, bounds.SphereRadius });
+            }
+
+            pMesh->Add(std::move(pSubmesh));
+        }
+
+        const INDEX_BUFFER_HEADER& ib = meshHeader.IndexBuffer;
+        const VERTEX_BUFFER_HEADER& vb = meshHeader.VertexBuffer;
+        VERTEX_QUANTIZATION quantization = {};
+        if (pQuantizations)
+            memcpy(&quantization, pQuantizations + i * sizeof(VERTEX_QUANTIZATION), sizeof(VERTEX_QUANTIZATION));
+
+        if (pFile) {
+            // Bounds are checked now so a malformed file fails on import and not on the first draw.
+            reader.View(ib.OffsetInBytes, ib.SizeInBytes);
+            reader.View(vb.OffsetInBytes, vb.SizeInBytes);
+            if (ib.NumIndices > UINT32_MAX || vb.NumVertices > UINT32_MAX)
+                throw std::runtime_error("Mesh is too large in file: '" + reader.GetFilePath() + "'");
+
+            pMesh->SetIndexSizeInBytes(ib.IndexSizeInBytes);
+            pMesh->DeferGeometry([pFile, ib, vb, quantization, isQuantized = pQuantizations != nullptr, hasBounds = pSubmeshBounds != nullptr, filePath = reader.GetFilePath()](IMesh& iMesh) {
+                    BinaryReader fileReader(pFile->GetData(), pFile->GetSizeInBytes(), filePath);
+                    ReadIndices(fileReader.View(ib.OffsetInBytes, ib.SizeInBytes), ib.SizeInBytes, ib.IndexSizeInBytes, ib.NumIndices, iMesh, ib.Encoding);
+                    ReadVertices(fileReader.View(vb.OffsetInBytes, vb.SizeInBytes), vb.SizeInBytes, vb.VertexSizeInBytes, vb.NumVertices, iMesh, vb.Encoding, isQuantized ? &quantization : nullptr);
+                    if (!hasBounds)
+                        iMesh.UpdateBounds();
+                }, 
+                static_cast<std::uint32_t>(ib.NumIndices), 
+                static_cast<std::uint32_t>(vb.NumVertices));
+        } else {
+            ReadIndices(reader.View(ib.OffsetInBytes, ib.SizeInBytes), ib.SizeInBytes, ib.IndexSizeInBytes, ib.NumIndices, *pMesh, ib.Encoding);
+            ReadVertices(reader.View(vb.OffsetInBytes, vb.SizeInBytes), vb.SizeInBytes, vb.VertexSizeInBytes, vb.NumVertices, *pMesh, vb.Encoding, pQuantizations ? &quantization : nullptr);
+            if (!pSubmeshBounds)
+                pMesh->UpdateBounds();
+        }
+
+        pModel->GetMeshes().push_back(std::move(pMesh));
     }
-    fout.write(reinterpret_cast<char*>(boneMatrices.data()), sizeof(DirectX::XMFLOAT4X4) * pModel->GetNumBones());
+    // Deferred meshes from files without bounds get theirs once the geometry is loaded, **Model::RequireGeometry** merges them again.
+    pModel->MergeBounds();
+
+    return pModel;
+}
+
+std::shared_ptr<Model> ParseRoXModl(BinaryReader& reader, std::shared_ptr<Material> pMaterial, std::shared_ptr<MappedFile> pFile = nullptr) {
+    // Both versions start with the version number.
+    std::uint16_t version;
+    memcpy(&version, reader.View(0, sizeof(std::uint16_t)), sizeof(std::uint16_t));
+
+    switch (version) {
+        case 1: 
+            return ParseRoXModlV1(reader, pMaterial);
+        case ROXMODL::V2::VERSION: 
+            return ParseRoXModlV2(reader, pMaterial, std::move(pFile));
+        default:
+            throw std::runtime_error("Unsupported .roxmodl version " + std::to_string(version) + " in file: '" + reader.GetFilePath() + "'");
+    }
+}
+
+std::shared_ptr<Model> AssetIO::ImportRoXModl(std::string filePath, std::shared_ptr<Material> pMaterial, ReadMode mode) {
+    if (mode == ReadMode::DeferredGeometry) {
+        auto pFile = std::make_shared<MappedFile>(filePath);
+        BinaryReader reader(pFile->GetData(), pFile->GetSizeInBytes(), filePath);
+        return ParseRoXModl(reader, pMaterial, pFile);
+    }
+    if (mode == ReadMode::MemoryMapped) {
+        MappedFile file(filePath);
+        BinaryReader reader(file.GetData(), file.GetSizeInBytes(), filePath);
+        return ParseRoXModl(reader, pMaterial);
+    }
+
+    std::ifstream fin(filePath, std::ios::binary | std::ios::ate);
+    if (!fin.is_open())
+        throw std::runtime_error("Failed to open file: '" + filePath + "'");
+
+    std::vector<char> data(static_cast<std::uint64_t>(fin.tellg()));
+    fin.seekg(0);
+    fin.read(data.data(), data.size());
+    fin.close();
+
+    BinaryReader reader(data.data(), data.size(), filePath);
+    return ParseRoXModl(reader, pMaterial);
+}
+
+// Builds a file in memory so it can be written to disk with a single write.
+class BinaryWriter {
+    public:
+        // Appends **sizeInBytes** bytes and returns the offset they were written at.
+        std::uint64_t Write(const void* pSource, std::uint64_t sizeInBytes) {
+            std::uint64_t offset = m_data.size();
+            m_data.resize(offset + sizeInBytes);
+            if (sizeInBytes)
+                memcpy(m_data.data() + offset, pSource, sizeInBytes);
+            return offset;
+        }
 
-    std::vector<DirectX::XMFLOAT4X4> inverseBoneMatrices;
-    inverseBoneMatrices.resize(pModel->GetNumBones());
-    for (std::uint8_t i = 0; i < pModel->GetNumBones(); ++i) {
+        template<typename T>
+        std::uint64_t Write(const T& value) {
+            return Write(&value, sizeof(T));
+        }
+
+        // Pads with zeros until the size is a multiple of **alignment** and returns the new size.
+        std::uint64_t Align(std::uint64_t alignment) {
+            m_data.resize((m_data.size() + alignment - 1) / alignment * alignment, 0);
+            return m_data.size();
+        }
+
+        // Overwrites previously written bytes, throws when the range was not written yet.
+        void Patch(std::uint64_t offsetInBytes, const void* pSource, std::uint64_t sizeInBytes) {
+            if (offsetInBytes > m_data.size() || sizeInBytes > m_data.size() - offsetInBytes)
+                throw std::runtime_error("Patch out of bounds: offset=" + std::to_string(offsetInBytes) + "; size=" + std::to_string(sizeInBytes));
+            if (sizeInBytes)
+                memcpy(m_data.data() + offsetInBytes, pSource, sizeInBytes);
+        }
+
+        const char* GetData() const noexcept { return m_data.data(); }
+        std::uint64_t GetSizeInBytes() const noexcept { return m_data.size(); }
+
+    private:
+        std::vector<char> m_data;
+};
+
+void AssetIO::ExportRoXModl(std::shared_ptr<Model>& pModel, std::string filePath, bool compress, bool quantize) {
+    using namespace ROXMODL::V2;
+
+    // Releases the geometry restored for the export again once it is written, or when writing fails,
+    // so exporting doesn't undo the residency. The geometry stays resident if releasing it fails.
+    struct ReleaseOnExit {
+        std::vector<IMesh*> Meshes;
+        ~ReleaseOnExit() {
+            for (IMesh* pIMesh : Meshes) {
+                try {
+                    pIMesh->ApplyResidency();
+                } catch (const std::exception&) {}
+            }
+        }
+    } restoredMeshes;
+
+    pModel->RequireGeometry();
+    for (std::shared_ptr<IMesh>& pIMesh : pModel->GetMeshes()) {
+        if (pIMesh->IsGeometryReleased()) {
+            pIMesh->RestoreGeometry();
+            restoredMeshes.Meshes.push_back(pIMesh.get());
+        }
+        // The vertices may have been edited without the bounds following them.
+        pIMesh->UpdateBounds();
+    }
+    pModel->MergeBounds();
+
+    std::string strings;
+    auto addString = [&strings](const std::string& string) {
+        STRING result;
+        result.OffsetInBytes = static_cast<std::uint32_t>(strings.size());
+        result.SizeInBytes = static_cast<std::uint32_t>(string.size());
+        strings += string;
+        return result;
+    };
+
+    HEADER header = {};
+    header.Version = VERSION;
+    header.NumBones = pModel->GetNumBones();
+    header.NumMeshes = pModel->GetNumMeshes();
+    header.NumMaterials = pModel->GetNumMaterials();
+
+    STRING modelName = addString(pModel->GetName());
+    header.NameOffset = modelName.OffsetInBytes;
+    header.NameSizeInBytes = modelName.SizeInBytes;
+
+    std::vector<BONE> bones(header.NumBones);
+    std::vector<DirectX::XMFLOAT4X4> boneMatrices(header.NumBones);
+    std::vector<DirectX::XMFLOAT4X4> inverseBoneMatrices(header.NumBones);
+    for (std::uint32_t i = 0; i < header.NumBones; ++i) {
+        Bone& bone = pModel->GetBones()[i];
+        bones[i].Name = addString(bone.GetName());
+        bones[i].ParentIndex = bone.GetParentIndex();
+        bones[i].Reserved = 0;
+
+        DirectX::XMStoreFloat4x4(&boneMatrices[i], pModel->GetBoneMatrices()[i]);
         DirectX::XMStoreFloat4x4(&inverseBoneMatrices[i], pModel->GetInverseBindPoseMatrices()[i]);
     }
-    fout.write(reinterpret_cast<char*>(inverseBoneMatrices.data()), sizeof(DirectX::XMFLOAT4X4) * pModel->GetNumBones());
 
-    for (std::shared_ptr<IMesh>& pMesh : pModel->GetMeshes()) {
-        ROXMODL::MESH_HEADER meshHeader;
+    std::vector<MESH> meshes(header.NumMeshes);
+    std::vector<SUBMESH> submeshes;
+    std::vector<SUBMESH_BOUNDS> submeshBounds;
+    std::vector<std::uint32_t> boneInfluences;
+    for (std::uint32_t i = 0; i < header.NumMeshes; ++i) {
+        std::shared_ptr<IMesh>& pMesh = pModel->GetMeshes()[i];
+        MESH& mesh = meshes[i];
+        mesh = {};
+
         if (dynamic_cast<Mesh*>(pMesh.get()))
-            meshHeader.IsSkinned = false;
+            mesh.IsSkinned = false;
         else if (dynamic_cast<SkinnedMesh*>(pMesh.get()))
-            meshHeader.IsSkinned = true;
+            mesh.IsSkinned = true;
         else
             throw std::runtime_error("Failed to downcast IMesh.");
-        meshHeader.NameSizeInBytes = pMesh->GetName().length();
-        meshHeader.NumBoneInfluences = pMesh->GetNumBoneInfluences();
-        meshHeader.NumSubmeshes = pMesh->GetNumSubmeshes();
 
-        fout.write(reinterpret_cast<char*>(&meshHeader), sizeof(ROXMODL::MESH_HEADER));
-        fout.write(pMesh->GetName().c_str(), meshHeader.NameSizeInBytes);
-        if (meshHeader.NumBoneInfluences)
-            fout.write(reinterpret_cast<char*>(pMesh->GetBoneInfluences().data()), sizeof(std::uint32_t) * meshHeader.NameSizeInBytes);
+        mesh.Name = addString(pMesh->GetName());
+        mesh.BoneIndex = pMesh->GetBoneIndex();
 
-        for (std::unique_ptr<Submesh>& pSubmesh : pMesh->GetSubmeshes()) {
-            ROXMODL::SUBMESH_HEADER submeshHeader;
-            submeshHeader.NameSizeInBytes = pSubmesh->GetName().length();
-            submeshHeader.MaterialIndex = pSubmesh->GetMaterialIndex();
-            submeshHeader.IndexCount = pSubmesh->GetIndexCount();
-            submeshHeader.StartIndex = pSubmesh->GetStartIndex();
-            submeshHeader.VertexOffset = pSubmesh->GetVertexOffset();
+        mesh.FirstBoneInfluence = static_cast<std::uint32_t>(boneInfluences.size());
+        mesh.NumBoneInfluences = pMesh->GetNumBoneInfluences();
+        boneInfluences.insert(boneInfluences.end(), pMesh->GetBoneInfluences().begin(), pMesh->GetBoneInfluences().end());
 
-            fout.write(reinterpret_cast<char*>(&submeshHeader), sizeof(ROXMODL::SUBMESH_HEADER));
-            fout.write(pSubmesh->GetName().c_str(), submeshHeader.NameSizeInBytes);
+        mesh.FirstSubmesh = static_cast<std::uint32_t>(submeshes.size());
+        mesh.NumSubmeshes = pMesh->GetNumSubmeshes();
+        for (std::unique_ptr<Submesh>& pSubmesh : pMesh->GetSubmeshes()) {
+            SUBMESH submesh;
+            submesh.Name = addString(pSubmesh->GetName());
+            submesh.MaterialIndex = pSubmesh->GetMaterialIndex();
+            submesh.IndexCount = pSubmesh->GetIndexCount();
+            submesh.StartIndex = pSubmesh->GetStartIndex();
+            submesh.VertexOffset = pSubmesh->GetVertexOffset();
+            submeshes.push_back(submesh);
+
+            const DirectX::BoundingBox& box = pSubmesh->GetBoundingBox();
+            const DirectX::BoundingSphere& sphere = pSubmesh->GetBoundingSphere();
+            submeshBounds.push_back({ box.Center, box.Extents, sphere.Center, sphere.Radius });
         }
+    }
+    header.NumSubmeshes = static_cast<std::uint32_t>(submeshes.size());
+
+    // Chunks in the order they are written, the chunk table is sized from it.
+    std::vector<CHUNK_TYPE> chunkTypes = {
+        CHUNK_TYPE::Strings,
+        CHUNK_TYPE::Bones,
+        CHUNK_TYPE::BoneMatrices,
+        CHUNK_TYPE::InverseBindPoseMatrices,
+        CHUNK_TYPE::Meshes,
+        CHUNK_TYPE::Submeshes,
+        CHUNK_TYPE::SubmeshBounds,
+        CHUNK_TYPE::BoneInfluences,
+        CHUNK_TYPE::Indices,
+        CHUNK_TYPE::Vertices
+    };
+    if (quantize)
+        chunkTypes.push_back(CHUNK_TYPE::VertexQuantization);
+
+    std::vector<CHUNK> chunks;
+    auto beginChunk = [&chunks, &chunkTypes](BinaryWriter& writer, CHUNK_TYPE type) {
+        if (chunks.size() >= chunkTypes.size() || chunkTypes[chunks.size()] != type)
+            throw std::logic_error("Chunk written out of the order of the chunk table.");
+
+        CHUNK chunk = {};
+        chunk.Type = type;
+        chunk.OffsetInBytes = writer.Align(ALIGNMENT);
+        chunks.push_back(chunk);
+    };
+    auto endChunk = [&chunks](BinaryWriter& writer) {
+        chunks.back().SizeInBytes = writer.GetSizeInBytes() - chunks.back().OffsetInBytes;
+    };
 
-        ROXMODL::INDEX_BUFFER_HEADER ibHeader;
-        ibHeader.NumIndices = pMesh->GetNumIndices();
-        ibHeader.IndexSizeInBytes = sizeof(std::uint16_t);
-
-        fout.write(reinterpret_cast<char*>(&ibHeader), sizeof(ROXMODL::INDEX_BUFFER_HEADER));
-        fout.write(reinterpret_cast<char*>(pMesh->GetIndices().data()), ibHeader.IndexSizeInBytes * ibHeader.NumIndices);
-
-        ROXMODL::VERTEX_BUFFER_HEADER vbHeader;
-        vbHeader.NumVertices = pMesh->GetNumVertices();
+    BinaryWriter writer;
+    header.NumChunks = static_cast<std::uint16_t>(chunkTypes.size());
+    writer.Write(header);
+    std::uint64_t chunksOffset = writer.GetSizeInBytes();
+    std::vector<CHUNK> chunkPlaceholders(header.NumChunks);
+    writer.Write(chunkPlaceholders.data(), sizeof(CHUNK) * chunkPlaceholders.size());
+
+    beginChunk(writer, CHUNK_TYPE::Strings);
+    writer.Write(strings.data(), strings.size());
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::Bones);
+    writer.Write(bones.data(), sizeof(BONE) * bones.size());
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::BoneMatrices);
+    writer.Write(boneMatrices.data(), sizeof(DirectX::XMFLOAT4X4) * boneMatrices.size());
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::InverseBindPoseMatrices);
+    writer.Write(inverseBoneMatrices.data(), sizeof(DirectX::XMFLOAT4X4) * inverseBoneMatrices.size());
+    endChunk(writer);
+
+    // Mesh records are patched once the offsets of their buffers are known.
+    beginChunk(writer, CHUNK_TYPE::Meshes);
+    std::uint64_t meshesOffset = writer.Write(meshes.data(), sizeof(MESH) * meshes.size());
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::Submeshes);
+    writer.Write(submeshes.data(), sizeof(SUBMESH) * submeshes.size());
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::SubmeshBounds);
+    writer.Write(submeshBounds.data(), sizeof(SUBMESH_BOUNDS) * submeshBounds.size());
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::BoneInfluences);
+    writer.Write(boneInfluences.data(), sizeof(std::uint32_t) * boneInfluences.size());
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::Indices);
+    for (std::uint32_t i = 0; i < header.NumMeshes; ++i) {
+        std::shared_ptr<IMesh>& pMesh = pModel->GetMeshes()[i];
+        INDEX_BUFFER_HEADER& ib = meshes[i].IndexBuffer;
+        ib.NumIndices = pMesh->GetNumIndices();
+        ib.IndexSizeInBytes = pMesh->GetIndexSizeInBytes();
+        ib.OffsetInBytes = writer.Align(ALIGNMENT);
+
+        const void* pIndices = pMesh->GetWideIndices().data();
+        if (ib.IndexSizeInBytes == sizeof(std::uint16_t))
+            pIndices = pMesh->GetIndices().data();
+
+        if (compress) {
+            std::vector<std::uint8_t> encoded = BufferCodec::EncodeIndices(pIndices, ib.NumIndices, ib.IndexSizeInBytes);
+            ib.Encoding = BUFFER_ENCODING::DeltaVarint;
+            ib.SizeInBytes = encoded.size();
+            writer.Write(encoded.data(), ib.SizeInBytes);
+        } else {
+            ib.Encoding = BUFFER_ENCODING::Raw;
+            ib.SizeInBytes = ib.IndexSizeInBytes * ib.NumIndices;
+            writer.Write(pIndices, ib.SizeInBytes);
+        }
+    }
+    endChunk(writer);
+
+    beginChunk(writer, CHUNK_TYPE::Vertices);
+    std::vector<VertexQuantization> quantizations(quantize ? header.NumMeshes : 0);
+    for (std::uint32_t i = 0; i < header.NumMeshes; ++i) {
+        std::shared_ptr<IMesh>& pMesh = pModel->GetMeshes()[i];
+        VERTEX_BUFFER_HEADER& vb = meshes[i].VertexBuffer;
+        vb.NumVertices = pMesh->GetNumVertices();
+        vb.OffsetInBytes = writer.Align(ALIGNMENT);
+
+        const void* pVertices;
+        std::vector<VertexPositionNormalTextureCompact> compactVertices;
+        std::vector<VertexPositionNormalTextureSkinningCompact> compactSkinningVertices;
         if (auto p = dynamic_cast<Mesh*>(pMesh.get())) {
-            vbHeader.VertexSizeInBytes = sizeof(VertexPositionNormalTexture);
-
-            fout.write(reinterpret_cast<char*>(&vbHeader), sizeof(ROXMODL::VERTEX_BUFFER_HEADER));
-            fout.write(reinterpret_cast<char*>(p->GetVertices().data()), vbHeader.VertexSizeInBytes * vbHeader.NumVertices);
+            if (quantize) {
+                quantizations[i] = p->EncodeCompactVertices(compactVertices);
+                vb.VertexSizeInBytes = sizeof(VertexPositionNormalTextureCompact);
+                pVertices = compactVertices.data();
+            } else {
+                vb.VertexSizeInBytes = sizeof(VertexPositionNormalTexture);
+                pVertices = p->GetVertices().data();
+            }
         } else if (auto p = dynamic_cast<SkinnedMesh*>(pMesh.get())) {
-            vbHeader.VertexSizeInBytes = sizeof(VertexPositionNormalTextureSkinning);
-
-            fout.write(reinterpret_cast<char*>(&vbHeader), sizeof(ROXMODL::VERTEX_BUFFER_HEADER));
-            fout.write(reinterpret_cast<char*>(p->GetVertices().data()), vbHeader.VertexSizeInBytes * vbHeader.NumVertices);
+            if (quantize) {
+                quantizations[i] = p->EncodeCompactVertices(compactSkinningVertices);
+                vb.VertexSizeInBytes = sizeof(VertexPositionNormalTextureSkinningCompact);
+                pVertices = compactSkinningVertices.data();
+            } else {
+                vb.VertexSizeInBytes = sizeof(VertexPositionNormalTextureSkinning);
+                pVertices = p->GetVertices().data();
+            }
         } else
             throw std::runtime_error("Failed to downcast IMesh.");
+
+        if (compress) {
+            std::vector<std::uint8_t> encoded = BufferCodec::EncodeVertices(pVertices, vb.NumVertices, vb.VertexSizeInBytes);
+            vb.Encoding = BUFFER_ENCODING::BytePlane;
+            vb.SizeInBytes = encoded.size();
+            writer.Write(encoded.data(), vb.SizeInBytes);
+        } else {
+            vb.Encoding = BUFFER_ENCODING::Raw;
+            vb.SizeInBytes = vb.VertexSizeInBytes * vb.NumVertices;
+            writer.Write(pVertices, vb.SizeInBytes);
+        }
     }
+    endChunk(writer);
 
-    fout.close();
-}
+    if (quantize) {
+        beginChunk(writer, CHUNK_TYPE::VertexQuantization);
+        for (const VertexQuantization& quantization : quantizations) {
+            writer.Write(VERTEX_QUANTIZATION{ quantization.Offset, quantization.Scale });
+        }
+        endChunk(writer);
+    }
 
-std::shared_ptr<Animation> AssetIO::ImportRoXAnim(std::string filePath) {
-    std::ifstream fin = std::ifstream(filePath, std::ios::binary);
-    if (!fin.is_open())
-        throw std::runtime_error("Failed to open file: '" + filePath + ".roxmodl'");
+    if (chunks.size() != header.NumChunks)
+        throw std::logic_error("Wrote " + std::to_string(chunks.size()) + " chunks, the chunk table holds " + std::to_string(header.NumChunks) + ".");
 
-    fin.seekg(0);
+    writer.Patch(meshesOffset, meshes.data(), sizeof(MESH) * meshes.size());
+    writer.Patch(chunksOffset, chunks.data(), sizeof(CHUNK) * chunks.size());
 
-    ROXANIM::ANIM_HEADER animHeader;
-    fin.read(reinterpret_cast<char*>(&animHeader), sizeof(ROXANIM::ANIM_HEADER));
+    std::ofstream fout(filePath, std::ios::binary);
+    if (!fout.is_open())
+        throw std::runtime_error("Failed to open file: '" + filePath + "'");
 
-    char* animName = new char[animHeader.NameSizeInBytes + 1];
-    fin.read(animName, animHeader.NameSizeInBytes);
-    animName[animHeader.NameSizeInBytes] = '\0';
+    fout.write(writer.GetData(), writer.GetSizeInBytes());
+    fout.close();
+}
 
-    auto pAnim = std::make_shared<Animation>(animName);
+std::shared_ptr<Animation> AssetIO::ImportRoXAnim(std::string filePath) {
+    MappedFile file(filePath);
+    BinaryReader reader(file.GetData(), file.GetSizeInBytes(), filePath);
+
+    // Peeks at the magic without moving the read position, the header of an uncompressed animation has none.
+    std::uint32_t magic = 0;
+    if (file.GetSizeInBytes() >= sizeof(magic))
+        memcpy(&magic, reader.View(0, sizeof(magic)), sizeof(magic));
+    if (magic == ROXANIM::COMPRESSED_MAGIC)
+        throw std::runtime_error("File holds a compressed animation, use ImportCompressedRoXAnim: '" + filePath + "'");
+
+    auto animHeader = reader.Read<ROXANIM::ANIM_HEADER>();
+    auto pAnim = std::make_shared<Animation>(reader.ReadString(animHeader.NameSizeInBytes));
     pAnim->GetBoneAnimations().resize(animHeader.NumBoneAnimations);
-    delete [] animName;
 
     for (std::uint32_t i = 0; i < animHeader.NumBoneAnimations; ++i) {
-        ROXANIM::BONE_ANIM_HEADER boneAnimHeader;
-        fin.read(reinterpret_cast<char*>(&boneAnimHeader), sizeof(ROXANIM::BONE_ANIM_HEADER));
-
-        pAnim->GetBoneAnimations()[i].Keyframes.resize(boneAnimHeader.NumKeyframes);
-        fin.read(reinterpret_cast<char*>(pAnim->GetBoneAnimations()[i].Keyframes.data()), boneAnimHeader.KeyframeSizeInBytes * boneAnimHeader.NumKeyframes);
+        auto boneAnimHeader = reader.Read<ROXANIM::BONE_ANIM_HEADER>();
+        if (boneAnimHeader.KeyframeSizeInBytes != sizeof(Keyframe))
+            throw std::runtime_error("Keyframe size mismatch: " + std::to_string(boneAnimHeader.KeyframeSizeInBytes) + " in file: '" + filePath + "'");
+
+        // Bounds checked before the keyframes are allocated, so a corrupt count fails instead of allocating.
+        const char* pKeyframes = reader.Advance(sizeof(Keyframe) * boneAnimHeader.NumKeyframes);
+        std::vector<Keyframe>& keyframes = pAnim->GetBoneAnimations()[i].Keyframes;
+        keyframes.resize(boneAnimHeader.NumKeyframes);
+        if (!keyframes.empty())
+            memcpy(keyframes.data(), pKeyframes, sizeof(Keyframe) * keyframes.size());
     }
+    pAnim->UpdateTimePositions();
 
-    fin.close();
     return pAnim;
 }
 
@@ -685,3 +1362,156 @@ void AssetIO::ExportRoXAnim(std::shared_ptr<Animation>& pAnim, std::string fileP
     fout.close();
 }
 
+
+std::shared_ptr<CompressedAnimation> AssetIO::ImportCompressedRoXAnim(std::string filePath) {
+    MappedFile file(filePath);
+    BinaryReader reader(file.GetData(), file.GetSizeInBytes(), filePath);
+
+    if (file.GetSizeInBytes() < sizeof(ROXANIM::COMPRESSED_HEADER))
+        throw std::runtime_error("File does not hold a compressed animation: '" + filePath + "'");
+    auto header = reader.Read<ROXANIM::COMPRESSED_HEADER>();
+    if (header.Magic != ROXANIM::COMPRESSED_MAGIC)
+        throw std::runtime_error("File does not hold a compressed animation: '" + filePath + "'");
+
+    std::string name = reader.ReadString(header.NameSizeInBytes);
+
+    // Bounds checked before the arrays are allocated, so a corrupt count fails instead of allocating.
+    const char* pTracks = reader.Advance(sizeof(CompressedTrack) * static_cast<std::uint64_t>(header.NumTracks));
+    const char* pData = reader.Advance(sizeof(std::uint16_t) * static_cast<std::uint64_t>(header.NumValues));
+
+    std::vector<CompressedTrack> tracks(header.NumTracks);
+    if (!tracks.empty())
+        memcpy(tracks.data(), pTracks, sizeof(CompressedTrack) * tracks.size());
+
+    std::vector<std::uint16_t> data(header.NumValues);
+    if (!data.empty())
+        memcpy(data.data(), pData, sizeof(std::uint16_t) * data.size());
+
+    return std::make_shared<CompressedAnimation>(name, header.StartTime, header.EndTime, std::move(tracks), std::move(data));
+}
+
+void AssetIO::ExportRoXAnim(std::shared_ptr<CompressedAnimation>& pAnim, std::string filePath) {
+    std::ofstream fout = std::ofstream(filePath, std::ios::binary);
+    if (!fout.is_open())
+        throw std::runtime_error("Failed to open file: '" + filePath + "'");
+
+    const std::vector<CompressedTrack>& tracks = pAnim->GetTracks();
+    const std::vector<std::uint16_t>& data = pAnim->GetData();
+
+    ROXANIM::COMPRESSED_HEADER header;
+    header.Magic = ROXANIM::COMPRESSED_MAGIC;
+    header.NameSizeInBytes = pAnim->GetName().length();
+    header.StartTime = pAnim->GetStartTime();
+    header.EndTime = pAnim->GetEndTime();
+    header.NumTracks = tracks.size();
+    header.NumValues = data.size();
+
+    fout.write(reinterpret_cast<char*>(&header), sizeof(ROXANIM::COMPRESSED_HEADER));
+    fout.write(pAnim->GetName().c_str(), header.NameSizeInBytes);
+    fout.write(reinterpret_cast<const char*>(tracks.data()), sizeof(CompressedTrack) * tracks.size());
+    fout.write(reinterpret_cast<const char*>(data.data()), sizeof(std::uint16_t) * data.size());
+
+    fout.close();
+}
+
+
+class AssetIO::AsyncImporter::Impl {
+    public:
+        Impl(std::uint32_t numThreads)
+            : Pool(numThreads)
+        {}
+
+        ThreadPool Pool;
+};
+
+AssetIO::AsyncImporter::AsyncImporter(std::uint32_t numThreads)
+    : m_pImpl(std::make_unique<Impl>(numThreads))
+{}
+
+// Joins the worker threads before the callbacks are destroyed.
+AssetIO::AsyncImporter::~AsyncImporter() {
+    m_pImpl.reset();
+}
+
+std::future<std::shared_ptr<Model>> AssetIO::AsyncImporter::ImportModel(std::string filePath, std::shared_ptr<Material> pMaterial, bool skinned, bool packMeshes, std::string cacheDirectory, bool optimizeMeshes) {
+    return m_pImpl->Pool.Submit([filePath, pMaterial, skinned, packMeshes, cacheDirectory, optimizeMeshes]() {
+        return AssetIO::ImportModel(filePath, pMaterial, skinned, packMeshes, cacheDirectory, optimizeMeshes);
+    });
+}
+
+std::future<std::unordered_map<std::string, std::shared_ptr<Animation>>> AssetIO::AsyncImporter::ImportAnimations(std::string filePath, std::string cacheDirectory) {
+    return m_pImpl->Pool.Submit([filePath, cacheDirectory]() {
+        return AssetIO::ImportAnimations(filePath, cacheDirectory);
+    });
+}
+
+std::future<std::shared_ptr<Model>> AssetIO::AsyncImporter::ImportRoXModl(std::string filePath, std::shared_ptr<Material> pMaterial, ReadMode mode) {
+    return m_pImpl->Pool.Submit([filePath, pMaterial, mode]() {
+        return AssetIO::ImportRoXModl(filePath, pMaterial, mode);
+    });
+}
+
+std::future<std::shared_ptr<Animation>> AssetIO::AsyncImporter::ImportRoXAnim(std::string filePath) {
+    return m_pImpl->Pool.Submit([filePath]() {
+        return AssetIO::ImportRoXAnim(filePath);
+    });
+}
+
+std::vector<std::future<std::shared_ptr<Model>>> AssetIO::AsyncImporter::ImportRoXModls(const std::vector<std::string>& filePaths, std::shared_ptr<Material> pMaterial, ReadMode mode) {
+    std::vector<std::future<std::shared_ptr<Model>>> futures;
+    futures.reserve(filePaths.size());
+    for (const std::string& filePath : filePaths) {
+        futures.push_back(ImportRoXModl(filePath, pMaterial, mode));
+    }
+    return futures;
+}
+
+std::vector<std::future<std::shared_ptr<Animation>>> AssetIO::AsyncImporter::ImportRoXAnims(const std::vector<std::string>& filePaths) {
+    std::vector<std::future<std::shared_ptr<Animation>>> futures;
+    futures.reserve(filePaths.size());
+    for (const std::string& filePath : filePaths) {
+        futures.push_back(ImportRoXAnim(filePath));
+    }
+    return futures;
+}
+
+void AssetIO::AsyncImporter::DispatchCompleted() {
+    // Callbacks run from a local copy, so the ones they queue only land in **m_pending**.
+    std::vector<std::function<bool()>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        pending.swap(m_pending);
+    }
+
+    // Puts the callbacks that did not run back in front of the ones queued meanwhile.
+    std::vector<std::function<bool()>> remaining;
+    auto requeue = [this, &remaining]() {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        remaining.insert(remaining.end(), std::make_move_iterator(m_pending.begin()), std::make_move_iterator(m_pending.end()));
+        m_pending.swap(remaining);
+    };
+
+    for (std::uint64_t i = 0; i < pending.size(); ++i) {
+        bool completed;
+        try {
+            completed = pending[i]();
+        } catch (...) {
+            remaining.insert(remaining.end(), std::make_move_iterator(pending.begin() + i + 1), std::make_move_iterator(pending.end()));
+            requeue();
+            throw;
+        }
+
+        if (!completed)
+            remaining.push_back(std::move(pending[i]));
+    }
+    requeue();
+}
+
+std::uint32_t AssetIO::AsyncImporter::GetNumThreads() const noexcept {
+    return m_pImpl->Pool.GetNumThreads();
+}
+
+std::uint64_t AssetIO::AsyncImporter::GetNumPending() const noexcept {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    return m_pending.size();
+}
@@ -0,0 +1,146 @@
+#include "RoX/BakedAnimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// ---------------------------------------------------------------- //
+//                          BakedAnimation
+// ---------------------------------------------------------------- //
+
+BakedAnimation::BakedAnimation(Animation& animation, Model& model, float sampleRate, DirectX::XMFLOAT3 rootMotionAxes)
+    : m_name(animation.GetName()),
+    m_startTime(animation.GetStartTime()),
+    m_endTime(animation.GetEndTime()),
+    m_sampleRate(sampleRate),
+    m_numBones(model.GetNumBones()),
+    m_numFrames(1)
+{
+    if (!(sampleRate > 0.f))
+        throw std::invalid_argument("Sample rate must be greater than 0.");
+    if (m_numBones == 0)
+        throw std::invalid_argument("Model '" + model.GetName() + "' has no bones to bake the animation for.");
+
+    if (m_endTime > m_startTime) {
+        m_numFrames = static_cast<std::uint32_t>(std::ceil((m_endTime - m_startTime) * m_sampleRate)) + 1;
+        // Spreads the frames evenly up to the end, so the last interval isn't squeezed into a shorter span.
+        m_sampleRate = (m_numFrames - 1) / (m_endTime - m_startTime);
+    }
+
+    m_boneMatrices.resize(static_cast<std::uint64_t>(m_numFrames) * m_numBones);
+    m_rootMotion.resize(m_numFrames);
+
+    const Skeleton& skeleton = model.GetSkeleton();
+    const std::uint16_t* pOrder = skeleton.GetOrder().data();
+    const std::uint16_t* pParentSlots = skeleton.GetParentSlots().data();
+    std::uint32_t rootIndex = pOrder[0];
+
+    std::uint32_t numAnimated = std::min(animation.GetNumBoneAnimations(), m_numBones);
+    Bone::TransformArray toParentTransforms = Bone::MakeArray(std::max(animation.GetNumBoneAnimations(), m_numBones));
+    Bone::TransformArray toRootTransforms = Bone::MakeArray(m_numBones + 1);
+    PlaybackCursor cursor;
+
+    DirectX::XMVECTOR axes = DirectX::XMLoadFloat3(&rootMotionAxes);
+    DirectX::XMVECTOR origin = DirectX::XMVectorZero();
+    for (std::uint32_t frame = 0; frame < m_numFrames; ++frame) {
+        float timePosition = frame + 1 < m_numFrames ? m_startTime + frame / m_sampleRate : m_endTime;
+        animation.Interpolate(timePosition, toParentTransforms, cursor);
+        // Bones the animation does not cover stay at the identity.
+        for (std::uint32_t i = numAnimated; i < m_numBones; ++i) {
+            toParentTransforms[i] = DirectX::XMMatrixIdentity();
+        }
+
+        // Moves the root back to where it was on the first frame, along the extracted axes.
+        DirectX::XMMATRIX& root = toParentTransforms[rootIndex];
+        if (frame == 0)
+            origin = root.r[3];
+        DirectX::XMVECTOR rootMotion = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(root.r[3], origin), axes);
+        root.r[3] = DirectX::XMVectorSubtract(root.r[3], rootMotion);
+        DirectX::XMStoreFloat4A(&m_rootMotion[frame], rootMotion);
+
+        DirectX::XMFLOAT3X4A* pFrame = &m_boneMatrices[static_cast<std::uint64_t>(frame) * m_numBones];
+        toRootTransforms[0] = DirectX::XMMatrixIdentity();
+        for (std::uint32_t i = 0; i < m_numBones; ++i) {
+            toRootTransforms[i + 1] = toParentTransforms[pOrder[i]] * toRootTransforms[pParentSlots[i]];
+            DirectX::XMStoreFloat3x4A(&pFrame[pOrder[i]], model.GetInverseBindPoseMatrices()[pOrder[i]] * toRootTransforms[i + 1]);
+        }
+    }
+}
+
+void BakedAnimation::Apply(float timePosition, Model& model) const {
+    if (model.GetNumBones() != m_numBones)
+        throw std::invalid_argument("Model '" + model.GetName() + "' does not have the number of bones '" + m_name + "' was baked for.");
+
+    float lerpPercent;
+    std::uint32_t frame = FindFrame(timePosition, lerpPercent);
+    std::uint32_t nextFrame = std::min(frame + 1, m_numFrames - 1);
+    const DirectX::XMFLOAT3X4A* pFrame = &m_boneMatrices[static_cast<std::uint64_t>(frame) * m_numBones];
+    const DirectX::XMFLOAT3X4A* pNextFrame = &m_boneMatrices[static_cast<std::uint64_t>(nextFrame) * m_numBones];
+
+    DirectX::XMVECTOR W = DirectX::XMVectorReplicate(lerpPercent);
+    for (std::uint32_t i = 0; i < m_numBones; ++i) {
+        DirectX::XMMATRIX M0 = DirectX::XMLoadFloat3x4A(&pFrame[i]);
+        DirectX::XMMATRIX M1 = DirectX::XMLoadFloat3x4A(&pNextFrame[i]);
+
+        DirectX::XMMATRIX& M = model.GetBoneMatrices()[i];
+        M.r[0] = DirectX::XMVectorLerpV(M0.r[0], M1.r[0], W);
+        M.r[1] = DirectX::XMVectorLerpV(M0.r[1], M1.r[1], W);
+        M.r[2] = DirectX::XMVectorLerpV(M0.r[2], M1.r[2], W);
+        M.r[3] = DirectX::XMVectorLerpV(M0.r[3], M1.r[3], W);
+    }
+
+    // The bone matrices no longer follow the local transforms the model keeps.
+    model.MarkBonesDirty();
+}
+
+DirectX::XMVECTOR BakedAnimation::GetRootMotion(float timePosition) const noexcept {
+    float lerpPercent;
+    std::uint32_t frame = FindFrame(timePosition, lerpPercent);
+    std::uint32_t nextFrame = std::min(frame + 1, m_numFrames - 1);
+
+    DirectX::XMVECTOR V0 = DirectX::XMLoadFloat4A(&m_rootMotion[frame]);
+    DirectX::XMVECTOR V1 = DirectX::XMLoadFloat4A(&m_rootMotion[nextFrame]);
+    return DirectX::XMVectorLerp(V0, V1, lerpPercent);
+}
+
+DirectX::XMVECTOR BakedAnimation::GetRootMotionDelta(float from, float to) const noexcept {
+    DirectX::XMVECTOR delta = DirectX::XMVectorSubtract(GetRootMotion(to), GetRootMotion(from));
+    if (to < from)
+        delta = DirectX::XMVectorAdd(delta, GetRootMotion(m_endTime));
+    return delta;
+}
+
+std::string BakedAnimation::GetName() const noexcept {
+    return m_name;
+}
+
+float BakedAnimation::GetStartTime() const noexcept {
+    return m_startTime;
+}
+
+float BakedAnimation::GetEndTime() const noexcept {
+    return m_endTime;
+}
+
+float BakedAnimation::GetSampleRate() const noexcept {
+    return m_sampleRate;
+}
+
+std::uint32_t BakedAnimation::GetNumBones() const noexcept {
+    return m_numBones;
+}
+
+std::uint32_t BakedAnimation::GetNumFrames() const noexcept {
+    return m_numFrames;
+}
+
+std::uint64_t BakedAnimation::GetSizeInBytes() const noexcept {
+    return m_boneMatrices.size() * sizeof(DirectX::XMFLOAT3X4A) + m_rootMotion.size() * sizeof(DirectX::XMFLOAT4A);
+}
+
+std::uint32_t BakedAnimation::FindFrame(float timePosition, float& lerpPercent) const noexcept {
+    float position = std::clamp((timePosition - m_startTime) * m_sampleRate, 0.f, static_cast<float>(m_numFrames - 1));
+    std::uint32_t frame = m_numFrames > 1 ? std::min(static_cast<std::uint32_t>(position), m_numFrames - 2) : 0;
+    lerpPercent = position - frame;
+    return frame;
+}
@@ -0,0 +1,158 @@
+#include "RoX/CompiledAnimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// ---------------------------------------------------------------- //
+//                          CompiledAnimation
+// ---------------------------------------------------------------- //
+
+CompiledAnimation::CompiledAnimation(Animation& animation, float sampleRate)
+    : m_name(animation.GetName()),
+    m_startTime(0.f),
+    m_endTime(0.f),
+    m_sampleRate(sampleRate),
+    m_numBones(animation.GetNumBoneAnimations()),
+    m_numGroups((m_numBones + 3) / 4),
+    m_numFrames(1)
+{
+    if (!(sampleRate > 0.f))
+        throw std::invalid_argument("Sample rate must be greater than 0.");
+
+    bool hasKeyframes = false;
+    for (BoneAnimation& boneAnimation : animation.GetBoneAnimations()) {
+        if (boneAnimation.Keyframes.empty())
+            continue;
+
+        m_startTime = hasKeyframes ? std::min(m_startTime, boneAnimation.GetStartTime()) : boneAnimation.GetStartTime();
+        m_endTime = hasKeyframes ? std::max(m_endTime, boneAnimation.GetEndTime()) : boneAnimation.GetEndTime();
+        hasKeyframes = true;
+    }
+    if (m_endTime > m_startTime) {
+        m_numFrames = static_cast<std::uint32_t>(std::ceil((m_endTime - m_startTime) * m_sampleRate)) + 1;
+        // Spreads the frames evenly up to the end, so the last interval isn't squeezed into a shorter span.
+        m_sampleRate = (m_numFrames - 1) / (m_endTime - m_startTime);
+    }
+
+    m_samples.resize(static_cast<std::uint64_t>(m_numFrames) * NUM_COMPONENTS * m_numGroups);
+    float* pSamples = reinterpret_cast<float*>(m_samples.data());
+    auto store = [&](std::uint32_t frame, std::uint32_t component, std::uint32_t bone, float value) {
+        pSamples[((static_cast<std::uint64_t>(frame) * NUM_COMPONENTS + component) * m_numGroups) * 4 + bone] = value;
+    };
+
+    for (std::uint32_t bone = 0; bone < m_numGroups * 4; ++bone) {
+        const BoneAnimation* pBoneAnimation = bone < m_numBones ? &animation.GetBoneAnimations()[bone] : nullptr;
+
+        std::uint32_t cursor = 0;
+        DirectX::XMVECTOR previousR = DirectX::XMQuaternionIdentity();
+        for (std::uint32_t frame = 0; frame < m_numFrames; ++frame) {
+            float timePosition = frame + 1 < m_numFrames ? m_startTime + frame / m_sampleRate : m_endTime;
+
+            DirectX::XMVECTOR T = DirectX::XMVectorZero();
+            DirectX::XMVECTOR S = DirectX::XMVectorSplatOne();
+            DirectX::XMVECTOR R = DirectX::XMQuaternionIdentity();
+            if (pBoneAnimation)
+                pBoneAnimation->Sample(timePosition, T, S, R, cursor);
+
+            // Keeps neighbouring frames in the same hemisphere so sampling can lerp without checking the sign.
+            if (frame > 0 && DirectX::XMVectorGetX(DirectX::XMQuaternionDot(previousR, R)) < 0.f)
+                R = DirectX::XMVectorNegate(R);
+            previousR = R;
+
+            DirectX::XMFLOAT3 translation, scale;
+            DirectX::XMFLOAT4 rotation;
+            DirectX::XMStoreFloat3(&translation, T);
+            DirectX::XMStoreFloat3(&scale, S);
+            DirectX::XMStoreFloat4(&rotation, R);
+
+            store(frame, TranslationX, bone, translation.x);
+            store(frame, TranslationY, bone, translation.y);
+            store(frame, TranslationZ, bone, translation.z);
+            store(frame, ScaleX, bone, scale.x);
+            store(frame, ScaleY, bone, scale.y);
+            store(frame, ScaleZ, bone, scale.z);
+            store(frame, RotationX, bone, rotation.x);
+            store(frame, RotationY, bone, rotation.y);
+            store(frame, RotationZ, bone, rotation.z);
+            store(frame, RotationW, bone, rotation.w);
+        }
+    }
+}
+
+void CompiledAnimation::Sample(float timePosition, LocalPose& pose) const {
+    if (pose.GetNumBones() != m_numBones)
+        pose.Resize(m_numBones);
+
+    float position = std::clamp((timePosition - m_startTime) * m_sampleRate, 0.f, static_cast<float>(m_numFrames - 1));
+    std::uint32_t frame = m_numFrames > 1 ? std::min(static_cast<std::uint32_t>(position), m_numFrames - 2) : 0;
+    std::uint32_t nextFrame = std::min(frame + 1, m_numFrames - 1);
+    DirectX::XMVECTOR lerpPercent = DirectX::XMVectorReplicate(position - frame);
+
+    DirectX::XMVECTOR components[NUM_COMPONENTS];
+    for (std::uint32_t group = 0; group < m_numGroups; ++group) {
+        for (std::uint32_t component = 0; component < NUM_COMPONENTS; ++component) {
+            DirectX::XMVECTOR v0 = GetPlane(frame, component)[group];
+            DirectX::XMVECTOR v1 = GetPlane(nextFrame, component)[group];
+            components[component] = DirectX::XMVectorLerpV(v0, v1, lerpPercent);
+        }
+
+        // Normalizes 4 quaternions at once.
+        DirectX::XMVECTOR lengthSq = DirectX::XMVectorMultiply(components[RotationX], components[RotationX]);
+        lengthSq = DirectX::XMVectorMultiplyAdd(components[RotationY], components[RotationY], lengthSq);
+        lengthSq = DirectX::XMVectorMultiplyAdd(components[RotationZ], components[RotationZ], lengthSq);
+        lengthSq = DirectX::XMVectorMultiplyAdd(components[RotationW], components[RotationW], lengthSq);
+        DirectX::XMVECTOR inverseLength = DirectX::XMVectorReciprocalSqrt(lengthSq);
+        // Degenerate quaternions stay zero instead of turning into NaN.
+        inverseLength = DirectX::XMVectorSelect(DirectX::XMVectorZero(), inverseLength, DirectX::XMVectorGreater(lengthSq, DirectX::XMVectorZero()));
+        for (std::uint32_t component = RotationX; component <= RotationW; ++component) {
+            components[component] = DirectX::XMVectorMultiply(components[component], inverseLength);
+        }
+
+        // Back from a vector per component to a vector per bone.
+        DirectX::XMMATRIX translations = DirectX::XMMatrixTranspose({ components[TranslationX], components[TranslationY], components[TranslationZ], DirectX::XMVectorZero() });
+        DirectX::XMMATRIX scales = DirectX::XMMatrixTranspose({ components[ScaleX], components[ScaleY], components[ScaleZ], DirectX::XMVectorZero() });
+        DirectX::XMMATRIX rotations = DirectX::XMMatrixTranspose({ components[RotationX], components[RotationY], components[RotationZ], components[RotationW] });
+
+        std::uint32_t numBones = std::min(4u, m_numBones - group * 4);
+        for (std::uint32_t i = 0; i < numBones; ++i) {
+            std::uint32_t bone = group * 4 + i;
+            DirectX::XMStoreFloat4A(&pose.Translations[bone], translations.r[i]);
+            DirectX::XMStoreFloat4A(&pose.Scales[bone], scales.r[i]);
+            DirectX::XMStoreFloat4A(&pose.RotationQuaternions[bone], rotations.r[i]);
+        }
+    }
+}
+
+void CompiledAnimation::Interpolate(float timePosition, LocalPose& pose, Bone::TransformArray& toParentTransforms) const {
+    Sample(timePosition, pose);
+    pose.ToMatrices(toParentTransforms);
+}
+
+std::string CompiledAnimation::GetName() const noexcept {
+    return m_name;
+}
+
+float CompiledAnimation::GetStartTime() const noexcept {
+    return m_startTime;
+}
+
+float CompiledAnimation::GetEndTime() const noexcept {
+    return m_endTime;
+}
+
+float CompiledAnimation::GetSampleRate() const noexcept {
+    return m_sampleRate;
+}
+
+std::uint32_t CompiledAnimation::GetNumBones() const noexcept {
+    return m_numBones;
+}
+
+std::uint32_t CompiledAnimation::GetNumFrames() const noexcept {
+    return m_numFrames;
+}
+
+const DirectX::XMVECTOR* CompiledAnimation::GetPlane(std::uint32_t frame, std::uint32_t component) const noexcept {
+    return m_samples.data() + (static_cast<std::uint64_t>(frame) * NUM_COMPONENTS + component) * m_numGroups;
+}
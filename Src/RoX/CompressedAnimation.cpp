@@ -0,0 +1,369 @@
+#include "RoX/CompressedAnimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// ---------------------------------------------------------------- //
+//                          Quantization
+// ---------------------------------------------------------------- //
+
+static constexpr float QUANTIZED_MAX = 65535.f;
+// The smallest three components of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)].
+static constexpr float SMALLEST_THREE_RANGE = 0.707106781f;
+static constexpr std::uint32_t SMALLEST_THREE_MAX = 0x7FFF;
+
+// Stores the index of the largest component in 2 bits followed by the other components in 15 bits each.
+void EncodeQuaternion(DirectX::FXMVECTOR Q, std::uint16_t* pOut) {
+    DirectX::XMFLOAT4 q;
+    DirectX::XMStoreFloat4(&q, Q);
+    float components[4] = { q.x, q.y, q.z, q.w };
+
+    std::uint32_t largest = 0;
+    for (std::uint32_t i = 1; i < 4; ++i) {
+        if (std::fabs(components[i]) > std::fabs(components[largest]))
+            largest = i;
+    }
+    // q and -q are the same rotation, the largest component is stored as positive.
+    float sign = components[largest] < 0.f ? -1.f : 1.f;
+
+    std::uint64_t bits = largest;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        if (i == largest)
+            continue;
+
+        float normalized = std::clamp(components[i] * sign / SMALLEST_THREE_RANGE * 0.5f + 0.5f, 0.f, 1.f);
+        bits = (bits << 15) | static_cast<std::uint64_t>(std::lround(normalized * SMALLEST_THREE_MAX));
+    }
+
+    pOut[0] = static_cast<std::uint16_t>(bits >> 32);
+    pOut[1] = static_cast<std::uint16_t>(bits >> 16);
+    pOut[2] = static_cast<std::uint16_t>(bits);
+}
+
+DirectX::XMVECTOR DecodeQuaternion(const std::uint16_t* pIn) {
+    std::uint64_t bits = (static_cast<std::uint64_t>(pIn[0]) << 32) | (static_cast<std::uint64_t>(pIn[1]) << 16) | pIn[2];
+    std::uint32_t largest = (bits >> 45) & 3;
+
+    float components[4];
+    float lengthSq = 0.f;
+    for (std::uint32_t i = 4; i-- > 0;) {
+        if (i == largest)
+            continue;
+
+        components[i] = ((bits & SMALLEST_THREE_MAX) / static_cast<float>(SMALLEST_THREE_MAX) * 2.f - 1.f) * SMALLEST_THREE_RANGE;
+        lengthSq += components[i] * components[i];
+        bits >>= 15;
+    }
+    components[largest] = std::sqrt(std::max(0.f, 1.f - lengthSq));
+
+    return DirectX::XMVectorSet(components[0], components[1], components[2], components[3]);
+}
+
+void EncodeVector(DirectX::FXMVECTOR V, const DirectX::XMFLOAT4& minimum, const DirectX::XMFLOAT4& extent, std::uint16_t* pOut) {
+    DirectX::XMFLOAT4 v;
+    DirectX::XMStoreFloat4(&v, V);
+    float values[3] = { v.x, v.y, v.z };
+    float minimums[3] = { minimum.x, minimum.y, minimum.z };
+    float extents[3] = { extent.x, extent.y, extent.z };
+
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        float normalized = extents[i] > 0.f ? std::clamp((values[i] - minimums[i]) / extents[i], 0.f, 1.f) : 0.f;
+        pOut[i] = static_cast<std::uint16_t>(std::lround(normalized * QUANTIZED_MAX));
+    }
+}
+
+DirectX::XMVECTOR DecodeVector(const std::uint16_t* pIn, const DirectX::XMFLOAT4& minimum, const DirectX::XMFLOAT4& extent) {
+    DirectX::XMVECTOR Q = DirectX::XMVectorSet(pIn[0], pIn[1], pIn[2], 0.f);
+    DirectX::XMVECTOR scale = DirectX::XMVectorScale(DirectX::XMLoadFloat4(&extent), 1.f / QUANTIZED_MAX);
+    return DirectX::XMVectorMultiplyAdd(Q, scale, DirectX::XMLoadFloat4(&minimum));
+}
+
+// ---------------------------------------------------------------- //
+//                          Key reduction
+// ---------------------------------------------------------------- //
+
+DirectX::XMVECTOR InterpolateTrack(CompressedAnimation::TRACK type, DirectX::FXMVECTOR A, DirectX::FXMVECTOR B, float lerpPercent) {
+    if (type == CompressedAnimation::Rotation)
+        return DirectX::XMQuaternionSlerp(A, B, lerpPercent);
+    return DirectX::XMVectorLerp(A, B, lerpPercent);
+}
+
+// Largest difference per component, or the approximate angle between two rotations.
+float TrackError(CompressedAnimation::TRACK type, DirectX::FXMVECTOR A, DirectX::FXMVECTOR B) {
+    if (type == CompressedAnimation::Rotation) {
+        // The chord between unit quaternions is more precise than acos for small angles.
+        float difference = DirectX::XMVectorGetX(DirectX::XMVector4Length(DirectX::XMVectorSubtract(A, B)));
+        float sum = DirectX::XMVectorGetX(DirectX::XMVector4Length(DirectX::XMVectorAdd(A, B)));
+        return 2.f * std::min(difference, sum);
+    }
+
+    DirectX::XMFLOAT3 difference;
+    DirectX::XMStoreFloat3(&difference, DirectX::XMVectorAbs(DirectX::XMVectorSubtract(A, B)));
+    return std::max({ difference.x, difference.y, difference.z });
+}
+
+// Indices of the keys to keep, every removed key is reproduced within **tolerance** by its kept neighbours.
+std::vector<std::uint32_t> ReduceKeys(
+        CompressedAnimation::TRACK type,
+        const std::vector<DirectX::XMVECTOR>& values,
+        const std::vector<float>& times,
+        float tolerance)
+{
+    std::vector<std::uint32_t> keys = { 0 };
+    for (std::uint32_t end = 2; end < values.size(); ++end) {
+        std::uint32_t start = keys.back();
+        float span = times[end] - times[start];
+
+        bool fits = true;
+        for (std::uint32_t i = start + 1; i < end && fits; ++i) {
+            float lerpPercent = span > 0.f ? (times[i] - times[start]) / span : 0.f;
+            fits = TrackError(type, InterpolateTrack(type, values[start], values[end], lerpPercent), values[i]) <= tolerance;
+        }
+        if (!fits)
+            keys.push_back(end - 1);
+    }
+    keys.push_back(values.size() - 1);
+
+    return keys;
+}
+
+// ---------------------------------------------------------------- //
+//                          CompressedAnimation
+// ---------------------------------------------------------------- //
+
+CompressedAnimation::CompressedAnimation(Animation& animation, CompressionTolerance tolerance)
+    : m_name(animation.GetName()),
+    m_startTime(0.f),
+    m_endTime(0.f),
+    m_timeScale(0.f)
+{
+    bool hasKeyframes = false;
+    for (BoneAnimation& boneAnimation : animation.GetBoneAnimations()) {
+        if (boneAnimation.Keyframes.empty())
+            continue;
+
+        m_startTime = hasKeyframes ? std::min(m_startTime, boneAnimation.GetStartTime()) : boneAnimation.GetStartTime();
+        m_endTime = hasKeyframes ? std::max(m_endTime, boneAnimation.GetEndTime()) : boneAnimation.GetEndTime();
+        hasKeyframes = true;
+    }
+    if (m_endTime > m_startTime)
+        m_timeScale = QUANTIZED_MAX / (m_endTime - m_startTime);
+
+    m_tracks.reserve(static_cast<std::uint64_t>(animation.GetNumBoneAnimations()) * NUM_TRACKS);
+
+    std::vector<float> times;
+    std::vector<DirectX::XMVECTOR> translations, scales, rotations;
+    for (BoneAnimation& boneAnimation : animation.GetBoneAnimations()) {
+        times.clear();
+        translations.clear();
+        scales.clear();
+        rotations.clear();
+
+        for (const Keyframe& keyframe : boneAnimation.Keyframes) {
+            DirectX::XMVECTOR R = DirectX::XMLoadFloat4(&keyframe.RotationQuaternion);
+            if (DirectX::XMVectorGetX(DirectX::XMQuaternionLengthSq(R)) > 0.f)
+                R = DirectX::XMQuaternionNormalize(R);
+            else
+                R = DirectX::XMQuaternionIdentity();
+
+            times.push_back(keyframe.TimePosition);
+            translations.push_back(DirectX::XMLoadFloat3(&keyframe.Translation));
+            scales.push_back(DirectX::XMLoadFloat3(&keyframe.Scale));
+            rotations.push_back(R);
+        }
+        if (times.empty()) {
+            times.push_back(0.f);
+            translations.push_back(DirectX::XMVectorZero());
+            scales.push_back(DirectX::XMVectorSet(1.f, 1.f, 1.f, 0.f));
+            rotations.push_back(DirectX::XMQuaternionIdentity());
+        }
+
+        CompressTrack(Translation, translations, times, tolerance.Translation);
+        CompressTrack(Scale, scales, times, tolerance.Scale);
+        CompressTrack(Rotation, rotations, times, tolerance.Rotation);
+    }
+}
+
+CompressedAnimation::CompressedAnimation(
+        std::string name,
+        float startTime,
+        float endTime,
+        std::vector<CompressedTrack> tracks,
+        std::vector<std::uint16_t> data)
+    : m_name(name),
+    m_startTime(startTime),
+    m_endTime(endTime),
+    m_timeScale(endTime > startTime ? QUANTIZED_MAX / (endTime - startTime) : 0.f),
+    m_tracks(std::move(tracks)),
+    m_data(std::move(data))
+{
+    if (m_tracks.size() % NUM_TRACKS != 0)
+        throw std::invalid_argument("Number of tracks must be a multiple of " + std::to_string(NUM_TRACKS) + ".");
+
+    for (const CompressedTrack& track : m_tracks) {
+        if (track.NumKeys < 2)
+            continue;
+        if (static_cast<std::uint64_t>(track.Offset) + static_cast<std::uint64_t>(track.NumKeys) * 4 > m_data.size())
+            throw std::invalid_argument("Track reads past the end of the compressed data.");
+    }
+}
+
+void CompressedAnimation::Sample(float timePosition, LocalPose& pose) const {
+    if (pose.GetNumBones() != GetNumBoneAnimations())
+        pose.Resize(GetNumBoneAnimations());
+
+    float quantizedTime = std::clamp((timePosition - m_startTime) * m_timeScale, 0.f, QUANTIZED_MAX);
+    for (std::uint32_t i = 0; i < GetNumBoneAnimations(); ++i) {
+        const CompressedTrack* pTracks = &m_tracks[i * NUM_TRACKS];
+        DirectX::XMStoreFloat4A(&pose.Translations[i], SampleTrack(pTracks[Translation], Translation, quantizedTime));
+        DirectX::XMStoreFloat4A(&pose.Scales[i], SampleTrack(pTracks[Scale], Scale, quantizedTime));
+        DirectX::XMStoreFloat4A(&pose.RotationQuaternions[i], SampleTrack(pTracks[Rotation], Rotation, quantizedTime));
+    }
+}
+
+void CompressedAnimation::SampleBones(float timePosition, LocalPose& pose, const std::uint16_t* pBoneIndices, std::uint32_t numBones) const {
+    if (pose.GetNumBones() != GetNumBoneAnimations())
+        pose.Resize(GetNumBoneAnimations());
+
+    float quantizedTime = std::clamp((timePosition - m_startTime) * m_timeScale, 0.f, QUANTIZED_MAX);
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        std::uint32_t boneIndex = pBoneIndices[i];
+        if (boneIndex >= GetNumBoneAnimations())
+            continue;
+
+        const CompressedTrack* pTracks = &m_tracks[boneIndex * NUM_TRACKS];
+        DirectX::XMStoreFloat4A(&pose.Translations[boneIndex], SampleTrack(pTracks[Translation], Translation, quantizedTime));
+        DirectX::XMStoreFloat4A(&pose.Scales[boneIndex], SampleTrack(pTracks[Scale], Scale, quantizedTime));
+        DirectX::XMStoreFloat4A(&pose.RotationQuaternions[boneIndex], SampleTrack(pTracks[Rotation], Rotation, quantizedTime));
+    }
+}
+
+void CompressedAnimation::Interpolate(float timePosition, Bone::TransformArray& boneTransforms) const {
+    float quantizedTime = std::clamp((timePosition - m_startTime) * m_timeScale, 0.f, QUANTIZED_MAX);
+    DirectX::XMVECTOR zero = DirectX::XMVectorSet(0.f, 0.f, 0.f, 1.f);
+
+    for (std::uint32_t i = 0; i < GetNumBoneAnimations(); ++i) {
+        const CompressedTrack* pTracks = &m_tracks[i * NUM_TRACKS];
+        DirectX::XMVECTOR T = SampleTrack(pTracks[Translation], Translation, quantizedTime);
+        DirectX::XMVECTOR S = SampleTrack(pTracks[Scale], Scale, quantizedTime);
+        DirectX::XMVECTOR R = SampleTrack(pTracks[Rotation], Rotation, quantizedTime);
+
+        boneTransforms[i] = DirectX::XMMatrixAffineTransformation(S, zero, R, T);
+    }
+}
+
+void CompressedAnimation::Apply(float timePosition, Model& model, PoseBuffer& poseBuffer) const {
+    poseBuffer.Reserve(std::max(model.GetNumBones(), GetNumBoneAnimations()));
+    Interpolate(timePosition, poseBuffer.GetToParentTransforms());
+    poseBuffer.ComposeBoneMatrices(model);
+}
+
+void CompressedAnimation::CompressTrack(TRACK type, const std::vector<DirectX::XMVECTOR>& values, const std::vector<float>& times, float tolerance) {
+    CompressedTrack track = {};
+    track.NumKeys = 1;
+    track.Offset = m_data.size();
+
+    bool isConstant = std::all_of(values.begin(), values.end(), [&](const DirectX::XMVECTOR& V) {
+        return TrackError(type, V, values.front()) <= tolerance;
+    });
+    if (isConstant) {
+        DirectX::XMStoreFloat4(&track.Minimum, values.front());
+        m_tracks.push_back(track);
+        return;
+    }
+
+    std::vector<std::uint32_t> keys = ReduceKeys(type, values, times, tolerance);
+    track.NumKeys = keys.size();
+
+    if (type != Rotation) {
+        DirectX::XMVECTOR minimum = values[keys.front()];
+        DirectX::XMVECTOR maximum = values[keys.front()];
+        for (std::uint32_t key : keys) {
+            minimum = DirectX::XMVectorMin(minimum, values[key]);
+            maximum = DirectX::XMVectorMax(maximum, values[key]);
+        }
+        DirectX::XMStoreFloat4(&track.Minimum, minimum);
+        DirectX::XMStoreFloat4(&track.Extent, DirectX::XMVectorSubtract(maximum, minimum));
+    }
+
+    for (std::uint32_t key : keys) {
+        float quantizedTime = std::clamp((times[key] - m_startTime) * m_timeScale, 0.f, QUANTIZED_MAX);
+        m_data.push_back(static_cast<std::uint16_t>(std::lround(quantizedTime)));
+    }
+    for (std::uint32_t key : keys) {
+        std::uint16_t encoded[3];
+        if (type == Rotation)
+            EncodeQuaternion(values[key], encoded);
+        else
+            EncodeVector(values[key], track.Minimum, track.Extent, encoded);
+        m_data.insert(m_data.end(), encoded, encoded + 3);
+    }
+
+    m_tracks.push_back(track);
+}
+
+DirectX::XMVECTOR CompressedAnimation::SampleTrack(const CompressedTrack& track, TRACK type, float quantizedTime) const {
+    if (track.NumKeys < 2)
+        return DirectX::XMLoadFloat4(&track.Minimum);
+
+    const std::uint16_t* pTimes = m_data.data() + track.Offset;
+    const std::uint16_t* pValues = pTimes + track.NumKeys;
+
+    // Last key at or before **quantizedTime**, there is always a next key.
+    std::uint32_t first = 0;
+    std::uint32_t last = track.NumKeys - 1;
+    while (last - first > 1) {
+        std::uint32_t middle = first + (last - first) / 2;
+        if (pTimes[middle] <= quantizedTime)
+            first = middle;
+        else
+            last = middle;
+    }
+
+    float span = static_cast<float>(pTimes[first + 1]) - pTimes[first];
+    float lerpPercent = span > 0.f ? std::clamp((quantizedTime - pTimes[first]) / span, 0.f, 1.f) : 1.f;
+
+    const std::uint16_t* pCurrent = pValues + first * 3;
+    const std::uint16_t* pNext = pCurrent + 3;
+    if (type == Rotation)
+        return InterpolateTrack(type, DecodeQuaternion(pCurrent), DecodeQuaternion(pNext), lerpPercent);
+    return InterpolateTrack(type, DecodeVector(pCurrent, track.Minimum, track.Extent), DecodeVector(pNext, track.Minimum, track.Extent), lerpPercent);
+}
+
+std::string CompressedAnimation::GetName() const noexcept {
+    return m_name;
+}
+
+float CompressedAnimation::GetStartTime() const noexcept {
+    return m_startTime;
+}
+
+float CompressedAnimation::GetEndTime() const noexcept {
+    return m_endTime;
+}
+
+std::uint32_t CompressedAnimation::GetNumBoneAnimations() const noexcept {
+    return m_tracks.size() / NUM_TRACKS;
+}
+
+std::uint32_t CompressedAnimation::GetNumKeys() const noexcept {
+    std::uint32_t numKeys = 0;
+    for (const CompressedTrack& track : m_tracks) {
+        numKeys += track.NumKeys;
+    }
+    return numKeys;
+}
+
+std::uint64_t CompressedAnimation::GetSizeInBytes() const noexcept {
+    return m_tracks.size() * sizeof(CompressedTrack) + m_data.size() * sizeof(std::uint16_t);
+}
+
+const std::vector<CompressedTrack>& CompressedAnimation::GetTracks() const noexcept {
+    return m_tracks;
+}
+
+const std::vector<std::uint16_t>& CompressedAnimation::GetData() const noexcept {
+    return m_data;
+}
@@ -1,6 +1,6 @@
 #include "RoX/Identifiable.h"
 
-std::uint64_t Identifiable::NEXT_GUID = 0;
+std::atomic<std::uint64_t> Identifiable::NEXT_GUID(0);
 
 Identifiable::Identifiable(std::string defaultName, std::string name)
     noexcept : m_defaultName(defaultName),
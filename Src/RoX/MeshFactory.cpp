@@ -8,6 +8,10 @@ void AppendToMesh(
         std::vector<std::uint16_t>& indicesIn,
         IMesh& iMesh) 
 {
+    // Appending to deferred or released geometry would be overwritten or lost.
+    iMesh.RequireGeometry();
+    iMesh.RestoreGeometry();
+
     if (auto pMesh = dynamic_cast<Mesh*>(&iMesh)) {
         pMesh->GetVertices().reserve(verticesIn.size());
         for (DirectX::VertexPositionNormalTexture vin : verticesIn) {
@@ -21,8 +25,7 @@ void AppendToMesh(
         }
     }
 
-    iMesh.GetIndices().reserve(indicesIn.size());
-    iMesh.GetIndices().insert(iMesh.GetIndices().end(), indicesIn.begin(), indicesIn.end());
+    iMesh.AppendIndices(indicesIn.data(), indicesIn.size());
 }
 
 void ThrowIfUsingStaticBuffers(IMesh& iMesh) {
@@ -44,6 +47,7 @@ void MeshFactory::AddCube(IMesh& iMesh, float size) {
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -62,6 +66,7 @@ void MeshFactory::AddBox(IMesh& iMesh, const DirectX::XMFLOAT3& size, bool inver
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -80,6 +85,7 @@ void MeshFactory::AddSphere(IMesh& iMesh, float diameter, size_t tessellation, b
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -98,6 +104,7 @@ void MeshFactory::AddGeoSphere(IMesh& iMesh, float diameter, size_t tessellation
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -116,6 +123,7 @@ void MeshFactory::AddCylinder(IMesh& iMesh, float height, float diameter, size_t
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -134,6 +142,7 @@ void MeshFactory::AddCone(IMesh& iMesh, float diameter, float height, size_t tes
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -152,6 +161,7 @@ void MeshFactory::AddTorus(IMesh& iMesh, float diameter, float thickness, size_t
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -170,6 +180,7 @@ void MeshFactory::AddTetrahedron(IMesh& iMesh, float size) {
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -188,6 +199,7 @@ void MeshFactory::AddOctahedron(IMesh& iMesh, float size) {
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -206,6 +218,7 @@ void MeshFactory::AddDodecahedron(IMesh& iMesh, float size) {
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -224,6 +237,7 @@ void MeshFactory::AddIcosahedron(IMesh& iMesh, float size) {
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -242,6 +256,7 @@ void MeshFactory::AddTeapot(IMesh& iMesh, float size, size_t tessellation) {
 
     pSubmesh->SetIndexCount(indices.size());
 
+    iMesh.UpdateBounds(*pSubmesh);
     iMesh.Add(std::move(pSubmesh));
     iMesh.UpdateBuffers();
 }
@@ -0,0 +1,200 @@
+#include "RoX/MeshOptimizer.h"
+
+#include "../Util/pch.h"
+
+float MeshOptimizer::ComputeACMR(const std::uint32_t* pIndices, std::uint32_t numIndices, std::uint32_t cacheSize) {
+    if (numIndices < 3)
+        return 0.f;
+
+    std::uint32_t numVertices = *std::max_element(pIndices, pIndices + numIndices) + 1;
+
+    // A vertex is in the cache when fewer than **cacheSize** misses happened since it was last loaded.
+    std::vector<std::uint32_t> loadedAt(numVertices, 0);
+    std::uint32_t numMisses = 0;
+    for (std::uint32_t i = 0; i < numIndices; ++i) {
+        std::uint32_t& time = loadedAt[pIndices[i]];
+        if (time == 0 || numMisses + 1 - time > cacheSize) {
+            ++numMisses;
+            time = numMisses;
+        }
+    }
+    return static_cast<float>(numMisses) / (numIndices / 3);
+}
+
+void MeshOptimizer::OptimizeTriangleOrder(std::uint32_t* pIndices, std::uint32_t numIndices, std::uint32_t cacheSize, std::vector<std::uint32_t>* pClusterStarts) {
+    if (numIndices % 3 != 0)
+        throw std::invalid_argument("Index count " + std::to_string(numIndices) + " is not a multiple of 3.");
+    if (cacheSize < 3)
+        throw std::invalid_argument("Cache size must be at least 3.");
+
+    if (pClusterStarts)
+        pClusterStarts->clear();
+    if (numIndices == 0)
+        return;
+
+    std::uint32_t numTriangles = numIndices / 3;
+    std::uint32_t numVertices = *std::max_element(pIndices, pIndices + numIndices) + 1;
+
+    // Triangles using every vertex, stored as one flat array with an offset per vertex.
+    std::vector<std::uint32_t> liveCounts(numVertices, 0);
+    for (std::uint32_t i = 0; i < numIndices; ++i) {
+        ++liveCounts[pIndices[i]];
+    }
+    std::vector<std::uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (std::uint32_t v = 0; v < numVertices; ++v) {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveCounts[v];
+    }
+    std::vector<std::uint32_t> adjacency(numIndices);
+    std::vector<std::uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (std::uint32_t i = 0; i < numIndices; ++i) {
+        adjacency[fill[pIndices[i]]++] = i / 3;
+    }
+
+    std::vector<std::uint32_t> cacheTimes(numVertices, 0);
+    std::vector<std::uint8_t> emitted(numTriangles, 0);
+    std::vector<std::uint32_t> deadEnds;
+    std::vector<std::uint32_t> candidates;
+    std::vector<std::uint32_t> output;
+    output.reserve(numIndices);
+
+    // Times start past the cache size so no vertex starts in the cache.
+    std::uint32_t time = cacheSize + 1;
+    std::uint32_t cursor = 0;
+    std::int64_t fan = 0;
+    while (fan >= 0) {
+        candidates.clear();
+        for (std::uint32_t a = adjacencyOffsets[fan]; a < adjacencyOffsets[fan + 1]; ++a) {
+            std::uint32_t triangle = adjacency[a];
+            if (emitted[triangle])
+                continue;
+
+            for (std::uint32_t j = 0; j < 3; ++j) {
+                std::uint32_t v = pIndices[triangle * 3 + j];
+                output.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                --liveCounts[v];
+                if (time - cacheTimes[v] > cacheSize) {
+                    cacheTimes[v] = time;
+                    ++time;
+                }
+            }
+            emitted[triangle] = 1;
+        }
+
+        // Picks the oldest vertex that is still in the cache after emitting its remaining triangles.
+        // Vertices that would miss the cache are left to the dead-end search below.
+        std::int64_t next = -1;
+        std::int64_t bestPriority = 0;
+        for (std::uint32_t v : candidates) {
+            if (liveCounts[v] == 0)
+                continue;
+
+            std::int64_t priority = 0;
+            if (time - cacheTimes[v] + 2 * liveCounts[v] <= cacheSize)
+                priority = time - cacheTimes[v];
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        if (next < 0) {
+            // Dead end, continues with the most recent vertex that still has triangles or the next one in order.
+            while (!deadEnds.empty() && next < 0) {
+                std::uint32_t v = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveCounts[v] > 0)
+                    next = v;
+            }
+            while (next < 0 && cursor < numVertices) {
+                if (liveCounts[cursor] > 0)
+                    next = cursor;
+                ++cursor;
+            }
+
+            std::uint32_t numEmitted = output.size() / 3;
+            if (pClusterStarts && next >= 0 && (pClusterStarts->empty() || pClusterStarts->back() != numEmitted))
+                pClusterStarts->push_back(numEmitted);
+        }
+        fan = next;
+    }
+
+    if (pClusterStarts && (pClusterStarts->empty() || pClusterStarts->front() != 0))
+        pClusterStarts->insert(pClusterStarts->begin(), 0);
+
+    std::copy(output.begin(), output.end(), pIndices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(
+        std::uint32_t* pIndices,
+        std::uint32_t numIndices,
+        const std::vector<std::uint32_t>& clusterStarts,
+        const void* pVertices,
+        std::uint32_t vertexSizeInBytes)
+{
+    std::uint32_t numTriangles = numIndices / 3;
+    if (clusterStarts.size() < 2 || numTriangles == 0)
+        return;
+
+    auto pBytes = reinterpret_cast<const std::uint8_t*>(pVertices);
+    auto loadPosition = [pBytes, vertexSizeInBytes](std::uint32_t index) {
+        DirectX::XMFLOAT3 position;
+        memcpy(&position, pBytes + static_cast<std::uint64_t>(index) * vertexSizeInBytes, sizeof(DirectX::XMFLOAT3));
+        return DirectX::XMLoadFloat3(&position);
+    };
+
+    // Area weighted centroid and normal of every cluster, the cross product is twice the area times the normal.
+    std::uint32_t numClusters = clusterStarts.size();
+    std::vector<DirectX::XMFLOAT3> centroids(numClusters);
+    std::vector<DirectX::XMFLOAT3> normals(numClusters);
+    DirectX::XMVECTOR meshCentroid = DirectX::XMVectorZero();
+    float meshArea = 0.f;
+    for (std::uint32_t c = 0; c < numClusters; ++c) {
+        std::uint32_t end = c + 1 < numClusters ? clusterStarts[c + 1] : numTriangles;
+        DirectX::XMVECTOR centroid = DirectX::XMVectorZero();
+        DirectX::XMVECTOR normal = DirectX::XMVectorZero();
+        float area = 0.f;
+        for (std::uint32_t t = clusterStarts[c]; t < end; ++t) {
+            DirectX::XMVECTOR P0 = loadPosition(pIndices[t * 3]);
+            DirectX::XMVECTOR P1 = loadPosition(pIndices[t * 3 + 1]);
+            DirectX::XMVECTOR P2 = loadPosition(pIndices[t * 3 + 2]);
+
+            DirectX::XMVECTOR N = DirectX::XMVector3Cross(DirectX::XMVectorSubtract(P1, P0), DirectX::XMVectorSubtract(P2, P0));
+            float triangleArea = DirectX::XMVectorGetX(DirectX::XMVector3Length(N));
+            DirectX::XMVECTOR center = DirectX::XMVectorScale(DirectX::XMVectorAdd(DirectX::XMVectorAdd(P0, P1), P2), 1.f / 3.f);
+
+            centroid = DirectX::XMVectorMultiplyAdd(center, DirectX::XMVectorReplicate(triangleArea), centroid);
+            normal = DirectX::XMVectorAdd(normal, N);
+            area += triangleArea;
+        }
+
+        meshCentroid = DirectX::XMVectorAdd(meshCentroid, centroid);
+        meshArea += area;
+        DirectX::XMStoreFloat3(&centroids[c], area > 0.f ? DirectX::XMVectorScale(centroid, 1.f / area) : centroid);
+        DirectX::XMStoreFloat3(&normals[c], DirectX::XMVector3Normalize(normal));
+    }
+    if (meshArea <= 0.f)
+        return;
+    meshCentroid = DirectX::XMVectorScale(meshCentroid, 1.f / meshArea);
+
+    // Clusters that face outwards are likely to occlude the others.
+    std::vector<float> occlusion(numClusters);
+    for (std::uint32_t c = 0; c < numClusters; ++c) {
+        DirectX::XMVECTOR offset = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&centroids[c]), meshCentroid);
+        occlusion[c] = DirectX::XMVectorGetX(DirectX::XMVector3Dot(offset, DirectX::XMLoadFloat3(&normals[c])));
+    }
+    std::vector<std::uint32_t> order(numClusters);
+    for (std::uint32_t c = 0; c < numClusters; ++c) {
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&occlusion](std::uint32_t a, std::uint32_t b) { return occlusion[a] > occlusion[b]; });
+
+    std::vector<std::uint32_t> output;
+    output.reserve(numIndices);
+    for (std::uint32_t c : order) {
+        std::uint32_t end = c + 1 < numClusters ? clusterStarts[c + 1] : numTriangles;
+        output.insert(output.end(), pIndices + clusterStarts[c] * 3, pIndices + end * 3);
+    }
+    std::copy(output.begin(), output.end(), pIndices);
+}
@@ -1,6 +1,9 @@
 #include "RoX/Model.h"
+#include "RoX/MeshOptimizer.h"
 
 #include "../Util/pch.h"
+#include "../FileFormats/BufferCodec.h"
+#include "../Util/ThreadPool.h"
 
 // ---------------------------------------------------------------- //
 //                          Bone
@@ -28,6 +31,93 @@ void Bone::SetParentIndex(std::uint32_t index) noexcept {
     m_parentIndex = index;
 }
 
+// ---------------------------------------------------------------- //
+//                          Skeleton
+// ---------------------------------------------------------------- //
+
+Skeleton::Skeleton(const std::vector<Bone>& bones) {
+    if (bones.size() > MAX_BONES)
+        throw std::invalid_argument("Skeleton can hold at most " + std::to_string(MAX_BONES) + " bones.");
+
+    std::uint32_t numBones = bones.size();
+
+    // Children of every bone stored contiguously, in the order of the bones.
+    std::vector<std::uint32_t> childOffsets(numBones + 1, 0);
+    for (const Bone& bone : bones) {
+        if (bone.IsRoot())
+            continue;
+        if (bone.GetParentIndex() >= numBones)
+            throw std::invalid_argument("Bone '" + bone.GetName() + "' has parent index " + std::to_string(bone.GetParentIndex()) + " which is out of range.");
+
+        ++childOffsets[bone.GetParentIndex() + 1];
+    }
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        childOffsets[i + 1] += childOffsets[i];
+    }
+    std::vector<std::uint32_t> children(childOffsets.back());
+    std::vector<std::uint32_t> numChildren(numBones, 0);
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        if (bones[i].IsRoot())
+            continue;
+
+        std::uint32_t parentIndex = bones[i].GetParentIndex();
+        children[childOffsets[parentIndex] + numChildren[parentIndex]++] = i;
+    }
+
+    m_order.reserve(numBones);
+    m_parentSlots.reserve(numBones);
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        if (bones[i].IsRoot()) {
+            m_order.push_back(i);
+            m_parentSlots.push_back(0);
+        }
+    }
+
+    std::uint32_t levelBegin = 0;
+    while (levelBegin < m_order.size()) {
+        std::uint32_t levelEnd = m_order.size();
+        m_levelOffsets.push_back(levelBegin);
+
+        for (std::uint32_t position = levelBegin; position < levelEnd; ++position) {
+            std::uint32_t boneIndex = m_order[position];
+            for (std::uint32_t i = childOffsets[boneIndex]; i < childOffsets[boneIndex + 1]; ++i) {
+                m_order.push_back(children[i]);
+                m_parentSlots.push_back(position + 1);
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    m_levelOffsets.push_back(m_order.size());
+
+    // Bones in a cycle are never reached from a root.
+    if (m_order.size() != numBones)
+        throw std::invalid_argument("Bone hierarchy contains a cycle.");
+}
+
+const std::vector<std::uint16_t>& Skeleton::GetOrder() const noexcept {
+    return m_order;
+}
+
+const std::vector<std::uint16_t>& Skeleton::GetParentSlots() const noexcept {
+    return m_parentSlots;
+}
+
+const std::vector<std::uint32_t>& Skeleton::GetLevelOffsets() const noexcept {
+    return m_levelOffsets;
+}
+
+std::uint32_t Skeleton::GetNumBones() const noexcept {
+    return m_order.size();
+}
+
+std::uint32_t Skeleton::GetNumLevels() const noexcept {
+    return m_levelOffsets.empty() ? 0 : m_levelOffsets.size() - 1;
+}
+
+std::uint32_t Skeleton::GetNumRoots() const noexcept {
+    return m_levelOffsets.size() < 2 ? 0 : m_levelOffsets[1];
+}
+
 // ---------------------------------------------------------------- //
 //                          Submesh
 // ---------------------------------------------------------------- //
@@ -44,6 +134,8 @@ Submesh::Submesh(std::string name, std::uint32_t materialIndex, bool visible)
     m_indexCount(0),
     m_startIndex(0),
     m_vertexOffset(0),
+    m_boundingBox({ 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f }),
+    m_boundingSphere({ 0.f, 0.f, 0.f }, 0.f),
     m_visible(visible)
 {}
 
@@ -83,6 +175,14 @@ std::shared_ptr<Material> Submesh::GetMaterial(Model& grandParent) const {
     return grandParent.GetMaterials()[m_materialIndex];
 }
 
+const DirectX::BoundingBox& Submesh::GetBoundingBox() const noexcept {
+    return m_boundingBox;
+}
+
+const DirectX::BoundingSphere& Submesh::GetBoundingSphere() const noexcept {
+    return m_boundingSphere;
+}
+
 bool Submesh::IsVisible() const noexcept {
     return m_visible;
 }
@@ -109,22 +209,65 @@ void Submesh::SetVertexOffset(std::uint32_t offset) noexcept {
     m_vertexOffset = offset;
 }
 
+void Submesh::SetBounds(const DirectX::BoundingBox& box, const DirectX::BoundingSphere& sphere) noexcept {
+    m_boundingBox = box;
+    m_boundingSphere = sphere;
+}
+
 void Submesh::SetVisible(bool visible) noexcept {
     m_visible = visible;
 }
 
+// ---------------------------------------------------------------- //
+//                          Bounds
+// ---------------------------------------------------------------- //
+
+// Merges the bounds of the submeshes that draw at least one index into **box** and **sphere**, which are overwritten when **isEmpty**.
+// Returns whether **box** and **sphere** hold any bounds afterwards.
+bool MergeSubmeshBounds(const std::vector<std::unique_ptr<Submesh>>& submeshes, bool isEmpty, DirectX::BoundingBox& box, DirectX::BoundingSphere& sphere) noexcept {
+    for (const std::unique_ptr<Submesh>& pSubmesh : submeshes) {
+        if (pSubmesh->GetIndexCount() == 0)
+            continue;
+
+        if (isEmpty) {
+            box = pSubmesh->GetBoundingBox();
+            sphere = pSubmesh->GetBoundingSphere();
+            isEmpty = false;
+        } else {
+            DirectX::BoundingBox::CreateMerged(box, box, pSubmesh->GetBoundingBox());
+            DirectX::BoundingSphere::CreateMerged(sphere, sphere, pSubmesh->GetBoundingSphere());
+        }
+    }
+    return !isEmpty;
+}
+
+void ClearBounds(DirectX::BoundingBox& box, DirectX::BoundingSphere& sphere) noexcept {
+    box = DirectX::BoundingBox({ 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f });
+    sphere = DirectX::BoundingSphere({ 0.f, 0.f, 0.f }, 0.f);
+}
+
 // ---------------------------------------------------------------- //
 //                          BaseMesh
 // ---------------------------------------------------------------- //
 
 BaseMesh::BaseMesh(std::string name, bool useStaticBuffers, bool visible) 
     noexcept : Identifiable("mesh", name),
+    m_numDeferredIndices(0),
+    m_numDeferredVertices(0),
+    m_residency(GeometryResidency::KeepCPUCopy),
+    m_geometryUploaded(false),
+    m_geometryReleased(false),
     m_boneIndex(Bone::INVALID_INDEX),
+    m_indexSizeInBytes(sizeof(std::uint16_t)),
+    m_boundingBox({ 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f }),
+    m_boundingSphere({ 0.f, 0.f, 0.f }, 0.f),
     m_usingStaticBuffers(useStaticBuffers),
     m_visible(visible)
 {}
 
 void BaseMesh::UseStaticBuffers(bool useStaticBuffers) {
+    // The observers may drop the copy the released geometry would be restored from.
+    RestoreGeometry();
     m_usingStaticBuffers = useStaticBuffers;
 
     for (IMeshObserver* pIMeshObserver : m_iMeshObservers) {
@@ -134,10 +277,331 @@ void BaseMesh::UseStaticBuffers(bool useStaticBuffers) {
 }
 
 void BaseMesh::UpdateBuffers() {
+    if (m_geometryLoader) {
+        // Cleared first so the loader sees the mesh as resident, it is put back when loading fails.
+        GeometryLoader loader = std::move(m_geometryLoader);
+        m_geometryLoader = nullptr;
+        try {
+            loader(*this);
+        } catch (...) {
+            ClearGeometry();
+            m_geometryLoader = std::move(loader);
+            throw;
+        }
+    }
+    RestoreGeometry();
+    // The compressed copy no longer matches the geometry being uploaded.
+    std::vector<std::uint8_t>().swap(m_compressedIndices);
+    std::vector<std::uint8_t>().swap(m_compressedVertices);
+
     for (IMeshObserver* pIMeshObserver : m_iMeshObservers) {
         if (pIMeshObserver)
             pIMeshObserver->OnUpdateBuffers(this);
     }
+
+    // Only released once every observer has its copy.
+    if (!m_iMeshObservers.empty())
+        ApplyResidency();
+}
+
+void BaseMesh::DeferGeometry(GeometryLoader loader, std::uint32_t numIndices, std::uint32_t numVertices) {
+    if (!loader)
+        throw std::invalid_argument("GeometryLoader is empty.");
+
+    ClearGeometry();
+    m_geometryReleased = false;
+    std::vector<std::uint8_t>().swap(m_compressedIndices);
+    std::vector<std::uint8_t>().swap(m_compressedVertices);
+
+    m_geometryLoader = std::move(loader);
+    m_numDeferredIndices = numIndices;
+    m_numDeferredVertices = numVertices;
+}
+
+void BaseMesh::RequireGeometry() {
+    if (m_geometryLoader)
+        UpdateBuffers();
+}
+
+void BaseMesh::ApplyResidency() {
+    m_geometryUploaded = true;
+    if (m_residency == GeometryResidency::KeepCPUCopy || !HasGeometry())
+        return;
+
+    // Dynamic buffers are rewritten on every update and kept on the CPU by the renderer, compressing them would only cost time.
+    if (!m_usingStaticBuffers) {
+        std::vector<std::uint8_t>().swap(m_compressedIndices);
+        std::vector<std::uint8_t>().swap(m_compressedVertices);
+    } else if (m_residency == GeometryResidency::KeepCompressedCopy && m_compressedVertices.empty()) {
+        m_compressedIndices = BufferCodec::EncodeIndices(GetIndexData(), GetNumIndices(), m_indexSizeInBytes);
+        m_compressedVertices = BufferCodec::EncodeVertices(GetVertexData(), GetNumVertices(), GetVertexSizeInBytes());
+    }
+
+    m_numDeferredIndices = GetNumIndices();
+    m_numDeferredVertices = GetNumVertices();
+    ClearGeometry();
+    m_geometryReleased = true;
+}
+
+void BaseMesh::RestoreGeometry() {
+    if (!m_geometryReleased)
+        return;
+
+    m_geometryReleased = false;
+    if (m_residency == GeometryResidency::KeepCompressedCopy && !m_compressedVertices.empty()) {
+        ResizeIndices(m_numDeferredIndices);
+        BufferCodec::DecodeIndices(GetIndexData(), m_numDeferredIndices, m_indexSizeInBytes, m_compressedIndices.data(), m_compressedIndices.size());
+        ResizeVertices(m_numDeferredVertices);
+        BufferCodec::DecodeVertices(GetVertexData(), m_numDeferredVertices, GetVertexSizeInBytes(), m_compressedVertices.data(), m_compressedVertices.size());
+        return;
+    }
+
+    RebuildFromBuffers();
+    if (GetNumIndices() != m_numDeferredIndices || GetNumVertices() != m_numDeferredVertices) {
+        ClearGeometry();
+        m_geometryReleased = true;
+        throw std::runtime_error("Mesh '" + GetName() + "' has no copy left to restore its geometry from.");
+    }
+}
+
+MeshOptimizerStats BaseMesh::Optimize(const MeshOptimizerSettings& settings) {
+    RequireGeometry();
+    RestoreGeometry();
+
+    // The building blocks work on 32-bit indices, stored back at the index size of the mesh once optimized.
+    std::vector<std::uint32_t> indices = WidenIndices();
+
+    struct Range {
+        std::uint32_t StartIndex;
+        std::uint32_t IndexCount;
+        std::uint32_t VertexOffset;
+    };
+
+    // Index ranges drawn by the submeshes in the order they appear in the index buffer, a mesh without submeshes is a single range.
+    std::vector<Range> ranges;
+    for (std::unique_ptr<Submesh>& pSubmesh : m_submeshes) {
+        if (pSubmesh->GetIndexCount() > 0)
+            ranges.push_back({ pSubmesh->GetStartIndex(), pSubmesh->GetIndexCount(), pSubmesh->GetVertexOffset() });
+    }
+    if (m_submeshes.empty() && !indices.empty())
+        ranges.push_back({ 0, static_cast<std::uint32_t>(indices.size()), 0 });
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+        return std::tie(a.StartIndex, a.IndexCount, a.VertexOffset) < std::tie(b.StartIndex, b.IndexCount, b.VertexOffset);
+    });
+    ranges.erase(std::unique(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+        return a.StartIndex == b.StartIndex && a.IndexCount == b.IndexCount && a.VertexOffset == b.VertexOffset;
+    }), ranges.end());
+
+    std::uint32_t numVertices = GetNumVertices();
+    std::uint32_t vertexSizeInBytes = GetVertexSizeInBytes();
+
+    MeshOptimizerStats stats;
+    stats.NumVerticesBefore = numVertices;
+    stats.NumVerticesAfter = numVertices;
+
+    bool isDisjoint = true;
+    std::uint64_t numCovered = 0;
+    for (std::uint32_t i = 0; i < ranges.size(); ++i) {
+        if (static_cast<std::uint64_t>(ranges[i].StartIndex) + ranges[i].IndexCount > indices.size())
+            return stats;
+        if (i > 0 && ranges[i].StartIndex < ranges[i - 1].StartIndex + ranges[i - 1].IndexCount)
+            isDisjoint = false;
+        if (ranges[i].IndexCount % 3 != 0)
+            isDisjoint = false;
+        numCovered += ranges[i].IndexCount;
+    }
+
+    auto computeACMR = [&]() {
+        double numTransformed = 0.0;
+        std::uint64_t numTriangles = 0;
+        for (const Range& range : ranges) {
+            numTransformed += MeshOptimizer::ComputeACMR(&indices[range.StartIndex], range.IndexCount, settings.CacheSize) * (range.IndexCount / 3);
+            numTriangles += range.IndexCount / 3;
+        }
+        return numTriangles ? static_cast<float>(numTransformed / numTriangles) : 0.f;
+    };
+    stats.ACMRBefore = computeACMR();
+    stats.ACMRAfter = stats.ACMRBefore;
+    if (!isDisjoint)
+        return stats;
+
+    // Every distinct vertex offset starts a region that ends at the next one, vertices only move within their region.
+    std::vector<std::uint32_t> regionStarts = { 0 };
+    for (std::unique_ptr<Submesh>& pSubmesh : m_submeshes) {
+        regionStarts.push_back(pSubmesh->GetVertexOffset());
+    }
+    std::sort(regionStarts.begin(), regionStarts.end());
+    regionStarts.erase(std::unique(regionStarts.begin(), regionStarts.end()), regionStarts.end());
+    auto findRegion = [&regionStarts](std::uint32_t vertexOffset) {
+        return static_cast<std::uint32_t>(std::lower_bound(regionStarts.begin(), regionStarts.end(), vertexOffset) - regionStarts.begin());
+    };
+    auto getRegionEnd = [&regionStarts, numVertices](std::uint32_t region) {
+        return region + 1 < regionStarts.size() ? regionStarts[region + 1] : numVertices;
+    };
+
+    bool canMoveVertices = numCovered == indices.size() && regionStarts.back() <= numVertices;
+    std::vector<bool> isInBounds(ranges.size());
+    for (std::uint32_t i = 0; i < ranges.size(); ++i) {
+        const Range& range = ranges[i];
+        std::uint32_t maxIndex = *std::max_element(indices.begin() + range.StartIndex, indices.begin() + range.StartIndex + range.IndexCount);
+        isInBounds[i] = static_cast<std::uint64_t>(range.VertexOffset) + maxIndex < numVertices;
+        if (static_cast<std::uint64_t>(range.VertexOffset) + maxIndex >= getRegionEnd(findRegion(range.VertexOffset)))
+            canMoveVertices = false;
+    }
+
+    // Indices of identical vertices point to the first of them, the others are dropped when the vertices are reordered.
+    auto pVertices = static_cast<const std::uint8_t*>(GetVertexData());
+    std::vector<std::uint32_t> canonical(numVertices);
+    for (std::uint32_t v = 0; v < numVertices; ++v) {
+        canonical[v] = v;
+    }
+    if (settings.DeduplicateVertices && canMoveVertices) {
+        for (std::uint32_t region = 0; region < regionStarts.size(); ++region) {
+            std::vector<std::uint32_t> sorted;
+            for (std::uint32_t v = regionStarts[region]; v < getRegionEnd(region); ++v) {
+                sorted.push_back(v);
+            }
+            std::sort(sorted.begin(), sorted.end(), [pVertices, vertexSizeInBytes](std::uint32_t a, std::uint32_t b) {
+                int order = memcmp(pVertices + static_cast<std::uint64_t>(a) * vertexSizeInBytes, pVertices + static_cast<std::uint64_t>(b) * vertexSizeInBytes, vertexSizeInBytes);
+                return order != 0 ? order < 0 : a < b;
+            });
+            for (std::uint32_t i = 1; i < sorted.size(); ++i) {
+                if (memcmp(pVertices + static_cast<std::uint64_t>(sorted[i]) * vertexSizeInBytes, pVertices + static_cast<std::uint64_t>(sorted[i - 1]) * vertexSizeInBytes, vertexSizeInBytes) == 0)
+                    canonical[sorted[i]] = canonical[sorted[i - 1]];
+            }
+        }
+        for (const Range& range : ranges) {
+            for (std::uint32_t i = range.StartIndex; i < range.StartIndex + range.IndexCount; ++i) {
+                indices[i] = canonical[range.VertexOffset + indices[i]] - range.VertexOffset;
+            }
+        }
+    }
+
+    for (std::uint32_t i = 0; i < ranges.size(); ++i) {
+        const Range& range = ranges[i];
+        std::vector<std::uint32_t> clusterStarts;
+        bool reduceOverdraw = settings.ReduceOverdraw && isInBounds[i];
+        MeshOptimizer::OptimizeTriangleOrder(&indices[range.StartIndex], range.IndexCount, settings.CacheSize, reduceOverdraw ? &clusterStarts : nullptr);
+        if (reduceOverdraw)
+            MeshOptimizer::OptimizeOverdraw(&indices[range.StartIndex], range.IndexCount, clusterStarts, pVertices + static_cast<std::uint64_t>(range.VertexOffset) * vertexSizeInBytes, vertexSizeInBytes);
+    }
+
+    if (canMoveVertices) {
+        // Vertices are stored in the order the triangles first use them, unused vertices stay at the end of their region.
+        std::vector<std::uint32_t> remap(numVertices, UINT32_MAX);
+        std::vector<std::uint32_t> newRegionStarts(regionStarts.size());
+        std::uint32_t numNewVertices = 0;
+        for (std::uint32_t region = 0; region < regionStarts.size(); ++region) {
+            newRegionStarts[region] = numNewVertices;
+            for (const Range& range : ranges) {
+                if (range.VertexOffset != regionStarts[region])
+                    continue;
+
+                for (std::uint32_t i = range.StartIndex; i < range.StartIndex + range.IndexCount; ++i) {
+                    std::uint32_t v = range.VertexOffset + indices[i];
+                    if (remap[v] == UINT32_MAX)
+                        remap[v] = numNewVertices++;
+                    indices[i] = remap[v] - newRegionStarts[region];
+                }
+            }
+            for (std::uint32_t v = regionStarts[region]; v < getRegionEnd(region); ++v) {
+                if (remap[v] == UINT32_MAX && canonical[v] == v)
+                    remap[v] = numNewVertices++;
+            }
+        }
+
+        std::vector<std::uint8_t> newVertices(static_cast<std::uint64_t>(numNewVertices) * vertexSizeInBytes);
+        for (std::uint32_t v = 0; v < numVertices; ++v) {
+            if (remap[v] != UINT32_MAX)
+                memcpy(newVertices.data() + static_cast<std::uint64_t>(remap[v]) * vertexSizeInBytes, pVertices + static_cast<std::uint64_t>(v) * vertexSizeInBytes, vertexSizeInBytes);
+        }
+        ResizeVertices(numNewVertices);
+        if (numNewVertices)
+            memcpy(GetVertexData(), newVertices.data(), newVertices.size());
+
+        for (std::unique_ptr<Submesh>& pSubmesh : m_submeshes) {
+            pSubmesh->SetVertexOffset(newRegionStarts[findRegion(pSubmesh->GetVertexOffset())]);
+        }
+        stats.NumVerticesAfter = numNewVertices;
+    }
+
+    stats.ACMRAfter = computeACMR();
+    StoreIndices(std::move(indices));
+    return stats;
+}
+
+void BaseMesh::UpdateBounds(Submesh& submesh) noexcept {
+    if (!HasGeometry())
+        return;
+
+    auto pVertices = static_cast<const std::uint8_t*>(GetVertexData());
+    std::uint64_t vertexSizeInBytes = GetVertexSizeInBytes();
+    std::uint64_t numVertices = GetNumVertices();
+    std::uint64_t start = std::min<std::uint64_t>(submesh.GetStartIndex(), GetNumIndices());
+    std::uint64_t end = std::min<std::uint64_t>(start + submesh.GetIndexCount(), GetNumIndices());
+
+    // Every vertex starts with its position, indices outside the vertices are skipped.
+    auto forEachIndexedPosition = [&](const auto& indices, auto function) {
+        for (std::uint64_t i = start; i < end; ++i) {
+            std::uint64_t vertex = static_cast<std::uint64_t>(submesh.GetVertexOffset()) + indices[i];
+            if (vertex < numVertices)
+                function(DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(pVertices + vertex * vertexSizeInBytes)));
+        }
+    };
+    auto forEachPosition = [&](auto function) {
+        if (m_indexSizeInBytes == sizeof(std::uint16_t))
+            forEachIndexedPosition(m_indices, function);
+        else
+            forEachIndexedPosition(m_wideIndices, function);
+    };
+
+    DirectX::XMVECTOR minimum = DirectX::g_XMFltMax;
+    DirectX::XMVECTOR maximum = DirectX::XMVectorNegate(DirectX::g_XMFltMax);
+    bool isEmpty = true;
+    forEachPosition([&](DirectX::FXMVECTOR P) {
+        minimum = DirectX::XMVectorMin(minimum, P);
+        maximum = DirectX::XMVectorMax(maximum, P);
+        isEmpty = false;
+    });
+
+    DirectX::BoundingBox box;
+    DirectX::BoundingSphere sphere;
+    if (isEmpty) {
+        ClearBounds(box, sphere);
+    } else {
+        DirectX::BoundingBox::CreateFromPoints(box, minimum, maximum);
+
+        // Centered on the box, which is never larger than the sphere around the box and needs no iterations.
+        DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&box.Center);
+        DirectX::XMVECTOR radiusSquared = DirectX::XMVectorZero();
+        forEachPosition([&](DirectX::FXMVECTOR P) {
+            radiusSquared = DirectX::XMVectorMax(radiusSquared, DirectX::XMVector3LengthSq(DirectX::XMVectorSubtract(P, center)));
+        });
+        sphere.Center = box.Center;
+        sphere.Radius = DirectX::XMVectorGetX(DirectX::XMVectorSqrt(radiusSquared));
+    }
+    submesh.SetBounds(box, sphere);
+
+    MergeBounds();
+}
+
+void BaseMesh::UpdateBounds() noexcept {
+    for (std::unique_ptr<Submesh>& pSubmesh : m_submeshes) {
+        UpdateBounds(*pSubmesh);
+    }
+}
+
+void BaseMesh::MergeBounds() noexcept {
+    if (!MergeSubmeshBounds(m_submeshes, true, m_boundingBox, m_boundingSphere))
+        ClearBounds(m_boundingBox, m_boundingSphere);
+}
+
+void BaseMesh::AppendIndices(const std::uint16_t* pIndices, std::uint64_t numIndices) {
+    AppendIndexArray(pIndices, numIndices);
+}
+
+void BaseMesh::AppendIndices(const std::uint32_t* pIndices, std::uint64_t numIndices) {
+    AppendIndexArray(pIndices, numIndices);
 }
 
 void BaseMesh::Add(std::unique_ptr<Submesh> pSubmesh) {
@@ -145,6 +609,7 @@ void BaseMesh::Add(std::unique_ptr<Submesh> pSubmesh) {
         throw std::invalid_argument("Submesh is nullptr");
 
     m_submeshes.push_back(std::move(pSubmesh));
+    MergeBounds();
 
     for (IMeshObserver* pIMeshObserver : m_iMeshObservers) {
         if (pIMeshObserver)
@@ -161,6 +626,7 @@ void BaseMesh::RemoveSubmesh(std::uint8_t index) {
             pIMeshObserver->OnRemoveSubmesh(index);
     }
     m_submeshes.erase(m_submeshes.begin() + index);
+    MergeBounds();
 }
 
 void BaseMesh::Attach(IMeshObserver* pIMeshObserver) {
@@ -194,7 +660,9 @@ std::uint32_t BaseMesh::GetNumSubmeshes() const noexcept {
 }
 
 std::uint32_t BaseMesh::GetNumIndices() const noexcept {
-    return m_indices.size();
+    if (!HasGeometry())
+        return m_numDeferredIndices;
+    return m_indexSizeInBytes == sizeof(std::uint16_t) ? m_indices.size() : m_wideIndices.size();
 }
 
 std::vector<std::uint32_t>& BaseMesh::GetBoneInfluences() noexcept {
@@ -209,6 +677,42 @@ std::vector<std::uint16_t>& BaseMesh::GetIndices() noexcept {
     return m_indices;
 }
 
+std::vector<std::uint32_t>& BaseMesh::GetWideIndices() noexcept {
+    return m_wideIndices;
+}
+
+const DirectX::BoundingBox& BaseMesh::GetBoundingBox() const noexcept {
+    return m_boundingBox;
+}
+
+const DirectX::BoundingSphere& BaseMesh::GetBoundingSphere() const noexcept {
+    return m_boundingSphere;
+}
+
+std::uint32_t BaseMesh::GetIndexSizeInBytes() const noexcept {
+    return m_indexSizeInBytes;
+}
+
+GeometryResidency BaseMesh::GetResidency() const noexcept {
+    return m_residency;
+}
+
+std::uint64_t BaseMesh::GetGeometrySizeInBytes() const noexcept {
+    std::uint64_t numVertices = HasGeometry() ? GetNumVertices() : 0;
+    return m_indices.size() * sizeof(std::uint16_t) + m_wideIndices.size() * sizeof(std::uint32_t) + numVertices * GetVertexSizeInBytes()
+        + m_compressedIndices.size() + m_compressedVertices.size();
+}
+
+std::uint64_t BaseMesh::GetResidencySavingsInBytes() const noexcept {
+    if (!m_geometryReleased)
+        return 0;
+
+    std::uint64_t sizeInBytes = static_cast<std::uint64_t>(m_numDeferredIndices) * m_indexSizeInBytes
+        + static_cast<std::uint64_t>(m_numDeferredVertices) * GetVertexSizeInBytes();
+    std::uint64_t residentSizeInBytes = GetGeometrySizeInBytes();
+    return sizeInBytes > residentSizeInBytes ? sizeInBytes - residentSizeInBytes : 0;
+}
+
 bool BaseMesh::IsUsingStaticBuffers() const noexcept {
     return m_usingStaticBuffers;
 }
@@ -217,18 +721,327 @@ bool BaseMesh::IsVisible() const noexcept {
     return m_visible;
 }
 
+bool BaseMesh::IsGeometryResident() const noexcept {
+    return !m_geometryLoader;
+}
+
+bool BaseMesh::IsGeometryReleased() const noexcept {
+    return m_geometryReleased;
+}
+
 void BaseMesh::SetName(std::string name) noexcept {
     Identifiable::SetName(name);
 }
 
+void BaseMesh::SetResidency(GeometryResidency residency) {
+    RestoreGeometry();
+    m_residency = residency;
+    if (m_residency != GeometryResidency::KeepCompressedCopy) {
+        std::vector<std::uint8_t>().swap(m_compressedIndices);
+        std::vector<std::uint8_t>().swap(m_compressedVertices);
+    }
+
+    for (IMeshObserver* pIMeshObserver : m_iMeshObservers) {
+        if (pIMeshObserver)
+            pIMeshObserver->OnSetResidency(this, residency);
+    }
+
+    if (m_geometryUploaded)
+        ApplyResidency();
+}
+
 void BaseMesh::SetBoneIndex(std::uint32_t boneIndex) noexcept {
     m_boneIndex = boneIndex;
 }
 
+void BaseMesh::SetIndexSizeInBytes(std::uint32_t size) {
+    if (size != sizeof(std::uint16_t) && size != sizeof(std::uint32_t))
+        throw std::invalid_argument("Unsupported index size: " + std::to_string(size));
+    if (size == m_indexSizeInBytes)
+        return;
+
+    RequireGeometry();
+    RestoreGeometry();
+    // 0xFFFF is reserved as the strip cut value.
+    if (size == sizeof(std::uint16_t) && std::any_of(m_wideIndices.begin(), m_wideIndices.end(), [](std::uint32_t index) { return index >= USHRT_MAX; }))
+        throw std::invalid_argument("Mesh '" + GetName() + "' has indices that do not fit in 16 bits.");
+    ConvertIndices(size);
+}
+
+void BaseMesh::SelectIndexSize() noexcept {
+    // The compressed copy is decoded at the index size it was encoded with.
+    if (!HasGeometry())
+        return;
+
+    // Indices are relative to the vertex offset of their submesh, so the largest index decides and not the vertex count.
+    // 0xFFFF is reserved as the strip cut value.
+    std::uint32_t maxIndex = 0;
+    if (m_indexSizeInBytes == sizeof(std::uint16_t))
+        maxIndex = m_indices.empty() ? 0 : *std::max_element(m_indices.begin(), m_indices.end());
+    else
+        maxIndex = m_wideIndices.empty() ? 0 : *std::max_element(m_wideIndices.begin(), m_wideIndices.end());
+    ConvertIndices(maxIndex < USHRT_MAX ? sizeof(std::uint16_t) : sizeof(std::uint32_t));
+}
+
 void BaseMesh::SetVisible(bool visible) noexcept {
     m_visible = visible;
 }
 
+bool BaseMesh::HasGeometry() const noexcept {
+    return !m_geometryLoader && !m_geometryReleased;
+}
+
+template<typename Index>
+void BaseMesh::AppendIndexArray(const Index* pIndices, std::uint64_t numIndices) {
+    RequireGeometry();
+    RestoreGeometry();
+
+    if (m_indexSizeInBytes == sizeof(std::uint16_t) && std::any_of(pIndices, pIndices + numIndices, [](Index index) { return index >= USHRT_MAX; }))
+        ConvertIndices(sizeof(std::uint32_t));
+
+    if (m_indexSizeInBytes == sizeof(std::uint16_t)) {
+        m_indices.reserve(m_indices.size() + numIndices);
+        for (std::uint64_t i = 0; i < numIndices; ++i) {
+            m_indices.push_back(static_cast<std::uint16_t>(pIndices[i]));
+        }
+    } else {
+        m_wideIndices.insert(m_wideIndices.end(), pIndices, pIndices + numIndices);
+    }
+}
+
+void BaseMesh::ConvertIndices(std::uint32_t size) {
+    if (size == m_indexSizeInBytes)
+        return;
+
+    if (size == sizeof(std::uint32_t)) {
+        m_wideIndices.assign(m_indices.begin(), m_indices.end());
+        std::vector<std::uint16_t>().swap(m_indices);
+    } else {
+        m_indices.resize(m_wideIndices.size());
+        for (std::uint64_t i = 0; i < m_wideIndices.size(); ++i) {
+            m_indices[i] = static_cast<std::uint16_t>(m_wideIndices[i]);
+        }
+        std::vector<std::uint32_t>().swap(m_wideIndices);
+    }
+    m_indexSizeInBytes = size;
+}
+
+std::vector<std::uint32_t> BaseMesh::WidenIndices() const {
+    if (m_indexSizeInBytes == sizeof(std::uint32_t))
+        return m_wideIndices;
+    return std::vector<std::uint32_t>(m_indices.begin(), m_indices.end());
+}
+
+void BaseMesh::StoreIndices(std::vector<std::uint32_t> indices) {
+    if (m_indexSizeInBytes == sizeof(std::uint16_t) && std::all_of(indices.begin(), indices.end(), [](std::uint32_t index) { return index < USHRT_MAX; })) {
+        m_indices.assign(indices.begin(), indices.end());
+        return;
+    }
+
+    std::vector<std::uint16_t>().swap(m_indices);
+    m_wideIndices = std::move(indices);
+    m_indexSizeInBytes = sizeof(std::uint32_t);
+}
+
+void* BaseMesh::GetIndexData() noexcept {
+    return m_indexSizeInBytes == sizeof(std::uint16_t) ? static_cast<void*>(m_indices.data()) : static_cast<void*>(m_wideIndices.data());
+}
+
+void BaseMesh::ResizeIndices(std::uint32_t numIndices) {
+    if (m_indexSizeInBytes == sizeof(std::uint16_t))
+        m_indices.resize(numIndices);
+    else
+        m_wideIndices.resize(numIndices);
+}
+
+// ---------------------------------------------------------------- //
+//                          Vertex transforms
+// ---------------------------------------------------------------- //
+
+// Meshes with fewer vertices are transformed on the calling thread.
+constexpr std::uint32_t PARALLEL_TRANSFORM_THRESHOLD = 1 << 16;
+// Vertices per task when a mesh is split over the thread pool.
+constexpr std::uint32_t TRANSFORM_CHUNK_SIZE = 1 << 14;
+
+// Transforms the positions of **count** vertices by **M** and their normals by **N**, renormalizing the normals.
+// Vertices are handled 4 at a time: their positions and normals are transposed so every register holds
+// one component of 4 vertices, transformed with multiply-adds and transposed back.
+template<typename Vertex>
+void TransformVertexRange(Vertex* pVertices, std::uint32_t count, const DirectX::XMMATRIX& M, const DirectX::XMMATRIX& N) noexcept {
+    const DirectX::XMVECTOR M00 = DirectX::XMVectorSplatX(M.r[0]), M01 = DirectX::XMVectorSplatY(M.r[0]), M02 = DirectX::XMVectorSplatZ(M.r[0]);
+    const DirectX::XMVECTOR M10 = DirectX::XMVectorSplatX(M.r[1]), M11 = DirectX::XMVectorSplatY(M.r[1]), M12 = DirectX::XMVectorSplatZ(M.r[1]);
+    const DirectX::XMVECTOR M20 = DirectX::XMVectorSplatX(M.r[2]), M21 = DirectX::XMVectorSplatY(M.r[2]), M22 = DirectX::XMVectorSplatZ(M.r[2]);
+    const DirectX::XMVECTOR M30 = DirectX::XMVectorSplatX(M.r[3]), M31 = DirectX::XMVectorSplatY(M.r[3]), M32 = DirectX::XMVectorSplatZ(M.r[3]);
+
+    const DirectX::XMVECTOR N00 = DirectX::XMVectorSplatX(N.r[0]), N01 = DirectX::XMVectorSplatY(N.r[0]), N02 = DirectX::XMVectorSplatZ(N.r[0]);
+    const DirectX::XMVECTOR N10 = DirectX::XMVectorSplatX(N.r[1]), N11 = DirectX::XMVectorSplatY(N.r[1]), N12 = DirectX::XMVectorSplatZ(N.r[1]);
+    const DirectX::XMVECTOR N20 = DirectX::XMVectorSplatX(N.r[2]), N21 = DirectX::XMVectorSplatY(N.r[2]), N22 = DirectX::XMVectorSplatZ(N.r[2]);
+
+    const DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+
+    std::uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        Vertex* pBatch = pVertices + i;
+
+        // Row j of **P** and **Q** holds component j of the positions and normals.
+        DirectX::XMMATRIX P = DirectX::XMMatrixTranspose(DirectX::XMMATRIX(
+            DirectX::XMLoadFloat3(&pBatch[0].position), DirectX::XMLoadFloat3(&pBatch[1].position),
+            DirectX::XMLoadFloat3(&pBatch[2].position), DirectX::XMLoadFloat3(&pBatch[3].position)));
+        DirectX::XMMATRIX Q = DirectX::XMMatrixTranspose(DirectX::XMMATRIX(
+            DirectX::XMLoadFloat3(&pBatch[0].normal), DirectX::XMLoadFloat3(&pBatch[1].normal),
+            DirectX::XMLoadFloat3(&pBatch[2].normal), DirectX::XMLoadFloat3(&pBatch[3].normal)));
+
+        DirectX::XMVECTOR PX = DirectX::XMVectorMultiplyAdd(P.r[2], M20, DirectX::XMVectorMultiplyAdd(P.r[1], M10, DirectX::XMVectorMultiplyAdd(P.r[0], M00, M30)));
+        DirectX::XMVECTOR PY = DirectX::XMVectorMultiplyAdd(P.r[2], M21, DirectX::XMVectorMultiplyAdd(P.r[1], M11, DirectX::XMVectorMultiplyAdd(P.r[0], M01, M31)));
+        DirectX::XMVECTOR PZ = DirectX::XMVectorMultiplyAdd(P.r[2], M22, DirectX::XMVectorMultiplyAdd(P.r[1], M12, DirectX::XMVectorMultiplyAdd(P.r[0], M02, M32)));
+
+        DirectX::XMVECTOR NX = DirectX::XMVectorMultiplyAdd(Q.r[2], N20, DirectX::XMVectorMultiplyAdd(Q.r[1], N10, DirectX::XMVectorMultiply(Q.r[0], N00)));
+        DirectX::XMVECTOR NY = DirectX::XMVectorMultiplyAdd(Q.r[2], N21, DirectX::XMVectorMultiplyAdd(Q.r[1], N11, DirectX::XMVectorMultiply(Q.r[0], N01)));
+        DirectX::XMVECTOR NZ = DirectX::XMVectorMultiplyAdd(Q.r[2], N22, DirectX::XMVectorMultiplyAdd(Q.r[1], N12, DirectX::XMVectorMultiply(Q.r[0], N02)));
+
+        // Zero length normals stay zero, like **XMVector3Normalize**.
+        DirectX::XMVECTOR lengthSq = DirectX::XMVectorMultiplyAdd(NZ, NZ, DirectX::XMVectorMultiplyAdd(NY, NY, DirectX::XMVectorMultiply(NX, NX)));
+        DirectX::XMVECTOR invLength = DirectX::XMVectorSelect(DirectX::XMVectorReciprocalSqrt(lengthSq), zero, DirectX::XMVectorEqual(lengthSq, zero));
+        NX = DirectX::XMVectorMultiply(NX, invLength);
+        NY = DirectX::XMVectorMultiply(NY, invLength);
+        NZ = DirectX::XMVectorMultiply(NZ, invLength);
+
+        P = DirectX::XMMatrixTranspose(DirectX::XMMATRIX(PX, PY, PZ, zero));
+        Q = DirectX::XMMatrixTranspose(DirectX::XMMATRIX(NX, NY, NZ, zero));
+        for (std::uint32_t j = 0; j < 4; ++j) {
+            DirectX::XMStoreFloat3(&pBatch[j].position, P.r[j]);
+            DirectX::XMStoreFloat3(&pBatch[j].normal, Q.r[j]);
+        }
+    }
+
+    // Remaining vertices that do not fill a batch.
+    for (; i < count; ++i) {
+        DirectX::XMVECTOR P = DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&pVertices[i].position), M);
+        DirectX::XMVECTOR Q = DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&pVertices[i].normal), N);
+        DirectX::XMStoreFloat3(&pVertices[i].position, P);
+        DirectX::XMStoreFloat3(&pVertices[i].normal, DirectX::XMVector3Normalize(Q));
+    }
+}
+
+// Transforms the positions of **vertices** by **M** and their normals by its inverse transpose.
+// Large meshes are split in chunks over the shared thread pool, which waits on the chunks and would deadlock when called from one of its tasks.
+// Rethrows when a chunk could not be scheduled, the vertices are then partly transformed.
+template<typename Vertex>
+void TransformVertexArray(std::vector<Vertex>& vertices, const DirectX::XMMATRIX& M) {
+    // Translation does not apply to normals, singular matrices transform them by **M** itself.
+    DirectX::XMMATRIX L = M;
+    L.r[3] = DirectX::g_XMIdentityR3;
+    DirectX::XMVECTOR determinant;
+    DirectX::XMMATRIX N = DirectX::XMMatrixInverse(&determinant, L);
+    N = DirectX::XMVector3Equal(determinant, DirectX::XMVectorZero()) ? L : DirectX::XMMatrixTranspose(N);
+
+    std::uint32_t numVertices = vertices.size();
+    if (numVertices < PARALLEL_TRANSFORM_THRESHOLD) {
+        TransformVertexRange(vertices.data(), numVertices, M, N);
+        return;
+    }
+
+    std::uint32_t numChunks = (numVertices + TRANSFORM_CHUNK_SIZE - 1) / TRANSFORM_CHUNK_SIZE;
+    ThreadPool::Get().ParallelFor(0, numChunks, [&](std::size_t chunk) {
+        std::uint32_t first = chunk * TRANSFORM_CHUNK_SIZE;
+        TransformVertexRange(vertices.data() + first, std::min(TRANSFORM_CHUNK_SIZE, numVertices - first), M, N);
+    });
+}
+
+// ---------------------------------------------------------------- //
+//                          Vertex quantization
+// ---------------------------------------------------------------- //
+
+// Quantization mapping the bounds of the positions of **vertices** onto [-1, 1].
+template<typename Vertex>
+VertexQuantization MakeVertexQuantization(const std::vector<Vertex>& vertices) noexcept {
+    VertexQuantization quantization = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f } };
+    if (vertices.empty())
+        return quantization;
+
+    DirectX::XMVECTOR minimum = DirectX::XMLoadFloat3(&vertices[0].position);
+    DirectX::XMVECTOR maximum = minimum;
+    for (const Vertex& vertex : vertices) {
+        DirectX::XMVECTOR P = DirectX::XMLoadFloat3(&vertex.position);
+        minimum = DirectX::XMVectorMin(minimum, P);
+        maximum = DirectX::XMVectorMax(maximum, P);
+    }
+
+    DirectX::XMVECTOR half = DirectX::XMVectorReplicate(0.5f);
+    DirectX::XMStoreFloat3(&quantization.Offset, DirectX::XMVectorMultiply(DirectX::XMVectorAdd(minimum, maximum), half));
+    DirectX::XMStoreFloat3(&quantization.Scale, DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(maximum, minimum), half));
+    return quantization;
+}
+
+// Flat axes of the bounds have a scale of 0, their positions are all stored as 0.
+DirectX::XMVECTOR MakeInverseScale(const VertexQuantization& quantization) noexcept {
+    DirectX::XMVECTOR scale = DirectX::XMLoadFloat3(&quantization.Scale);
+    return DirectX::XMVectorSelect(DirectX::XMVectorReciprocal(scale), DirectX::XMVectorZero(), DirectX::XMVectorEqual(scale, DirectX::XMVectorZero()));
+}
+
+// Writes the position, normal and texture coordinate shared by both compact vertex types.
+template<typename Vertex, typename CompactVertex>
+void EncodeCompactVertex(const Vertex& vertex, DirectX::FXMVECTOR offset, DirectX::FXMVECTOR invScale, CompactVertex& compactVertex) noexcept {
+    DirectX::XMVECTOR P = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&vertex.position), offset), invScale);
+    DirectX::PackedVector::XMStoreShortN4(&compactVertex.position, DirectX::XMVectorSetW(P, 1.f));
+
+    // Projects the normal onto the octahedron |x| + |y| + |z| = 1 and folds its lower half over the upper half.
+    const DirectX::XMFLOAT3& n = vertex.normal;
+    float length = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    float x = length > 0.f ? n.x / length : 0.f;
+    float y = length > 0.f ? n.y / length : 0.f;
+    if (n.z < 0.f) {
+        float foldedX = (1.f - std::abs(y)) * (x >= 0.f ? 1.f : -1.f);
+        float foldedY = (1.f - std::abs(x)) * (y >= 0.f ? 1.f : -1.f);
+        x = foldedX;
+        y = foldedY;
+    }
+    DirectX::PackedVector::XMStoreShortN2(&compactVertex.normal, DirectX::XMVectorSet(x, y, 0.f, 0.f));
+
+    compactVertex.textureCoordinate = DirectX::PackedVector::XMHALF2(vertex.textureCoordinate.x, vertex.textureCoordinate.y);
+}
+
+// Reads the position, normal and texture coordinate shared by both compact vertex types.
+template<typename CompactVertex, typename Vertex>
+void DecodeCompactVertex(const CompactVertex& compactVertex, DirectX::FXMVECTOR offset, DirectX::FXMVECTOR scale, Vertex& vertex) noexcept {
+    DirectX::XMVECTOR P = DirectX::XMVectorMultiplyAdd(DirectX::PackedVector::XMLoadShortN4(&compactVertex.position), scale, offset);
+    DirectX::XMStoreFloat3(&vertex.position, P);
+
+    DirectX::XMFLOAT2 e;
+    DirectX::XMStoreFloat2(&e, DirectX::PackedVector::XMLoadShortN2(&compactVertex.normal));
+    float x = e.x;
+    float y = e.y;
+    float z = 1.f - std::abs(e.x) - std::abs(e.y);
+    if (z < 0.f) {
+        x = (1.f - std::abs(e.y)) * (e.x >= 0.f ? 1.f : -1.f);
+        y = (1.f - std::abs(e.x)) * (e.y >= 0.f ? 1.f : -1.f);
+    }
+    DirectX::XMStoreFloat3(&vertex.normal, DirectX::XMVector3Normalize(DirectX::XMVectorSet(x, y, z, 0.f)));
+
+    DirectX::XMStoreFloat2(&vertex.textureCoordinate, DirectX::PackedVector::XMLoadHalf2(&compactVertex.textureCoordinate));
+}
+
+// Rounds **weights** to unorm8, weights adding up to 1 still do so after rounding.
+DirectX::PackedVector::XMUBYTEN4 EncodeBlendWeights(const DirectX::XMFLOAT4& weights) noexcept {
+    float values[4] = { weights.x, weights.y, weights.z, weights.w };
+    std::int32_t quantized[4];
+    std::int32_t sum = 0;
+    std::uint32_t largest = 0;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        quantized[i] = static_cast<std::int32_t>(std::lround(std::clamp(values[i], 0.f, 1.f) * 255.f));
+        sum += quantized[i];
+        if (quantized[i] > quantized[largest])
+            largest = i;
+    }
+    // The rounding error is moved to the largest weight, which is at least a quarter of the sum.
+    if (std::abs(values[0] + values[1] + values[2] + values[3] - 1.f) < 1e-3f)
+        quantized[largest] += 255 - sum;
+
+    return DirectX::PackedVector::XMUBYTEN4(
+        static_cast<std::uint8_t>(quantized[0]), static_cast<std::uint8_t>(quantized[1]), 
+        static_cast<std::uint8_t>(quantized[2]), static_cast<std::uint8_t>(quantized[3]));
+}
+
 // ---------------------------------------------------------------- //
 //                          Mesh
 // ---------------------------------------------------------------- //
@@ -237,17 +1050,39 @@ Mesh::Mesh(std::string name, bool useStaticBuffers, bool visible)
     noexcept : BaseMesh(name, useStaticBuffers, visible)
 {}
 
-void Mesh::TransformVertices(DirectX::XMMATRIX& M) noexcept {
-    for (VertexPositionNormalTexture& vertex : m_vertices) {
-        DirectX::XMVECTOR P = DirectX::XMLoadFloat3(&vertex.position);
-        P = DirectX::XMVector3Transform(P, M);
-        DirectX::XMStoreFloat3(&vertex.position, P);
+void Mesh::TransformVertices(DirectX::XMMATRIX& M) {
+    RequireGeometry();
+    RestoreGeometry();
+    TransformVertexArray(m_vertices, M);
+    UpdateBounds();
+}
+
+VertexQuantization Mesh::EncodeCompactVertices(std::vector<VertexPositionNormalTextureCompact>& compactVertices) const {
+    VertexQuantization quantization = MakeVertexQuantization(m_vertices);
+    DirectX::XMVECTOR offset = DirectX::XMLoadFloat3(&quantization.Offset);
+    DirectX::XMVECTOR invScale = MakeInverseScale(quantization);
+
+    compactVertices.resize(m_vertices.size());
+    for (std::uint32_t i = 0; i < m_vertices.size(); ++i) {
+        EncodeCompactVertex(m_vertices[i], offset, invScale, compactVertices[i]);
+    }
+    return quantization;
+}
+
+void Mesh::DecodeCompactVertices(const VertexPositionNormalTextureCompact* pCompactVertices, std::uint32_t numVertices, const VertexQuantization& quantization) {
+    DirectX::XMVECTOR offset = DirectX::XMLoadFloat3(&quantization.Offset);
+    DirectX::XMVECTOR scale = DirectX::XMLoadFloat3(&quantization.Scale);
+
+    m_vertices.resize(numVertices);
+    for (std::uint32_t i = 0; i < numVertices; ++i) {
+        DecodeCompactVertex(pCompactVertices[i], offset, scale, m_vertices[i]);
     }
 }
 
 void Mesh::ClearGeometry() noexcept {
-    m_indices.clear();
-    m_vertices.clear();
+    std::vector<std::uint16_t>().swap(m_indices);
+    std::vector<std::uint32_t>().swap(m_wideIndices);
+    std::vector<VertexPositionNormalTexture>().swap(m_vertices);
 }
 
 void Mesh::RebuildFromBuffers() noexcept {
@@ -262,7 +1097,19 @@ std::vector<VertexPositionNormalTexture>& Mesh::GetVertices() noexcept {
 }
 
 std::uint32_t Mesh::GetNumVertices() const noexcept {
-    return m_vertices.size();
+    return HasGeometry() ? m_vertices.size() : m_numDeferredVertices;
+}
+
+std::uint32_t Mesh::GetVertexSizeInBytes() const noexcept {
+    return sizeof(VertexPositionNormalTexture);
+}
+
+void* Mesh::GetVertexData() noexcept {
+    return m_vertices.data();
+}
+
+void Mesh::ResizeVertices(std::uint32_t numVertices) {
+    m_vertices.resize(numVertices);
 }
 
 // ---------------------------------------------------------------- //
@@ -273,17 +1120,43 @@ SkinnedMesh::SkinnedMesh(std::string name, bool useStaticBuffers, bool visible)
     noexcept : BaseMesh(name, useStaticBuffers, visible)
 {}
 
-void SkinnedMesh::TransformVertices(DirectX::XMMATRIX& M) noexcept {
-    for (VertexPositionNormalTextureSkinning& vertex : m_vertices) {
-        DirectX::XMVECTOR P = DirectX::XMLoadFloat3(&vertex.position);
-        P = DirectX::XMVector3Transform(P, M);
-        DirectX::XMStoreFloat3(&vertex.position, P);
+void SkinnedMesh::TransformVertices(DirectX::XMMATRIX& M) {
+    RequireGeometry();
+    RestoreGeometry();
+    TransformVertexArray(m_vertices, M);
+    UpdateBounds();
+}
+
+VertexQuantization SkinnedMesh::EncodeCompactVertices(std::vector<VertexPositionNormalTextureSkinningCompact>& compactVertices) const {
+    VertexQuantization quantization = MakeVertexQuantization(m_vertices);
+    DirectX::XMVECTOR offset = DirectX::XMLoadFloat3(&quantization.Offset);
+    DirectX::XMVECTOR invScale = MakeInverseScale(quantization);
+
+    compactVertices.resize(m_vertices.size());
+    for (std::uint32_t i = 0; i < m_vertices.size(); ++i) {
+        EncodeCompactVertex(m_vertices[i], offset, invScale, compactVertices[i]);
+        compactVertices[i].indices = m_vertices[i].indices;
+        compactVertices[i].weights = EncodeBlendWeights(m_vertices[i].weights);
+    }
+    return quantization;
+}
+
+void SkinnedMesh::DecodeCompactVertices(const VertexPositionNormalTextureSkinningCompact* pCompactVertices, std::uint32_t numVertices, const VertexQuantization& quantization) {
+    DirectX::XMVECTOR offset = DirectX::XMLoadFloat3(&quantization.Offset);
+    DirectX::XMVECTOR scale = DirectX::XMLoadFloat3(&quantization.Scale);
+
+    m_vertices.resize(numVertices);
+    for (std::uint32_t i = 0; i < numVertices; ++i) {
+        DecodeCompactVertex(pCompactVertices[i], offset, scale, m_vertices[i]);
+        m_vertices[i].indices = pCompactVertices[i].indices;
+        DirectX::XMStoreFloat4(&m_vertices[i].weights, DirectX::PackedVector::XMLoadUByteN4(&pCompactVertices[i].weights));
     }
 }
 
 void SkinnedMesh::ClearGeometry() noexcept {
-    m_indices.clear();
-    m_vertices.clear();
+    std::vector<std::uint16_t>().swap(m_indices);
+    std::vector<std::uint32_t>().swap(m_wideIndices);
+    std::vector<VertexPositionNormalTextureSkinning>().swap(m_vertices);
 }
 
 void SkinnedMesh::RebuildFromBuffers() noexcept {
@@ -298,7 +1171,19 @@ std::vector<VertexPositionNormalTextureSkinning>& SkinnedMesh::GetVertices() noe
 }
 
 std::uint32_t SkinnedMesh::GetNumVertices() const noexcept {
-    return m_vertices.size();
+    return HasGeometry() ? m_vertices.size() : m_numDeferredVertices;
+}
+
+std::uint32_t SkinnedMesh::GetVertexSizeInBytes() const noexcept {
+    return sizeof(VertexPositionNormalTextureSkinning);
+}
+
+void* SkinnedMesh::GetVertexData() noexcept {
+    return m_vertices.data();
+}
+
+void SkinnedMesh::ResizeVertices(std::uint32_t numVertices) {
+    m_vertices.resize(numVertices);
 }
 
 // ---------------------------------------------------------------- //
@@ -310,6 +1195,8 @@ Model::Model(
         std::string name, 
         bool visible) : 
     Identifiable("model", name),
+    m_boundingBox({ 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f }),
+    m_boundingSphere({ 0.f, 0.f, 0.f }, 0.f),
     m_visible(visible)
 {
     if (!pMaterial)
@@ -321,7 +1208,10 @@ Model::Model(
 Model::Model(Model& other) : Identifiable(other),
     m_materials(other.GetMaterials()),
     m_meshes(other.GetMeshes()),
-    m_bones(other.GetBones())
+    m_bones(other.GetBones()),
+    m_skeleton(other.m_skeleton),
+    m_boundingBox(other.GetBoundingBox()),
+    m_boundingSphere(other.GetBoundingSphere())
 {
     if (other.GetNumBones() > 0) {
         if (other.GetBoneMatrices())
@@ -354,6 +1244,7 @@ void Model::Add(std::shared_ptr<IMesh> pMesh) {
         throw std::invalid_argument("IMesh was nullptr.");
 
     m_meshes.push_back(pMesh);
+    MergeBounds();
 
     for (IModelObserver* pIModelObserver : m_modelObservers) {
         if (pIModelObserver)
@@ -373,12 +1264,96 @@ void Model::RebuildFromBuffers() noexcept {
     }
 }
 
+void Model::RequireGeometry() {
+    for (std::shared_ptr<IMesh>& pMesh : m_meshes) {
+        pMesh->RequireGeometry();
+    }
+    // Meshes without stored bounds only have them once loaded.
+    MergeBounds();
+}
+
+void Model::SetResidency(GeometryResidency residency) {
+    for (std::shared_ptr<IMesh>& pMesh : m_meshes) {
+        pMesh->SetResidency(residency);
+    }
+}
+
+void Model::Optimize(const MeshOptimizerSettings& settings) {
+    for (std::shared_ptr<IMesh>& pMesh : m_meshes) {
+        pMesh->Optimize(settings);
+    }
+}
+
+void Model::MergeBounds() noexcept {
+    bool isEmpty = true;
+    for (std::shared_ptr<IMesh>& pMesh : m_meshes) {
+        isEmpty = !MergeSubmeshBounds(pMesh->GetSubmeshes(), isEmpty, m_boundingBox, m_boundingSphere);
+    }
+    if (isEmpty)
+        ClearBounds(m_boundingBox, m_boundingSphere);
+}
+
+void Model::CompileSkeleton() {
+    m_skeleton = Skeleton(m_bones);
+    // Cached to-root transforms follow the old order.
+    MarkBonesDirty();
+}
+
+void Model::SetLocalTransform(std::uint32_t boneIndex, DirectX::FXMMATRIX M) {
+    ReserveBoneTransforms();
+
+    DirectX::XMMATRIX& local = m_localTransforms[boneIndex];
+    bool isEqual = DirectX::XMVector4Equal(local.r[0], M.r[0])
+        && DirectX::XMVector4Equal(local.r[1], M.r[1])
+        && DirectX::XMVector4Equal(local.r[2], M.r[2])
+        && DirectX::XMVector4Equal(local.r[3], M.r[3]);
+    if (isEqual)
+        return;
+
+    local = M;
+    m_dirtyBones[boneIndex] = 1;
+}
+
+std::uint32_t Model::UpdateBoneMatrices() {
+    if (m_bones.empty())
+        return 0;
+
+    const Skeleton& skeleton = GetSkeleton();
+    ReserveBoneTransforms();
+
+    const std::uint16_t* pOrder = skeleton.GetOrder().data();
+    const std::uint16_t* pParentSlots = skeleton.GetParentSlots().data();
+
+    // A bone is recomputed when it changed or its parent was recomputed earlier in the sweep.
+    std::uint32_t numUpdated = 0;
+    for (std::uint32_t i = 0; i < skeleton.GetNumBones(); ++i) {
+        std::uint32_t boneIndex = pOrder[i];
+        std::uint8_t isDirty = m_dirtyBones[boneIndex] | m_dirtySlots[pParentSlots[i]];
+        m_dirtySlots[i + 1] = isDirty;
+        if (!isDirty)
+            continue;
+
+        DirectX::XMMATRIX toRoot = m_localTransforms[boneIndex] * m_toRootTransforms[pParentSlots[i]];
+        m_toRootTransforms[i + 1] = toRoot;
+        m_boneMatrices[boneIndex] = m_inverseBindPoseMatrices[boneIndex] * toRoot;
+        m_dirtyBones[boneIndex] = 0;
+        ++numUpdated;
+    }
+    return numUpdated;
+}
+
+void Model::MarkBonesDirty() noexcept {
+    std::fill(m_dirtyBones.begin(), m_dirtyBones.end(), 1);
+}
+
 void Model::MakeBoneMatricesArray(std::uint64_t count) {
     m_boneMatrices = Bone::MakeArray(count);
+    MarkBonesDirty();
 }
 
 void Model::MakeInverseBoneMatricesArray(std::uint64_t count) {
     m_inverseBindPoseMatrices = Bone::MakeArray(count);
+    MarkBonesDirty();
 }
 
 void Model::RemoveMaterial(std::uint8_t index) {
@@ -410,6 +1385,7 @@ void Model::RemoveIMesh(std::uint8_t index) {
     }
 
     m_meshes.erase(m_meshes.begin() + index);
+    MergeBounds();
 }
 
 void Model::ApplyWorldTransform(DirectX::XMFLOAT3X4 W) noexcept {
@@ -422,10 +1398,11 @@ void Model::ApplyWorldTransform(DirectX::XMFLOAT3X4 W) noexcept {
     }
 }
 
-void Model::TransformVertices(DirectX::XMMATRIX& M) noexcept {
+void Model::TransformVertices(DirectX::XMMATRIX& M) {
     for (std::shared_ptr<IMesh>& pIMesh : m_meshes) {
         pIMesh->TransformVertices(M);
     }
+    MergeBounds();
 }
 
 void Model::Attach(IModelObserver* pIModelObserver) {
@@ -439,6 +1416,21 @@ void Model::Detach(IModelObserver* pIModelObserver) noexcept {
 }
 
 
+void Model::ReserveBoneTransforms() {
+    if (m_dirtyBones.size() == m_bones.size())
+        return;
+
+    m_localTransforms = Bone::MakeArray(m_bones.size());
+    m_toRootTransforms = Bone::MakeArray(m_bones.size() + 1);
+    for (std::uint32_t i = 0; i < m_bones.size(); ++i) {
+        m_localTransforms[i] = DirectX::XMMatrixIdentity();
+    }
+    m_toRootTransforms[0] = DirectX::XMMatrixIdentity();
+
+    m_dirtyBones.assign(m_bones.size(), 1);
+    m_dirtySlots.assign(m_bones.size() + 1, 0);
+}
+
 std::vector<std::shared_ptr<Material>>& Model::GetMaterials() noexcept {
     return m_materials;
 }
@@ -467,6 +1459,12 @@ std::vector<Bone>& Model::GetBones() noexcept {
     return m_bones;
 }
 
+const Skeleton& Model::GetSkeleton() {
+    if (m_skeleton.GetNumBones() != m_bones.size())
+        CompileSkeleton();
+    return m_skeleton;
+}
+
 Bone::TransformArray& Model::GetBoneMatrices() noexcept {
     return m_boneMatrices;
 }
@@ -487,6 +1485,14 @@ bool Model::IsUsingStaticBuffers() const noexcept {
     return usingStaticBuffers == m_meshes.size();
 }
 
+bool Model::IsGeometryResident() const noexcept {
+    for (const std::shared_ptr<IMesh>& pIMesh : m_meshes) {
+        if (!pIMesh->IsGeometryResident())
+            return false;
+    }
+    return true;
+}
+
 bool Model::IsSkinned() const noexcept {
     for (const std::shared_ptr<Material>& pMaterial : m_materials) {
         if (pMaterial->GetFlags() & RenderFlags::Effect::Skinned)
@@ -495,6 +1501,14 @@ bool Model::IsSkinned() const noexcept {
     return false;
 }
 
+const DirectX::BoundingBox& Model::GetBoundingBox() const noexcept {
+    return m_boundingBox;
+}
+
+const DirectX::BoundingSphere& Model::GetBoundingSphere() const noexcept {
+    return m_boundingSphere;
+}
+
 void Model::SetVisible(bool visible) noexcept {
     m_visible = visible;
 }
@@ -535,3 +1549,11 @@ std::uint32_t Model::GetNumIndices() const noexcept {
     return total;
 }
 
+std::uint64_t Model::GetResidencySavingsInBytes() const noexcept {
+    std::uint64_t total = 0;
+    for (const std::shared_ptr<IMesh>& pIMesh : m_meshes) {
+        total += pIMesh->GetResidencySavingsInBytes();
+    }
+    return total;
+}
+
@@ -43,6 +43,9 @@ class Renderer::Impl : public IDeviceObserver {
         bool IsMsaaEnabled() const noexcept;
 
     private:
+        // Loads deferred geometry of everything that will be drawn, uploading it before the command list is recorded.
+        void StreamGeometry();
+
         void Clear();
 
         void RenderBatch(const DeviceDataBatch& batch, std::uint8_t batchIndex);
@@ -104,8 +107,11 @@ void Renderer::Impl::Load(Scene& scene) {
 }
 
 void Renderer::Impl::Update() {
-    if (m_pDeviceResourceData->SceneLoaded()) 
-        m_pDeviceResourceData->Update();
+    if (!m_pDeviceResourceData->SceneLoaded()) 
+        return;
+
+    StreamGeometry();
+    m_pDeviceResourceData->Update();
 }
 
 void Renderer::Impl::Render(const std::function<void()>& renderImGui) {
@@ -113,6 +119,9 @@ void Renderer::Impl::Render(const std::function<void()>& renderImGui) {
     if (!m_pDeviceResourceData->SceneLoaded())
         return;
 
+    // Catches meshes made visible since **Update**, streaming waits on the GPU so it can't happen while recording.
+    StreamGeometry();
+
     ID3D12GraphicsCommandList* pCommandList = m_pDeviceResources->GetCommandList();
 
     // Prepare the command list to render a new frame.
@@ -226,6 +235,30 @@ bool Renderer::Impl::IsMsaaEnabled() const noexcept {
     return m_msaaEnabled;
 }
 
+void Renderer::Impl::StreamGeometry() {
+    for (std::uint8_t i = 0; i < m_pDeviceResourceData->GetNumDataBatches(); ++i) {
+        if (!m_pDeviceResourceData->GetScene().GetAssetBatches()[i]->IsVisible())
+            continue;
+
+        for (const ModelPair& modelPair : m_pDeviceResourceData->GetDataBatches()[i]->GetModelData()) {
+            if (!modelPair.first->IsVisible())
+                continue;
+
+            // Skinned models draw every mesh.
+            bool loaded = false;
+            for (std::shared_ptr<IMesh>& pIMesh : modelPair.first->GetMeshes()) {
+                if (pIMesh->IsGeometryResident() || (!pIMesh->IsVisible() && !modelPair.first->IsSkinned()))
+                    continue;
+                pIMesh->RequireGeometry();
+                loaded = true;
+            }
+            // Meshes without stored bounds only have them once loaded.
+            if (loaded)
+                modelPair.first->MergeBounds();
+        }
+    }
+}
+
 void Renderer::Impl::Clear() {
     ID3D12GraphicsCommandList* pCommandList = m_pDeviceResources->GetCommandList();
 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "pch.h"
+
+#include <string>
+
+// Read-only view of a file mapped into the address space of the process.
+// Pages are only read from disk when they are touched and are backed by the file itself,
+// so they can be dropped by the OS at any time without being written to the page file.
+class MappedFile {
+    public:
+        MappedFile(const std::string& filePath)
+            : m_file(INVALID_HANDLE_VALUE),
+            m_mapping(nullptr),
+            m_pView(nullptr),
+            m_sizeInBytes(0)
+        {
+            m_file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("Failed to open file: '" + filePath + "'");
+
+            LARGE_INTEGER size = {};
+            if (!GetFileSizeEx(m_file, &size)) {
+                CloseHandle(m_file);
+                throw std::runtime_error("Failed to query size of file: '" + filePath + "'");
+            }
+            m_sizeInBytes = static_cast<std::uint64_t>(size.QuadPart);
+
+            // Mapping an empty file is an error on Windows, an empty view is valid here.
+            if (m_sizeInBytes == 0)
+                return;
+
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping) {
+                CloseHandle(m_file);
+                throw std::runtime_error("Failed to map file: '" + filePath + "'");
+            }
+
+            m_pView = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!m_pView) {
+                CloseHandle(m_mapping);
+                CloseHandle(m_file);
+                throw std::runtime_error("Failed to create view of file: '" + filePath + "'");
+            }
+        }
+
+        ~MappedFile() {
+            if (m_pView)
+                UnmapViewOfFile(m_pView);
+            if (m_mapping)
+                CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE)
+                CloseHandle(m_file);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator= (const MappedFile&) = delete;
+
+    public:
+        const char* GetData() const noexcept { return m_pView; }
+        std::uint64_t GetSizeInBytes() const noexcept { return m_sizeInBytes; }
+
+    private:
+        HANDLE m_file;
+        HANDLE m_mapping;
+        const char* m_pView;
+        std::uint64_t m_sizeInBytes;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads that execute tasks in the order they are submitted.
+// The workers are started in the constructor and joined in the destructor after the queue is drained.
+class ThreadPool {
+    public:
+        // Uses one worker per hardware thread when **numThreads** is 0.
+        ThreadPool(std::uint32_t numThreads = 0)
+            : m_stopping(false)
+        {
+            if (numThreads == 0)
+                numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+            m_workers.reserve(numThreads);
+            for (std::uint32_t i = 0; i < numThreads; ++i) {
+                m_workers.emplace_back([this]() { WorkerLoop(); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_condition.notify_all();
+
+            for (std::thread& worker : m_workers) {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator= (const ThreadPool&) = delete;
+
+        // Shared pool for work that does not need its own set of threads.
+        static ThreadPool& Get() {
+            static ThreadPool instance;
+            return instance;
+        }
+
+    public:
+        // Queues **task** and returns a future to its result.
+        // Exceptions thrown by the task are rethrown by std::future::get.
+        template<typename Task>
+        auto Submit(Task&& task) -> std::future<std::invoke_result_t<std::decay_t<Task>>> {
+            using Result = std::invoke_result_t<std::decay_t<Task>>;
+
+            auto pTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+            std::future<Result> future = pTask->get_future();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push([pTask]() { (*pTask)(); });
+            }
+            m_condition.notify_one();
+
+            return future;
+        }
+
+        // Calls **body(i)** for every i in [begin, end), split into one contiguous range per worker.
+        // The calling thread executes the first range itself and blocks until all ranges are done.
+        // Must not be called from a task running on the same pool.
+        template<typename Body>
+        void ParallelFor(std::size_t begin, std::size_t end, const Body& body) {
+            if (begin >= end)
+                return;
+
+            std::size_t count = end - begin;
+            std::size_t numRanges = std::min<std::size_t>(count, m_workers.size() + 1);
+            std::size_t rangeSize = (count + numRanges - 1) / numRanges;
+
+            std::vector<std::future<void>> futures;
+            futures.reserve(numRanges - 1);
+            for (std::size_t rangeBegin = begin + rangeSize; rangeBegin < end; rangeBegin += rangeSize) {
+                std::size_t rangeEnd = std::min(rangeBegin + rangeSize, end);
+                futures.push_back(Submit([&body, rangeBegin, rangeEnd]() {
+                    for (std::size_t i = rangeBegin; i < rangeEnd; ++i) {
+                        body(i);
+                    }
+                }));
+            }
+
+            // Every range has to finish before returning since they all reference **body**.
+            std::exception_ptr pException;
+            try {
+                for (std::size_t i = begin; i < std::min(begin + rangeSize, end); ++i) {
+                    body(i);
+                }
+            } catch (...) {
+                pException = std::current_exception();
+            }
+
+            for (std::future<void>& future : futures) {
+                try {
+                    future.get();
+                } catch (...) {
+                    if (!pException)
+                        pException = std::current_exception();
+                }
+            }
+
+            if (pException)
+                std::rethrow_exception(pException);
+        }
+
+        std::uint32_t GetNumThreads() const noexcept { return static_cast<std::uint32_t>(m_workers.size()); }
+
+    private:
+        void WorkerLoop() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+                    if (m_tasks.empty())
+                        return;
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop();
+                }
+                task();
+            }
+        }
+
+    private:
+        std::vector<std::thread> m_workers;
+        std::queue<std::function<void()>> m_tasks;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopping;
+};
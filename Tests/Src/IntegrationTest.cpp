@@ -140,6 +140,30 @@ TEST_F(PostFreshLoadTest, Renderer_ForceDeviceReset) {
     ASSERT_TRUE(SimulateMainLoop(*pRenderer));
 }
 
+TEST_F(PostFreshLoadTest, Renderer_ForceDeviceReset_WithEveryResidency) {
+    for (GeometryResidency residency : { GeometryResidency::KeepCPUCopy, GeometryResidency::ReleaseAfterUpload, GeometryResidency::KeepCompressedCopy }) {
+        for (bool useStaticBuffers : { false, true }) {
+            ASSERT_NO_THROW(pModel->UseStaticBuffers(useStaticBuffers));
+            ASSERT_NO_THROW(pModel->SetResidency(residency));
+            std::uint32_t numVertices = pModel->GetNumVertices();
+            std::uint32_t numIndices = pModel->GetNumIndices();
+
+            ASSERT_NO_THROW(pRenderer->ForceDeviceReset());
+            ASSERT_TRUE(SimulateMainLoop(*pRenderer));
+            EXPECT_EQ(pModel->GetNumVertices(), numVertices);
+            EXPECT_EQ(pModel->GetNumIndices(), numIndices);
+
+            // The geometry can be brought back to the CPU after the reset.
+            for (std::shared_ptr<IMesh>& pIMesh : pModel->GetMeshes()) {
+                EXPECT_EQ(pIMesh->IsGeometryReleased(), residency != GeometryResidency::KeepCPUCopy);
+                ASSERT_NO_THROW(pIMesh->RestoreGeometry());
+                EXPECT_EQ(pIMesh->GetIndices().size() + pIMesh->GetWideIndices().size(), pIMesh->GetNumIndices());
+            }
+            ASSERT_NO_THROW(pModel->SetResidency(residency));
+        }
+    }
+}
+
 TEST_F(PostFreshLoadTest, Renderer_ToggleMSAA_StartOn) {
     ASSERT_NO_THROW(pRenderer->SetMsaa(true));
     ASSERT_TRUE(SimulateMainLoop(*pRenderer));
@@ -5,6 +5,7 @@
 class MockMeshObserver : public IMeshObserver {
     public:
         MOCK_METHOD(void, OnUseStaticBuffers, (IMesh* pIMesh, bool useStaticBuffers), (override));
+        MOCK_METHOD(void, OnSetResidency, (IMesh* pIMesh, GeometryResidency residency), (override));
         MOCK_METHOD(void, OnUpdateBuffers, (IMesh* pIMesh), (override));
 
         MOCK_METHOD(void, OnRebuildFromBuffers, (Mesh* pMesh), (override));
@@ -0,0 +1,85 @@
+#include "SyntheticScene.h"
+
+#include <stdexcept>
+
+#include <assimp/Exporter.hpp>
+#include <assimp/scene.h>
+
+void SyntheticScene::WriteSkinnedChain(const std::string& filePath, std::uint32_t numBones, std::uint32_t numTicks) {
+    aiScene scene;
+    scene.mRootNode = new aiNode("root");
+    scene.mRootNode->mNumMeshes = 1;
+    scene.mRootNode->mMeshes = new unsigned int[1] { 0 };
+
+    aiNode* pParent = scene.mRootNode;
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        aiNode* pNode = new aiNode("bone" + std::to_string(i));
+        pNode->mParent = pParent;
+        pParent->mNumChildren = 1;
+        pParent->mChildren = new aiNode*[1] { pNode };
+        pParent = pNode;
+    }
+
+    scene.mNumMaterials = 1;
+    scene.mMaterials = new aiMaterial*[1] { new aiMaterial() };
+
+    aiMesh* pMesh = new aiMesh();
+    pMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    pMesh->mNumVertices = 3;
+    pMesh->mVertices = new aiVector3D[3] { { 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f } };
+    pMesh->mNumFaces = 1;
+    pMesh->mFaces = new aiFace[1];
+    pMesh->mFaces[0].mNumIndices = 3;
+    pMesh->mFaces[0].mIndices = new unsigned int[3] { 0, 1, 2 };
+
+    pMesh->mNumBones = numBones;
+    pMesh->mBones = new aiBone*[numBones];
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        aiBone* pBone = new aiBone();
+        pBone->mName = aiString("bone" + std::to_string(i));
+        pBone->mNumWeights = 1;
+        pBone->mWeights = new aiVertexWeight[1] { aiVertexWeight(i % 3, 1.f / (1 + i / 3)) };
+        pMesh->mBones[i] = pBone;
+    }
+
+    scene.mNumMeshes = 1;
+    scene.mMeshes = new aiMesh*[1] { pMesh };
+
+    aiAnimation* pAnimation = new aiAnimation();
+    pAnimation->mName = aiString("synthetic");
+    pAnimation->mDuration = numTicks;
+    pAnimation->mTicksPerSecond = 30.0;
+    pAnimation->mNumChannels = numBones;
+    pAnimation->mChannels = new aiNodeAnim*[numBones];
+    for (std::uint32_t i = 0; i < numBones; ++i) {
+        aiNodeAnim* pChannel = new aiNodeAnim();
+        pChannel->mNodeName = aiString("bone" + std::to_string(i));
+
+        pChannel->mNumPositionKeys = numTicks;
+        pChannel->mPositionKeys = new aiVectorKey[pChannel->mNumPositionKeys];
+        for (std::uint32_t j = 0; j < pChannel->mNumPositionKeys; ++j) {
+            pChannel->mPositionKeys[j] = aiVectorKey(j, aiVector3D(static_cast<float>(j), 0.f, 0.f));
+        }
+
+        pChannel->mNumRotationKeys = (numTicks + 1) / 2;
+        pChannel->mRotationKeys = new aiQuatKey[pChannel->mNumRotationKeys];
+        for (std::uint32_t j = 0; j < pChannel->mNumRotationKeys; ++j) {
+            pChannel->mRotationKeys[j] = aiQuatKey(j * 2, aiQuaternion(1.f, 0.f, 0.f, 0.f));
+        }
+
+        pChannel->mNumScalingKeys = (numTicks + 2) / 3;
+        pChannel->mScalingKeys = new aiVectorKey[pChannel->mNumScalingKeys];
+        for (std::uint32_t j = 0; j < pChannel->mNumScalingKeys; ++j) {
+            pChannel->mScalingKeys[j] = aiVectorKey(j * 3, aiVector3D(2.f, 2.f, 2.f));
+        }
+
+        pAnimation->mChannels[i] = pChannel;
+    }
+
+    scene.mNumAnimations = 1;
+    scene.mAnimations = new aiAnimation*[1] { pAnimation };
+
+    Assimp::Exporter exporter;
+    if (exporter.Export(&scene, "assbin", filePath) != aiReturn_SUCCESS)
+        throw std::runtime_error(exporter.GetErrorString());
+}
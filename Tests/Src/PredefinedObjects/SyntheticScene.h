@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Writes scenes that are built in memory to disk with assimp, so they can be read back through AssetIO.
+class SyntheticScene {
+    public:
+        // A single triangle skinned to a chain of **numBones** bones.
+        // Every bone has a channel in one animation with a position key at every tick,
+        // a rotation key at every second tick and a scaling key at every third tick, **numTicks** ticks long.
+        static void WriteSkinnedChain(const std::string& filePath, std::uint32_t numBones, std::uint32_t numTicks);
+};
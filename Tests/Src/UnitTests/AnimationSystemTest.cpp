@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <RoX/AnimationSystem.h>
+
+#include "../PredefinedObjects/ValidAnimation.h"
+#include "../PredefinedObjects/ValidModel.h"
+
+class AnimationSystemTest : public testing::Test, public ValidModel, public ValidAnimation {
+    protected:
+        AnimationSystemTest()
+            : camera(),
+            scene("AnimationSystemTest", camera)
+        {
+            pBatch = std::make_shared<AssetBatch>("AnimationSystemTest");
+            scene.Add(pBatch);
+        }
+
+        // Chain of **numBones** bones with an identity bind pose, sharing the geometry of **pSkinnedMesh**.
+        std::shared_ptr<Model> NewAnimatedModel(std::uint32_t numBones) {
+            auto pAnimated = std::make_shared<Model>(pMaterial);
+            pAnimated->Add(pSkinnedMesh);
+            for (std::uint32_t i = 0; i < numBones; ++i) {
+                pAnimated->GetBones().push_back({ "bone" + std::to_string(i), i == 0 ? Bone::INVALID_INDEX : i - 1 });
+            }
+            pAnimated->MakeBoneMatricesArray(numBones);
+            pAnimated->MakeInverseBoneMatricesArray(numBones);
+            for (std::uint32_t i = 0; i < numBones; ++i) {
+                pAnimated->GetInverseBindPoseMatrices()[i] = DirectX::XMMatrixIdentity();
+            }
+            return pAnimated;
+        }
+
+        // Every bone moves along the x axis and turns around the y axis.
+        static std::shared_ptr<Animation> NewMovingAnimation(std::uint32_t numBones, std::uint32_t numKeyframes) {
+            auto pMoving = std::make_shared<Animation>("moving");
+            for (std::uint32_t i = 0; i < numBones; ++i) {
+                BoneAnimation boneAnimation;
+                for (std::uint32_t j = 0; j < numKeyframes; ++j) {
+                    DirectX::XMFLOAT4 rotation;
+                    DirectX::XMStoreFloat4(&rotation, DirectX::XMQuaternionRotationRollPitchYaw(0.f, j * 0.1f, 0.f));
+                    boneAnimation.Keyframes.push_back({ j / 30.f, { float(j), 0.f, 0.f }, { 1.f, 1.f, 1.f }, rotation });
+                }
+                boneAnimation.UpdateTimePositions();
+                pMoving->GetBoneAnimations().push_back(boneAnimation);
+            }
+            return pMoving;
+        }
+
+        static void ExpectNearMatrix(const DirectX::XMMATRIX& A, const DirectX::XMMATRIX& B) {
+            DirectX::XMFLOAT4X4 a, b;
+            DirectX::XMStoreFloat4x4(&a, A);
+            DirectX::XMStoreFloat4x4(&b, B);
+            for (std::uint32_t row = 0; row < 4; ++row) {
+                for (std::uint32_t column = 0; column < 4; ++column) {
+                    EXPECT_NEAR(a.m[row][column], b.m[row][column], 1e-4f);
+                }
+            }
+        }
+
+    protected:
+        Camera camera;
+        Scene scene;
+        std::shared_ptr<AssetBatch> pBatch;
+};
+
+TEST_F(AnimationSystemTest, Update_MatchesApply) {
+    auto pMoving = NewMovingAnimation(4, 30);
+    auto pAnimated = NewAnimatedModel(4);
+    pBatch->Add(pAnimated);
+
+    AnimationSystem system(2);
+    AnimationBinding& binding = system.Bind(*pAnimated, pMoving, false);
+    system.Update(scene, 0.25f);
+    EXPECT_EQ(system.GetNumUpdated(), 1u);
+    EXPECT_FLOAT_EQ(binding.TimePosition, 0.25f);
+
+    auto pExpected = NewAnimatedModel(4);
+    pMoving->Apply(0.25f, *pExpected);
+    for (std::uint32_t i = 0; i < pAnimated->GetNumBones(); ++i) {
+        ExpectNearMatrix(pAnimated->GetBoneMatrices()[i], pExpected->GetBoneMatrices()[i]);
+    }
+}
+
+TEST_F(AnimationSystemTest, Update_WithLoop_WrapsTime) {
+    auto pMoving = NewMovingAnimation(1, 31);
+    auto pAnimated = NewAnimatedModel(1);
+    pBatch->Add(pAnimated);
+
+    AnimationSystem system(1);
+    AnimationBinding& binding = system.Bind(*pAnimated, pMoving);
+    system.Update(scene, 1.25f);
+    EXPECT_NEAR(binding.TimePosition, 0.25f, 1e-5f);
+
+    binding.Speed = -1.f;
+    system.Update(scene, 0.5f);
+    EXPECT_NEAR(binding.TimePosition, 0.75f, 1e-5f);
+}
+
+TEST_F(AnimationSystemTest, Update_OnlyUpdatesBoundModelsInScene) {
+    auto pMoving = NewMovingAnimation(2, 30);
+    auto pBound = NewAnimatedModel(2);
+    auto pUnbound = NewAnimatedModel(2);
+    auto pOutsideScene = NewAnimatedModel(2);
+    pBatch->Add(pBound);
+    pBatch->Add(pUnbound);
+
+    // A model in several batches is only updated once.
+    auto pOtherBatch = std::make_shared<AssetBatch>("Other");
+    pOtherBatch->Add(pBound);
+    scene.Add(pOtherBatch);
+
+    AnimationSystem system(2);
+    system.Bind(*pBound, pMoving);
+    AnimationBinding& outside = system.Bind(*pOutsideScene, pMoving);
+    system.Update(scene, 0.1f);
+
+    EXPECT_EQ(system.GetNumBindings(), 2u);
+    EXPECT_EQ(system.GetNumUpdated(), 1u);
+    EXPECT_FLOAT_EQ(outside.TimePosition, 0.f);
+
+    system.Unbind(pBound->GetGUID());
+    system.Update(scene, 0.1f);
+    EXPECT_EQ(system.GetNumUpdated(), 0u);
+}
+
+TEST_F(AnimationSystemTest, Update_WithLOD_SamplesLessOftenFarAway) {
+    auto pMoving = NewMovingAnimation(2, 30);
+    auto pAnimated = NewAnimatedModel(2);
+    pBatch->Add(pAnimated);
+
+    AnimationSystem system(1);
+    AnimationBinding& binding = system.Bind(*pAnimated, pMoving);
+    binding.LODs.push_back({ 100.f, 4, 0 });
+
+    // The model sits at the origin.
+    camera.SetPosition(0.f, 0.f, 10.f);
+    std::uint32_t numSampled = 0;
+    for (std::uint32_t frame = 0; frame < 9; ++frame) {
+        system.Update(scene, 0.01f);
+        numSampled += system.GetNumUpdated();
+    }
+    EXPECT_EQ(numSampled, 9u);
+
+    // The first update after binding always samples, after that only every 4th update does.
+    system.Bind(*pAnimated, pMoving);
+    camera.SetPosition(0.f, 0.f, 1000.f);
+    numSampled = 0;
+    for (std::uint32_t frame = 0; frame < 9; ++frame) {
+        system.Update(scene, 0.01f);
+        numSampled += system.GetNumUpdated();
+    }
+    EXPECT_EQ(numSampled, 3u);
+    // Time moves forward on every update, sampled or not.
+    EXPECT_NEAR(binding.TimePosition, 0.09f, 1e-5f);
+}
+
+TEST_F(AnimationSystemTest, Update_WithLOD_HoldsBonesPastMaxDepth) {
+    auto pMoving = NewMovingAnimation(3, 30);
+    auto pAnimated = NewAnimatedModel(3);
+    pBatch->Add(pAnimated);
+
+    AnimationSystem system(1);
+    AnimationBinding& binding = system.Bind(*pAnimated, pMoving, false);
+    binding.LODs.push_back({ 0.f, 1, 1 });
+    system.Update(scene, 0.5f);
+
+    // Only the root is animated, the bones below it stay at the identity relative to their parent.
+    ExpectNearMatrix(pAnimated->GetBoneMatrices()[1], pAnimated->GetBoneMatrices()[0]);
+    ExpectNearMatrix(pAnimated->GetBoneMatrices()[2], pAnimated->GetBoneMatrices()[0]);
+
+    binding.LODs.clear();
+    system.Update(scene, 0.f);
+
+    auto pExpected = NewAnimatedModel(3);
+    pMoving->Apply(0.5f, *pExpected);
+    for (std::uint32_t i = 0; i < pAnimated->GetNumBones(); ++i) {
+        ExpectNearMatrix(pAnimated->GetBoneMatrices()[i], pExpected->GetBoneMatrices()[i]);
+    }
+}
+
+TEST_F(AnimationSystemTest, Update_WithEmptyBoneAnimations) {
+    // Imported clips leave bones without a channel empty, including the first and last one.
+    auto pMoving = NewMovingAnimation(1, 31);
+    pMoving->GetBoneAnimations().insert(pMoving->GetBoneAnimations().begin(), BoneAnimation());
+    pMoving->GetBoneAnimations().push_back({});
+    auto pAnimated = NewAnimatedModel(3);
+    pBatch->Add(pAnimated);
+
+    AnimationSystem system(1);
+    AnimationBinding& binding = system.Bind(*pAnimated, pMoving);
+    EXPECT_FLOAT_EQ(binding.TimePosition, 0.f);
+    system.Update(scene, 1.25f);
+    EXPECT_NEAR(binding.TimePosition, 0.25f, 1e-5f);
+
+    auto pExpected = NewAnimatedModel(3);
+    pMoving->Apply(0.25f, *pExpected);
+    for (std::uint32_t i = 0; i < pAnimated->GetNumBones(); ++i) {
+        ExpectNearMatrix(pAnimated->GetBoneMatrices()[i], pExpected->GetBoneMatrices()[i]);
+    }
+}
+
+TEST_F(AnimationSystemTest, Bind_WithoutAnimation) {
+    AnimationSystem system(1);
+    EXPECT_THROW(system.Bind(*pSkinnedModel, nullptr), std::invalid_argument);
+}
+
+// Updates 1 to 1000 models with 32 bones each on 1 to hardware_concurrency threads.
+// The timings are written to the test report as properties.
+TEST_F(AnimationSystemTest, DISABLED_Benchmark_ThreadScaling) {
+    static constexpr std::uint32_t NUM_BONES = 32;
+    static constexpr std::uint32_t NUM_FRAMES = 20;
+
+    std::shared_ptr<Animation> pMoving = NewMovingAnimation(NUM_BONES, 120);
+
+    std::uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::uint32_t numModels : { 1u, 10u, 100u, 1000u }) {
+        Scene benchmarkScene("Benchmark", camera);
+        auto pBenchmarkBatch = std::make_shared<AssetBatch>("Benchmark");
+        benchmarkScene.Add(pBenchmarkBatch);
+
+        std::vector<std::shared_ptr<Model>> models;
+        for (std::uint32_t i = 0; i < numModels; ++i) {
+            models.push_back(NewAnimatedModel(NUM_BONES));
+            pBenchmarkBatch->Add(models.back());
+        }
+
+        for (std::uint32_t numThreads = 1; numThreads <= maxThreads; ++numThreads) {
+            AnimationSystem system(numThreads);
+            for (std::shared_ptr<Model>& pAnimated : models) {
+                system.Bind(*pAnimated, pMoving);
+            }
+            // The first update sizes the pose buffers.
+            system.Update(benchmarkScene, 0.f);
+
+            auto start = std::chrono::steady_clock::now();
+            for (std::uint32_t frame = 0; frame < NUM_FRAMES; ++frame) {
+                system.Update(benchmarkScene, 1.f / 60.f);
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+            EXPECT_EQ(system.GetNumUpdated(), numModels);
+            RecordProperty("Models_" + std::to_string(numModels) + "_Threads_" + std::to_string(numThreads) + "_us", std::to_string(elapsed / NUM_FRAMES));
+        }
+    }
+}
+
+// Updates a crowd of 1000 models with 32 bones each, first in full detail and then with LODs.
+// The timings are written to the test report as properties.
+TEST_F(AnimationSystemTest, DISABLED_Benchmark_LOD) {
+    static constexpr std::uint32_t NUM_MODELS = 1000;
+    static constexpr std::uint32_t NUM_BONES = 32;
+    static constexpr std::uint32_t NUM_FRAMES = 20;
+
+    std::shared_ptr<Animation> pMoving = NewMovingAnimation(NUM_BONES, 120);
+    std::vector<std::shared_ptr<Model>> models;
+    for (std::uint32_t i = 0; i < NUM_MODELS; ++i) {
+        models.push_back(NewAnimatedModel(NUM_BONES));
+        pBatch->Add(models.back());
+    }
+
+    std::vector<AnimationLOD> LODs = { { 0.f, 2, 8 }, { 0.f, 4, 4 } };
+    for (std::uint32_t LOD = 0; LOD <= LODs.size(); ++LOD) {
+        AnimationSystem system(1);
+        for (std::shared_ptr<Model>& pAnimated : models) {
+            AnimationBinding& binding = system.Bind(*pAnimated, pMoving);
+            if (LOD > 0)
+                binding.LODs.push_back(LODs[LOD - 1]);
+        }
+        // The first update samples every model.
+        system.Update(scene, 0.f);
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t frame = 0; frame < NUM_FRAMES; ++frame) {
+            system.Update(scene, 1.f / 60.f);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        RecordProperty("LOD_" + std::to_string(LOD) + "_us", std::to_string(elapsed / NUM_FRAMES));
+    }
+}
@@ -0,0 +1,669 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <RoX/Animation.h>
+#include <RoX/AnimationMixer.h>
+#include <RoX/BakedAnimation.h>
+#include <RoX/CompiledAnimation.h>
+#include <RoX/CompressedAnimation.h>
+
+#include "../PredefinedObjects/ValidAnimation.h"
+#include "../PredefinedObjects/ValidModel.h"
+
+// Counts every allocation made through operator new by the test executable.
+static std::atomic<std::uint64_t> NUM_ALLOCATIONS(0);
+
+void* operator new(std::size_t size) {
+    ++NUM_ALLOCATIONS;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    ++NUM_ALLOCATIONS;
+    if (void* p = _aligned_malloc(size ? size : 1, static_cast<std::size_t>(alignment)))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    _aligned_free(p);
+}
+
+class AnimationTest : public testing::Test, public ValidModel, public ValidAnimation {
+    protected:
+        AnimationTest() {
+            // A root with a single child, matching the two bone animations of **pAnimation**.
+            pSkinnedModel->GetBones().push_back({ "root" });
+            pSkinnedModel->GetBones().push_back({ "child", 0 });
+            pSkinnedModel->MakeBoneMatricesArray(pSkinnedModel->GetNumBones());
+            pSkinnedModel->MakeInverseBoneMatricesArray(pSkinnedModel->GetNumBones());
+            for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+                pSkinnedModel->GetInverseBindPoseMatrices()[i] = DirectX::XMMatrixIdentity();
+            }
+        }
+
+        // Keyframes every 1/30th of a second with a translation that changes every keyframe.
+        static BoneAnimation NewLongBoneAnimation(std::uint32_t numKeyframes) {
+            BoneAnimation boneAnimation;
+            boneAnimation.Keyframes.reserve(numKeyframes);
+            for (std::uint32_t i = 0; i < numKeyframes; ++i) {
+                boneAnimation.Keyframes.push_back({ i / 30.f, { float(i), float(i % 7), 0.f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } });
+            }
+            boneAnimation.UpdateTimePositions();
+            return boneAnimation;
+        }
+
+        // Rotates a little around the y axis every keyframe.
+        static BoneAnimation NewRotatingBoneAnimation(std::uint32_t numKeyframes, float offset) {
+            BoneAnimation boneAnimation = NewLongBoneAnimation(numKeyframes);
+            for (std::uint32_t i = 0; i < numKeyframes; ++i) {
+                DirectX::XMVECTOR R = DirectX::XMQuaternionRotationRollPitchYaw(0.f, offset + i * 0.05f, 0.f);
+                DirectX::XMStoreFloat4(&boneAnimation.Keyframes[i].RotationQuaternion, R);
+                boneAnimation.Keyframes[i].Scale = { 1.f + i * 0.01f, 1.f, 1.f };
+            }
+            return boneAnimation;
+        }
+
+        // Holds every bone at **translation** and **rotation**.
+        static std::shared_ptr<Animation> NewConstantAnimation(std::uint32_t numBones, DirectX::XMFLOAT3 translation, DirectX::XMFLOAT4 rotation) {
+            auto pConstant = std::make_shared<Animation>("constant");
+            for (std::uint32_t i = 0; i < numBones; ++i) {
+                BoneAnimation boneAnimation;
+                boneAnimation.Keyframes.push_back({ 0.f, translation, { 1.f, 1.f, 1.f }, rotation });
+                boneAnimation.Keyframes.push_back({ 1.f, translation, { 1.f, 1.f, 1.f }, rotation });
+                boneAnimation.UpdateTimePositions();
+                pConstant->GetBoneAnimations().push_back(boneAnimation);
+            }
+            return pConstant;
+        }
+
+        static void ExpectNearMatrix(const DirectX::XMMATRIX& A, const DirectX::XMMATRIX& B, float tolerance = 1e-4f) {
+            DirectX::XMFLOAT4X4 a, b;
+            DirectX::XMStoreFloat4x4(&a, A);
+            DirectX::XMStoreFloat4x4(&b, B);
+            for (std::uint32_t row = 0; row < 4; ++row) {
+                for (std::uint32_t column = 0; column < 4; ++column) {
+                    EXPECT_NEAR(a.m[row][column], b.m[row][column], tolerance);
+                }
+            }
+        }
+};
+
+// ---------------------------------------------------------------- //
+//                          BoneAnimation
+// ---------------------------------------------------------------- //
+
+TEST_F(AnimationTest, BoneAnimation_FindKeyframe_SearchModesAgree) {
+    BoneAnimation boneAnimation = NewLongBoneAnimation(100);
+
+    std::uint32_t cursor = 0;
+    for (float timePosition = -1.f; timePosition < 5.f; timePosition += 0.013f) {
+        std::uint32_t linear = boneAnimation.FindKeyframe(timePosition, KeyframeSearch::Linear);
+        EXPECT_EQ(boneAnimation.FindKeyframe(timePosition, KeyframeSearch::Binary), linear);
+        EXPECT_EQ(boneAnimation.FindKeyframe(timePosition, cursor), linear);
+        EXPECT_LE(linear, boneAnimation.GetNumKeyframes() - 2);
+    }
+}
+
+TEST_F(AnimationTest, BoneAnimation_FindKeyframe_WithStaleTimePositions) {
+    BoneAnimation boneAnimation = NewLongBoneAnimation(10);
+    boneAnimation.Keyframes.push_back({ 1.f });
+
+    EXPECT_EQ(boneAnimation.FindKeyframe(0.95f, KeyframeSearch::Binary), 9u);
+    EXPECT_EQ(boneAnimation.FindKeyframe(0.95f, KeyframeSearch::Binary), boneAnimation.FindKeyframe(0.95f, KeyframeSearch::Linear));
+
+    // Jumping far ahead of the cursor searches the keyframes the stale times don't cover.
+    std::uint32_t cursor = 0;
+    EXPECT_EQ(boneAnimation.FindKeyframe(0.95f, cursor), 9u);
+}
+
+TEST_F(AnimationTest, BoneAnimation_Interpolate_CursorFollowsLoopsAndJumps) {
+    BoneAnimation boneAnimation = NewLongBoneAnimation(300);
+
+    std::uint32_t cursor = 0;
+    for (float timePosition : { 0.5f, 9.f, 2.f, 2.01f, 0.f, 9.9f, 10.5f }) {
+        DirectX::XMMATRIX expected;
+        DirectX::XMMATRIX actual;
+        boneAnimation.Interpolate(timePosition, expected, KeyframeSearch::Linear);
+        boneAnimation.Interpolate(timePosition, actual, cursor);
+        ExpectNearMatrix(actual, expected);
+    }
+}
+
+TEST_F(AnimationTest, BoneAnimation_Interpolate_WithoutKeyframes) {
+    BoneAnimation boneAnimation;
+
+    DirectX::XMMATRIX M;
+    std::uint32_t cursor = 0;
+    EXPECT_NO_THROW(boneAnimation.Interpolate(1.f, M));
+    ExpectNearMatrix(M, DirectX::XMMatrixIdentity());
+    EXPECT_NO_THROW(boneAnimation.Interpolate(1.f, M, cursor));
+    ExpectNearMatrix(M, DirectX::XMMatrixIdentity());
+}
+
+TEST_F(AnimationTest, BoneAnimation_Interpolate_MatchesKeyframes) {
+    BoneAnimation boneAnimation = NewLongBoneAnimation(4);
+
+    DirectX::XMMATRIX M;
+    boneAnimation.Interpolate(1.f / 30.f, M);
+    ExpectNearMatrix(M, DirectX::XMMatrixTranslation(1.f, 1.f, 0.f));
+
+    boneAnimation.Interpolate(1.5f / 30.f, M);
+    ExpectNearMatrix(M, DirectX::XMMatrixTranslation(1.5f, 1.5f, 0.f));
+
+    boneAnimation.Interpolate(100.f, M);
+    ExpectNearMatrix(M, DirectX::XMMatrixTranslation(3.f, 3.f, 0.f));
+}
+
+// ---------------------------------------------------------------- //
+//                          Animation
+// ---------------------------------------------------------------- //
+
+TEST_F(AnimationTest, Interpolate_WithPlaybackCursor) {
+    Bone::TransformArray expected = Bone::MakeArray(pAnimation->GetNumBoneAnimations());
+    Bone::TransformArray actual = Bone::MakeArray(pAnimation->GetNumBoneAnimations());
+
+    PlaybackCursor cursor;
+    EXPECT_NO_THROW(pAnimation->Interpolate(0.f, actual, cursor));
+    EXPECT_EQ(cursor.KeyframeIndices.size(), pAnimation->GetNumBoneAnimations());
+
+    pAnimation->Interpolate(0.f, expected, KeyframeSearch::Linear);
+    for (std::uint32_t i = 0; i < pAnimation->GetNumBoneAnimations(); ++i) {
+        ExpectNearMatrix(actual[i], expected[i]);
+    }
+
+    cursor.Reset();
+    for (std::uint32_t index : cursor.KeyframeIndices) {
+        EXPECT_EQ(index, 0u);
+    }
+}
+
+TEST_F(AnimationTest, Apply_WithMultipleRootsAndChildBeforeParent) {
+    auto pRig = std::make_shared<Model>(pMaterial);
+    pRig->GetBones().push_back({ "child", 1 });
+    pRig->GetBones().push_back({ "root0" });
+    pRig->GetBones().push_back({ "root1" });
+    pRig->MakeBoneMatricesArray(pRig->GetNumBones());
+    pRig->MakeInverseBoneMatricesArray(pRig->GetNumBones());
+
+    Animation animation("rig");
+    DirectX::XMFLOAT3 translations[3] = { { 1.f, 0.f, 0.f }, { 0.f, 2.f, 0.f }, { 0.f, 0.f, 3.f } };
+    for (std::uint32_t i = 0; i < pRig->GetNumBones(); ++i) {
+        pRig->GetInverseBindPoseMatrices()[i] = DirectX::XMMatrixIdentity();
+
+        BoneAnimation boneAnimation;
+        boneAnimation.Keyframes.push_back({ 0.f, translations[i], { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } });
+        animation.GetBoneAnimations().push_back(boneAnimation);
+    }
+
+    PoseBuffer poseBuffer;
+    ASSERT_NO_THROW(animation.Apply(0.f, *pRig, poseBuffer));
+    ExpectNearMatrix(pRig->GetBoneMatrices()[0], DirectX::XMMatrixTranslation(1.f, 2.f, 0.f));
+    ExpectNearMatrix(pRig->GetBoneMatrices()[1], DirectX::XMMatrixTranslation(0.f, 2.f, 0.f));
+    ExpectNearMatrix(pRig->GetBoneMatrices()[2], DirectX::XMMatrixTranslation(0.f, 0.f, 3.f));
+}
+
+TEST_F(AnimationTest, Apply_WithPoseBuffer_MatchesApply) {
+    Bone::TransformArray expected = Bone::MakeArray(pSkinnedModel->GetNumBones());
+    pAnimation->Apply(0.f, *pSkinnedModel);
+    for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+        expected[i] = pSkinnedModel->GetBoneMatrices()[i];
+    }
+
+    PoseBuffer poseBuffer;
+    EXPECT_NO_THROW(pAnimation->Apply(0.f, *pSkinnedModel, poseBuffer));
+    EXPECT_GE(poseBuffer.GetCapacity(), pSkinnedModel->GetNumBones());
+    for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+        ExpectNearMatrix(pSkinnedModel->GetBoneMatrices()[i], expected[i]);
+    }
+}
+
+TEST_F(AnimationTest, Apply_WithPoseBuffer_DoesNotAllocate) {
+    PoseBuffer poseBuffer(pSkinnedModel->GetNumBones());
+    PlaybackCursor cursor;
+    // The first update sizes the cursor.
+    pAnimation->Apply(0.f, *pSkinnedModel, poseBuffer, cursor);
+
+    std::uint64_t numAllocations = NUM_ALLOCATIONS;
+    for (std::uint32_t frame = 0; frame < 100; ++frame) {
+        pAnimation->Apply(frame / 60.f, *pSkinnedModel, poseBuffer, cursor);
+        pAnimation->Apply(frame / 60.f, *pSkinnedModel, poseBuffer);
+    }
+    std::uint64_t steadyStateAllocations = NUM_ALLOCATIONS - numAllocations;
+    EXPECT_EQ(steadyStateAllocations, 0u);
+
+    // Without a pose buffer every update allocates.
+    numAllocations = NUM_ALLOCATIONS;
+    pAnimation->Apply(0.f, *pSkinnedModel);
+    std::uint64_t temporaryAllocations = NUM_ALLOCATIONS - numAllocations;
+    EXPECT_GT(temporaryAllocations, 0u);
+}
+
+TEST_F(AnimationTest, Apply_WithUnchangedPose_SkipsCleanBones) {
+    auto pConstant = NewConstantAnimation(2, { 1.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 1.f });
+    PoseBuffer poseBuffer;
+    pConstant->Apply(0.f, *pSkinnedModel, poseBuffer);
+    EXPECT_EQ(pSkinnedModel->UpdateBoneMatrices(), 0u);
+
+    // A bone matrix that is not recomputed keeps whatever was written to it.
+    pSkinnedModel->GetBoneMatrices()[1] = DirectX::XMMatrixIdentity();
+    pConstant->Apply(0.5f, *pSkinnedModel, poseBuffer);
+    ExpectNearMatrix(pSkinnedModel->GetBoneMatrices()[1], DirectX::XMMatrixIdentity());
+
+    // Moving the root recomputes its child.
+    auto pMoved = NewConstantAnimation(1, { 0.f, 2.f, 0.f }, { 0.f, 0.f, 0.f, 1.f });
+    pMoved->GetBoneAnimations().push_back(pConstant->GetBoneAnimations()[1]);
+    pMoved->Apply(0.f, *pSkinnedModel, poseBuffer);
+    ExpectNearMatrix(pSkinnedModel->GetBoneMatrices()[1], DirectX::XMMatrixTranslation(1.f, 2.f, 0.f));
+}
+
+// ---------------------------------------------------------------- //
+//                          AnimationMixer
+// ---------------------------------------------------------------- //
+
+// Counts how often it is sampled.
+class CountingSampler : public IAnimationSampler {
+    public:
+        void Sample(float timePosition, LocalPose& pose) const override {
+            ++NumSamples;
+            pose.Resize(1);
+            pose.Translations[0] = { 0.f, 0.f, 0.f, 0.f };
+            pose.Scales[0] = { 1.f, 1.f, 1.f, 0.f };
+            pose.RotationQuaternions[0] = { 0.f, 0.f, 0.f, 1.f };
+        }
+
+        mutable std::uint32_t NumSamples = 0;
+};
+
+TEST_F(AnimationTest, AnimationMixer_WithSingleLayer_MatchesApply) {
+    Bone::TransformArray expected = Bone::MakeArray(pSkinnedModel->GetNumBones());
+    pAnimation->Apply(0.5f, *pSkinnedModel);
+    for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+        expected[i] = pSkinnedModel->GetBoneMatrices()[i];
+    }
+
+    AnimationMixer mixer;
+    mixer.AddLayer(pAnimation);
+    mixer.Advance(0.5f);
+
+    PoseBuffer poseBuffer;
+    mixer.Apply(*pSkinnedModel, poseBuffer);
+    for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+        ExpectNearMatrix(pSkinnedModel->GetBoneMatrices()[i], expected[i]);
+    }
+}
+
+TEST_F(AnimationTest, AnimationMixer_CrossFade) {
+    DirectX::XMFLOAT4 quarterTurn;
+    DirectX::XMStoreFloat4(&quarterTurn, DirectX::XMQuaternionRotationRollPitchYaw(0.f, DirectX::XM_PIDIV2, 0.f));
+
+    AnimationMixer mixer;
+    mixer.AddLayer(NewConstantAnimation(2, { 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 1.f }));
+    mixer.AddLayer(NewConstantAnimation(2, { 2.f, 0.f, 0.f }, quarterTurn), 0.5f);
+
+    LocalPose pose;
+    mixer.Blend(2, pose);
+    ASSERT_EQ(pose.GetNumBones(), 2u);
+
+    DirectX::XMVECTOR expected = DirectX::XMQuaternionRotationRollPitchYaw(0.f, DirectX::XM_PIDIV4, 0.f);
+    for (std::uint32_t i = 0; i < pose.GetNumBones(); ++i) {
+        EXPECT_FLOAT_EQ(pose.Translations[i].x, 1.f);
+        float dot = DirectX::XMVectorGetX(DirectX::XMQuaternionDot(DirectX::XMLoadFloat4A(&pose.RotationQuaternions[i]), expected));
+        EXPECT_NEAR(std::fabs(dot), 1.f, 1e-5f);
+    }
+}
+
+TEST_F(AnimationTest, AnimationMixer_WithBoneMask) {
+    AnimationMixer mixer;
+    mixer.AddLayer(NewConstantAnimation(2, { 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 1.f }));
+    mixer.AddLayer(NewConstantAnimation(2, { 2.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 1.f }), 1.f, AnimationMixer::MakeBoneMask(*pSkinnedModel, 1));
+
+    LocalPose pose;
+    mixer.Blend(pSkinnedModel->GetNumBones(), pose);
+    EXPECT_FLOAT_EQ(pose.Translations[0].x, 0.f);
+    EXPECT_FLOAT_EQ(pose.Translations[1].x, 2.f);
+}
+
+TEST_F(AnimationTest, AnimationMixer_MakeBoneMask) {
+    EXPECT_EQ(AnimationMixer::MakeBoneMask(*pSkinnedModel, 0), std::vector<float>({ 1.f, 1.f }));
+    EXPECT_EQ(AnimationMixer::MakeBoneMask(*pSkinnedModel, 1), std::vector<float>({ 0.f, 1.f }));
+    EXPECT_THROW(AnimationMixer::MakeBoneMask(*pSkinnedModel, 2), std::out_of_range);
+}
+
+TEST_F(AnimationTest, AnimationMixer_SkipsHiddenLayers) {
+    auto pHidden = std::make_shared<CountingSampler>();
+    auto pDisabled = std::make_shared<CountingSampler>();
+    auto pVisible = std::make_shared<CountingSampler>();
+
+    AnimationMixer mixer;
+    mixer.AddLayer(pHidden);
+    mixer.AddLayer(pVisible);
+    mixer.AddLayer(pDisabled, 0.f);
+
+    LocalPose pose;
+    mixer.Blend(1, pose);
+    EXPECT_EQ(pHidden->NumSamples, 0u);
+    EXPECT_EQ(pDisabled->NumSamples, 0u);
+    EXPECT_EQ(pVisible->NumSamples, 1u);
+}
+
+TEST_F(AnimationTest, AnimationMixer_WithoutLayers_ResultsInIdentity) {
+    AnimationMixer mixer;
+    PoseBuffer poseBuffer;
+    mixer.Apply(*pSkinnedModel, poseBuffer);
+    for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+        ExpectNearMatrix(pSkinnedModel->GetBoneMatrices()[i], DirectX::XMMatrixIdentity());
+    }
+}
+
+TEST_F(AnimationTest, AnimationMixer_Apply_DoesNotAllocate) {
+    AnimationMixer mixer;
+    mixer.AddLayer(pAnimation);
+    mixer.AddLayer(NewConstantAnimation(2, { 2.f, 0.f, 0.f }, { 0.f, 0.f, 0.f, 1.f }), 0.5f, AnimationMixer::MakeBoneMask(*pSkinnedModel, 1));
+
+    PoseBuffer poseBuffer;
+    mixer.Apply(*pSkinnedModel, poseBuffer);
+
+    std::uint64_t numAllocations = NUM_ALLOCATIONS;
+    for (std::uint32_t frame = 0; frame < 100; ++frame) {
+        mixer.Advance(1.f / 60.f);
+        mixer.Apply(*pSkinnedModel, poseBuffer);
+    }
+    std::uint64_t steadyStateAllocations = NUM_ALLOCATIONS - numAllocations;
+    EXPECT_EQ(steadyStateAllocations, 0u);
+}
+
+// ---------------------------------------------------------------- //
+//                          CompiledAnimation
+// ---------------------------------------------------------------- //
+
+TEST_F(AnimationTest, CompiledAnimation_MatchesAnimation) {
+    static constexpr std::uint32_t NUM_BONES = 7;
+
+    Animation animation("compiled");
+    for (std::uint32_t i = 0; i < NUM_BONES; ++i) {
+        animation.GetBoneAnimations().push_back(NewRotatingBoneAnimation(60, i * 0.5f));
+    }
+    // Bones without keyframes are held at the identity.
+    animation.GetBoneAnimations().push_back({});
+
+    CompiledAnimation compiled(animation);
+    EXPECT_EQ(compiled.GetNumBones(), NUM_BONES + 1);
+    EXPECT_FLOAT_EQ(compiled.GetStartTime(), 0.f);
+    EXPECT_FLOAT_EQ(compiled.GetEndTime(), 59.f / 30.f);
+
+    Bone::TransformArray expected = Bone::MakeArray(animation.GetNumBoneAnimations());
+    Bone::TransformArray actual = Bone::MakeArray(animation.GetNumBoneAnimations());
+    LocalPose pose;
+    for (float timePosition = -0.5f; timePosition < 2.5f; timePosition += 0.01f) {
+        animation.Interpolate(timePosition, expected);
+        compiled.Interpolate(timePosition, pose, actual);
+        for (std::uint32_t i = 0; i < animation.GetNumBoneAnimations(); ++i) {
+            ExpectNearMatrix(actual[i], expected[i]);
+        }
+    }
+}
+
+TEST_F(AnimationTest, CompiledAnimation_MatchesAnimation_NearEnd) {
+    // A duration that isn't a multiple of the frame spacing.
+    BoneAnimation boneAnimation;
+    boneAnimation.Keyframes.push_back({ 0.f, { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } });
+    boneAnimation.Keyframes.push_back({ 1.05f, { 1.05f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } });
+    boneAnimation.UpdateTimePositions();
+
+    Animation animation("tail");
+    animation.GetBoneAnimations().push_back(boneAnimation);
+
+    CompiledAnimation compiled(animation, 10.f);
+    EXPECT_EQ(compiled.GetNumFrames(), 12);
+    EXPECT_GE(compiled.GetSampleRate(), 10.f);
+
+    Bone::TransformArray expected = Bone::MakeArray(1);
+    Bone::TransformArray actual = Bone::MakeArray(1);
+    LocalPose pose;
+    for (float timePosition : { 1.f, 1.02f, 1.04f, 1.049f, 1.05f }) {
+        animation.Interpolate(timePosition, expected);
+        compiled.Interpolate(timePosition, pose, actual);
+        ExpectNearMatrix(actual[0], expected[0]);
+    }
+}
+
+TEST_F(AnimationTest, CompiledAnimation_WithInvalidSampleRate) {
+    EXPECT_THROW(CompiledAnimation(*pAnimation, 0.f), std::invalid_argument);
+}
+
+TEST_F(AnimationTest, DISABLED_Benchmark_CompiledAnimation) {
+    static constexpr std::uint32_t NUM_BONES = 200;
+    static constexpr std::uint32_t NUM_KEYFRAMES = 300;
+    static constexpr std::uint32_t NUM_FRAMES = 600;
+
+    Animation animation("benchmark");
+    for (std::uint32_t i = 0; i < NUM_BONES; ++i) {
+        animation.GetBoneAnimations().push_back(NewRotatingBoneAnimation(NUM_KEYFRAMES, i * 0.1f));
+    }
+    CompiledAnimation compiled(animation);
+
+    Bone::TransformArray transforms = Bone::MakeArray(NUM_BONES);
+    LocalPose pose;
+    PlaybackCursor cursor;
+
+    auto time = [&](auto&& sample) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t frame = 0; frame < NUM_FRAMES; ++frame) {
+            sample(frame / 60.f);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto keyframes = time([&](float timePosition) { animation.Interpolate(timePosition, transforms, cursor); });
+    auto sampled = time([&](float timePosition) { compiled.Sample(timePosition, pose); });
+    auto matrices = time([&](float timePosition) { compiled.Interpolate(timePosition, pose, transforms); });
+
+    RecordProperty("Keyframes_us", std::to_string(keyframes));
+    RecordProperty("Compiled_Sample_us", std::to_string(sampled));
+    RecordProperty("Compiled_Matrices_us", std::to_string(matrices));
+}
+
+// ---------------------------------------------------------------- //
+//                          CompressedAnimation
+// ---------------------------------------------------------------- //
+
+TEST_F(AnimationTest, CompressedAnimation_MatchesAnimation) {
+    static constexpr std::uint32_t NUM_BONES = 5;
+
+    Animation animation("compressed");
+    for (std::uint32_t i = 0; i < NUM_BONES; ++i) {
+        animation.GetBoneAnimations().push_back(NewRotatingBoneAnimation(60, i * 0.5f));
+    }
+    animation.GetBoneAnimations().push_back({});
+
+    CompressedAnimation compressed(animation);
+    ASSERT_EQ(compressed.GetNumBoneAnimations(), NUM_BONES + 1);
+
+    Bone::TransformArray expected = Bone::MakeArray(animation.GetNumBoneAnimations());
+    Bone::TransformArray actual = Bone::MakeArray(animation.GetNumBoneAnimations());
+    for (float timePosition = -0.5f; timePosition < 2.5f; timePosition += 0.01f) {
+        animation.Interpolate(timePosition, expected);
+        compressed.Interpolate(timePosition, actual);
+        for (std::uint32_t i = 0; i < NUM_BONES; ++i) {
+            // Tolerance of the reduction plus the error of the quantized values and times.
+            ExpectNearMatrix(actual[i], expected[i], 5e-3f);
+        }
+        ExpectNearMatrix(actual[NUM_BONES], DirectX::XMMatrixIdentity());
+    }
+}
+
+TEST_F(AnimationTest, CompressedAnimation_RemovesRedundantKeys) {
+    static constexpr std::uint32_t NUM_KEYFRAMES = 60;
+
+    Animation animation("compressed");
+    animation.GetBoneAnimations().push_back(NewLongBoneAnimation(NUM_KEYFRAMES));
+
+    CompressedAnimation compressed(animation);
+    const std::vector<CompressedTrack>& tracks = compressed.GetTracks();
+    ASSERT_EQ(tracks.size(), CompressedAnimation::NUM_TRACKS);
+
+    // Only the kinks of the saw tooth on the y axis are kept.
+    EXPECT_LT(tracks[CompressedAnimation::Translation].NumKeys, NUM_KEYFRAMES / 2);
+    EXPECT_EQ(tracks[CompressedAnimation::Scale].NumKeys, 1u);
+    EXPECT_EQ(tracks[CompressedAnimation::Rotation].NumKeys, 1u);
+    EXPECT_LT(compressed.GetSizeInBytes() * 4, sizeof(Keyframe) * NUM_KEYFRAMES);
+
+    Bone::TransformArray expected = Bone::MakeArray(1);
+    Bone::TransformArray actual = Bone::MakeArray(1);
+    for (std::uint32_t i = 0; i < NUM_KEYFRAMES; ++i) {
+        animation.Interpolate(i / 30.f, expected);
+        compressed.Interpolate(i / 30.f, actual);
+        ExpectNearMatrix(actual[0], expected[0], 5e-3f);
+    }
+}
+
+TEST_F(AnimationTest, CompressedAnimation_WithTracksPastTheData) {
+    std::vector<CompressedTrack> tracks(CompressedAnimation::NUM_TRACKS);
+    tracks[CompressedAnimation::Translation].NumKeys = 2;
+
+    EXPECT_THROW(CompressedAnimation("invalid", 0.f, 1.f, tracks, {}), std::invalid_argument);
+}
+
+// ---------------------------------------------------------------- //
+//                          BakedAnimation
+// ---------------------------------------------------------------- //
+
+TEST_F(AnimationTest, BakedAnimation_MatchesApply) {
+    Animation rotating("rotating");
+    rotating.GetBoneAnimations().push_back(NewRotatingBoneAnimation(30, 0.f));
+    rotating.GetBoneAnimations().push_back(NewRotatingBoneAnimation(30, 0.5f));
+
+    BakedAnimation baked(rotating, *pSkinnedModel, 30.f, { 0.f, 0.f, 0.f });
+    EXPECT_EQ(baked.GetNumFrames(), 30u);
+    EXPECT_EQ(baked.GetNumBones(), pSkinnedModel->GetNumBones());
+
+    // Frames land on the keyframes and the frames in between are lerped.
+    Bone::TransformArray expected = Bone::MakeArray(pSkinnedModel->GetNumBones());
+    for (float timePosition : { 0.f, 7.f / 30.f, 7.5f / 30.f, 29.f / 30.f }) {
+        rotating.Apply(timePosition, *pSkinnedModel);
+        for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+            expected[i] = pSkinnedModel->GetBoneMatrices()[i];
+        }
+
+        baked.Apply(timePosition, *pSkinnedModel);
+        for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+            ExpectNearMatrix(pSkinnedModel->GetBoneMatrices()[i], expected[i], 1e-2f);
+        }
+    }
+}
+
+TEST_F(AnimationTest, BakedAnimation_ExtractsRootMotion) {
+    // The root moves 1 along x and up to 6 along y every keyframe.
+    Animation walking("walking");
+    walking.GetBoneAnimations().push_back(NewLongBoneAnimation(30));
+    walking.GetBoneAnimations().push_back(NewLongBoneAnimation(1));
+
+    BakedAnimation baked(walking, *pSkinnedModel, 30.f, { 1.f, 0.f, 1.f });
+    baked.Apply(10.f / 30.f, *pSkinnedModel);
+
+    DirectX::XMFLOAT4X4 root;
+    DirectX::XMStoreFloat4x4(&root, pSkinnedModel->GetBoneMatrices()[0]);
+    EXPECT_NEAR(root._41, 0.f, 1e-4f);
+    EXPECT_NEAR(root._42, 3.f, 1e-4f);
+
+    EXPECT_NEAR(DirectX::XMVectorGetX(baked.GetRootMotion(10.f / 30.f)), 10.f, 1e-4f);
+    EXPECT_NEAR(DirectX::XMVectorGetY(baked.GetRootMotion(10.f / 30.f)), 0.f, 1e-4f);
+    // Wraps around the end of the clip.
+    EXPECT_NEAR(DirectX::XMVectorGetX(baked.GetRootMotionDelta(28.f / 30.f, 1.f / 30.f)), 2.f, 1e-4f);
+}
+
+TEST_F(AnimationTest, BakedAnimation_RootMotionNearEnd) {
+    // The root moves along x at a constant speed for a duration that isn't a multiple of the frame spacing.
+    BoneAnimation root;
+    root.Keyframes.push_back({ 0.f, { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } });
+    root.Keyframes.push_back({ 1.05f, { 1.05f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } });
+    root.UpdateTimePositions();
+
+    Animation walking("walking");
+    walking.GetBoneAnimations().push_back(root);
+    walking.GetBoneAnimations().push_back(NewLongBoneAnimation(1));
+
+    BakedAnimation baked(walking, *pSkinnedModel, 10.f, { 1.f, 0.f, 1.f });
+    EXPECT_EQ(baked.GetNumFrames(), 12u);
+    EXPECT_GE(baked.GetSampleRate(), 10.f);
+    for (float timePosition : { 1.f, 1.02f, 1.04f, 1.05f }) {
+        EXPECT_NEAR(DirectX::XMVectorGetX(baked.GetRootMotion(timePosition)), timePosition, 1e-4f);
+    }
+}
+
+TEST_F(AnimationTest, BakedAnimation_WithEmptyTrailingBoneAnimation) {
+    Animation rotating("rotating");
+    rotating.GetBoneAnimations().push_back(NewRotatingBoneAnimation(30, 0.f));
+    // Bones without a channel are left empty by the importer.
+    rotating.GetBoneAnimations().push_back({});
+    EXPECT_FLOAT_EQ(rotating.GetStartTime(), 0.f);
+    EXPECT_FLOAT_EQ(rotating.GetEndTime(), 29.f / 30.f);
+
+    BakedAnimation baked(rotating, *pSkinnedModel, 30.f, { 0.f, 0.f, 0.f });
+    EXPECT_FLOAT_EQ(baked.GetEndTime(), 29.f / 30.f);
+
+    Bone::TransformArray expected = Bone::MakeArray(pSkinnedModel->GetNumBones());
+    rotating.Apply(0.5f, *pSkinnedModel);
+    for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+        expected[i] = pSkinnedModel->GetBoneMatrices()[i];
+    }
+    baked.Apply(0.5f, *pSkinnedModel);
+    for (std::uint32_t i = 0; i < pSkinnedModel->GetNumBones(); ++i) {
+        ExpectNearMatrix(pSkinnedModel->GetBoneMatrices()[i], expected[i], 1e-2f);
+    }
+}
+
+TEST_F(AnimationTest, BakedAnimation_WithOtherSkeleton) {
+    BakedAnimation baked(*pAnimation, *pSkinnedModel);
+
+    auto pRig = std::make_shared<Model>(pMaterial);
+    pRig->GetBones().push_back({ "root" });
+    pRig->MakeBoneMatricesArray(1);
+    EXPECT_THROW(baked.Apply(0.f, *pRig), std::invalid_argument);
+}
+
+// Samples 10 seconds of a long clip with every keyframe search.
+// The timings are written to the test report as properties.
+TEST_F(AnimationTest, DISABLED_Benchmark_KeyframeSearch) {
+    static constexpr std::uint32_t NUM_BONES = 200;
+    static constexpr std::uint32_t NUM_KEYFRAMES = 5000;
+    static constexpr std::uint32_t NUM_FRAMES = 600;
+    static constexpr float FRAME_TIME = 1.f / 60.f;
+    // Starts halfway the clip, the linear search has to scan half of the keyframes.
+    static constexpr float START_TIME = NUM_KEYFRAMES / 60.f;
+
+    Animation animation("benchmark");
+    animation.GetBoneAnimations().resize(NUM_BONES, NewLongBoneAnimation(NUM_KEYFRAMES));
+    Bone::TransformArray transforms = Bone::MakeArray(NUM_BONES);
+
+    auto time = [&](auto&& sample) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t frame = 0; frame < NUM_FRAMES; ++frame) {
+            sample(START_TIME + frame * FRAME_TIME);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto linear = time([&](float timePosition) { animation.Interpolate(timePosition, transforms, KeyframeSearch::Linear); });
+    auto binary = time([&](float timePosition) { animation.Interpolate(timePosition, transforms, KeyframeSearch::Binary); });
+
+    PlaybackCursor cursor;
+    auto cursored = time([&](float timePosition) { animation.Interpolate(timePosition, transforms, cursor); });
+
+    RecordProperty("Linear_us", std::to_string(linear));
+    RecordProperty("Binary_us", std::to_string(binary));
+    RecordProperty("Cursor_us", std::to_string(cursored));
+}
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <thread>
 
 #include <RoX/AssetIO.h>
+#include <RoX/MeshFactory.h>
 
+#include "../PredefinedObjects/SyntheticScene.h"
 #include "../PredefinedObjects/ValidModel.h"
 #include "../PredefinedObjects/ValidAnimation.h"
 
@@ -11,6 +17,7 @@ class AssetIOTest : public testing::Test, public ValidModel,  public ValidAnimat
     protected:
         static constexpr const char* MODL_NAME = "modl.roxmodl";
         static constexpr const char* ANIM_NAME = "anim.roxanim";
+        static constexpr const char* SCENE_NAME = "scene.assbin";
 
     protected:
         AssetIOTest() {
@@ -19,6 +26,7 @@ class AssetIOTest : public testing::Test, public ValidModel,  public ValidAnimat
         ~AssetIOTest() {
             std::filesystem::remove(MODL_NAME);
             std::filesystem::remove(ANIM_NAME);
+            std::filesystem::remove(SCENE_NAME);
         }
 };
 
@@ -26,6 +34,24 @@ TEST_F(AssetIOTest, ExportRoXModl_WithValidModel) {
     EXPECT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
 }
 
+TEST_F(AssetIOTest, ExportRoXModl_KeepsGeometryReleased) {
+    std::uint32_t numVertices = pModel->GetNumVertices();
+    ASSERT_NO_THROW(pModel->UseStaticBuffers(true));
+    ASSERT_NO_THROW(pModel->SetResidency(GeometryResidency::KeepCompressedCopy));
+    for (std::shared_ptr<IMesh>& pIMesh : pModel->GetMeshes()) {
+        ASSERT_NO_THROW(pIMesh->ApplyResidency());
+    }
+
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+    for (std::shared_ptr<IMesh>& pIMesh : pModel->GetMeshes()) {
+        EXPECT_TRUE(pIMesh->IsGeometryReleased());
+    }
+
+    std::shared_ptr<Model> pImport;
+    ASSERT_NO_THROW(pImport = AssetIO::ImportRoXModl(MODL_NAME, pMaterial));
+    EXPECT_EQ(pImport->GetNumVertices(), numVertices);
+}
+
 TEST_F(AssetIOTest, ImportRoXModl_WithValidModel_ExportedWithExportRoXModl) {
     EXPECT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
 
@@ -65,6 +91,411 @@ TEST_F(AssetIOTest, ImportRoXModl_WithValidModel_ExportedWithExportRoXModl) {
     }
 }
 
+TEST_F(AssetIOTest, ImportRoXModl_MemoryMapped_MatchesStream) {
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+
+    std::shared_ptr<Model> pStreamed;
+    std::shared_ptr<Model> pMapped;
+    ASSERT_NO_THROW(pStreamed = AssetIO::ImportRoXModl(MODL_NAME, pMaterial, AssetIO::ReadMode::Stream));
+    ASSERT_NO_THROW(pMapped = AssetIO::ImportRoXModl(MODL_NAME, pMaterial, AssetIO::ReadMode::MemoryMapped));
+
+    EXPECT_EQ(pMapped->GetName(), pStreamed->GetName());
+    EXPECT_EQ(pMapped->GetNumBones(), pStreamed->GetNumBones());
+    ASSERT_EQ(pMapped->GetNumMeshes(), pStreamed->GetNumMeshes());
+    for (std::uint32_t i = 0; i < pMapped->GetNumMeshes(); ++i) {
+        std::shared_ptr<IMesh>& pStreamedMesh = pStreamed->GetMeshes()[i];
+        std::shared_ptr<IMesh>& pMappedMesh = pMapped->GetMeshes()[i];
+
+        EXPECT_EQ(pMappedMesh->GetName(), pStreamedMesh->GetName());
+        EXPECT_EQ(pMappedMesh->GetIndices(), pStreamedMesh->GetIndices());
+        EXPECT_EQ(pMappedMesh->GetNumVertices(), pStreamedMesh->GetNumVertices());
+        EXPECT_EQ(pMappedMesh->GetNumSubmeshes(), pStreamedMesh->GetNumSubmeshes());
+    }
+}
+
+TEST_F(AssetIOTest, ExportRoXModl_WritesVersion2) {
+    pModel->GetMeshes()[0]->SetBoneIndex(1);
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+
+    std::ifstream fin(MODL_NAME, std::ios::binary);
+    std::uint16_t version = 0;
+    std::uint16_t numChunks = 0;
+    fin.read(reinterpret_cast<char*>(&version), sizeof(std::uint16_t));
+    fin.read(reinterpret_cast<char*>(&numChunks), sizeof(std::uint16_t));
+    fin.close();
+    EXPECT_EQ(version, 2);
+    EXPECT_GT(numChunks, 0);
+
+    std::shared_ptr<Model> pImport;
+    ASSERT_NO_THROW(pImport = AssetIO::ImportRoXModl(MODL_NAME, pMaterial));
+    EXPECT_EQ(pImport->GetMeshes()[0]->GetBoneIndex(), 1);
+}
+
+TEST_F(AssetIOTest, ImportRoXModl_Compressed_MatchesUncompressed) {
+    static constexpr const char* COMPRESSED_NAME = "compressed.roxmodl";
+
+    MeshFactory::AddSphere(*pMesh, 1.f, 32);
+    MeshFactory::AddTorus(*pSkinnedMesh, 1.f, 0.333f, 32);
+    pModel->Add(pSkinnedMesh);
+
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, COMPRESSED_NAME, true));
+    EXPECT_LT(std::filesystem::file_size(COMPRESSED_NAME), std::filesystem::file_size(MODL_NAME));
+
+    std::shared_ptr<Model> pImport;
+    ASSERT_NO_THROW(pImport = AssetIO::ImportRoXModl(COMPRESSED_NAME, pMaterial, AssetIO::ReadMode::MemoryMapped));
+    std::filesystem::remove(COMPRESSED_NAME);
+
+    ASSERT_EQ(pImport->GetNumMeshes(), pModel->GetNumMeshes());
+    EXPECT_EQ(pImport->GetMeshes()[0]->GetIndices(), pMesh->GetIndices());
+    EXPECT_EQ(pImport->GetMeshes()[1]->GetIndices(), pSkinnedMesh->GetIndices());
+
+    auto pImportMesh = std::dynamic_pointer_cast<Mesh>(pImport->GetMeshes()[0]);
+    ASSERT_NE(pImportMesh, nullptr);
+    ASSERT_EQ(pImportMesh->GetNumVertices(), pMesh->GetNumVertices());
+    EXPECT_EQ(memcmp(pImportMesh->GetVertices().data(), pMesh->GetVertices().data(), sizeof(VertexPositionNormalTexture) * pMesh->GetNumVertices()), 0);
+
+    auto pImportSkinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(pImport->GetMeshes()[1]);
+    ASSERT_NE(pImportSkinnedMesh, nullptr);
+    ASSERT_EQ(pImportSkinnedMesh->GetNumVertices(), pSkinnedMesh->GetNumVertices());
+    EXPECT_EQ(memcmp(pImportSkinnedMesh->GetVertices().data(), pSkinnedMesh->GetVertices().data(), sizeof(VertexPositionNormalTextureSkinning) * pSkinnedMesh->GetNumVertices()), 0);
+}
+
+TEST_F(AssetIOTest, ImportRoXModl_Quantized_MatchesWithinPrecision) {
+    static constexpr const char* QUANTIZED_NAME = "quantized.roxmodl";
+
+    MeshFactory::AddSphere(*pMesh, 1.f, 32);
+    MeshFactory::AddTorus(*pSkinnedMesh, 1.f, 0.333f, 32);
+    pModel->Add(pSkinnedMesh);
+
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, QUANTIZED_NAME, true, true));
+    EXPECT_LT(std::filesystem::file_size(QUANTIZED_NAME), std::filesystem::file_size(MODL_NAME));
+
+    for (AssetIO::ReadMode mode : { AssetIO::ReadMode::MemoryMapped, AssetIO::ReadMode::DeferredGeometry }) {
+        std::shared_ptr<Model> pImport;
+        ASSERT_NO_THROW(pImport = AssetIO::ImportRoXModl(QUANTIZED_NAME, pMaterial, mode));
+        ASSERT_NO_THROW(pImport->RequireGeometry());
+        ASSERT_EQ(pImport->GetNumMeshes(), pModel->GetNumMeshes());
+        EXPECT_EQ(pImport->GetMeshes()[1]->GetIndices(), pSkinnedMesh->GetIndices());
+
+        auto pImportMesh = std::dynamic_pointer_cast<Mesh>(pImport->GetMeshes()[0]);
+        ASSERT_NE(pImportMesh, nullptr);
+        ASSERT_EQ(pImportMesh->GetNumVertices(), pMesh->GetNumVertices());
+        for (std::uint32_t i = 0; i < pMesh->GetNumVertices(); ++i) {
+            EXPECT_NEAR(pImportMesh->GetVertices()[i].position.x, pMesh->GetVertices()[i].position.x, 1e-4f);
+            EXPECT_NEAR(pImportMesh->GetVertices()[i].normal.y, pMesh->GetVertices()[i].normal.y, 1e-3f);
+            EXPECT_NEAR(pImportMesh->GetVertices()[i].textureCoordinate.x, pMesh->GetVertices()[i].textureCoordinate.x, 1e-3f);
+        }
+
+        auto pImportSkinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(pImport->GetMeshes()[1]);
+        ASSERT_NE(pImportSkinnedMesh, nullptr);
+        ASSERT_EQ(pImportSkinnedMesh->GetNumVertices(), pSkinnedMesh->GetNumVertices());
+        for (std::uint32_t i = 0; i < pSkinnedMesh->GetNumVertices(); ++i) {
+            EXPECT_NEAR(pImportSkinnedMesh->GetVertices()[i].position.z, pSkinnedMesh->GetVertices()[i].position.z, 1e-4f);
+            EXPECT_EQ(pImportSkinnedMesh->GetVertices()[i].indices, pSkinnedMesh->GetVertices()[i].indices);
+        }
+    }
+    std::filesystem::remove(QUANTIZED_NAME);
+}
+
+TEST_F(AssetIOTest, ImportRoXModl_With32BitIndices) {
+    static constexpr const char* COMPRESSED_NAME = "compressed.roxmodl";
+    static constexpr std::uint32_t NUM_VERTICES = 100000;
+
+    auto pLargeMesh = std::make_shared<Mesh>("large");
+    pLargeMesh->GetVertices().resize(NUM_VERTICES);
+    for (std::uint32_t i = 0; i + 2 < NUM_VERTICES; i += 3) {
+        pLargeMesh->GetVertices()[i].position = { float(i), 0.f, 0.f };
+        std::uint32_t triangle[] = { i, i + 1, i + 2 };
+        pLargeMesh->AppendIndices(triangle, 3);
+    }
+    ASSERT_EQ(pLargeMesh->GetIndexSizeInBytes(), 4);
+
+    auto pSubmesh = std::make_unique<Submesh>("large_submesh", 0);
+    pSubmesh->SetIndexCount(pLargeMesh->GetNumIndices());
+    pLargeMesh->Add(std::move(pSubmesh));
+    pModel->Add(pLargeMesh);
+
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, COMPRESSED_NAME, true));
+
+    for (const char* filePath : { MODL_NAME, COMPRESSED_NAME }) {
+        std::shared_ptr<Model> pImport;
+        ASSERT_NO_THROW(pImport = AssetIO::ImportRoXModl(filePath, pMaterial, AssetIO::ReadMode::MemoryMapped));
+        ASSERT_EQ(pImport->GetNumMeshes(), pModel->GetNumMeshes());
+
+        EXPECT_EQ(pImport->GetMeshes()[0]->GetIndexSizeInBytes(), 2);
+        EXPECT_EQ(pImport->GetMeshes()[0]->GetIndices(), pMesh->GetIndices());
+
+        std::shared_ptr<IMesh>& pImportMesh = pImport->GetMeshes().back();
+        EXPECT_EQ(pImportMesh->GetIndexSizeInBytes(), 4);
+        EXPECT_TRUE(pImportMesh->GetIndices().empty());
+        EXPECT_EQ(pImportMesh->GetWideIndices(), pLargeMesh->GetWideIndices());
+    }
+    std::filesystem::remove(COMPRESSED_NAME);
+}
+
+TEST_F(AssetIOTest, ImportRoXModl_DeferredGeometry_LoadsOnDemand) {
+    MeshFactory::AddSphere(*pMesh, 1.f, 32);
+    MeshFactory::AddTorus(*pSkinnedMesh, 1.f, 0.333f, 32);
+    pModel->Add(pSkinnedMesh);
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME, true));
+
+    std::shared_ptr<Model> pImport;
+    ASSERT_NO_THROW(pImport = AssetIO::ImportRoXModl(MODL_NAME, pMaterial, AssetIO::ReadMode::DeferredGeometry));
+    ASSERT_EQ(pImport->GetNumMeshes(), pModel->GetNumMeshes());
+    EXPECT_EQ(pImport->GetNumBones(), pModel->GetNumBones());
+    EXPECT_EQ(pImport->GetNumSubmeshes(), pModel->GetNumSubmeshes());
+    EXPECT_FALSE(pImport->IsGeometryResident());
+
+    for (std::uint32_t i = 0; i < pImport->GetNumMeshes(); ++i) {
+        std::shared_ptr<IMesh>& pImportMesh = pImport->GetMeshes()[i];
+        EXPECT_FALSE(pImportMesh->IsGeometryResident());
+        EXPECT_TRUE(pImportMesh->GetIndices().empty());
+        EXPECT_EQ(pImportMesh->GetNumIndices(), pModel->GetMeshes()[i]->GetNumIndices());
+        EXPECT_EQ(pImportMesh->GetNumVertices(), pModel->GetMeshes()[i]->GetNumVertices());
+    }
+
+    // Loading a single mesh leaves the others deferred.
+    ASSERT_NO_THROW(pImport->GetMeshes()[0]->UpdateBuffers());
+    EXPECT_TRUE(pImport->GetMeshes()[0]->IsGeometryResident());
+    EXPECT_FALSE(pImport->GetMeshes()[1]->IsGeometryResident());
+    EXPECT_EQ(pImport->GetMeshes()[0]->GetIndices(), pMesh->GetIndices());
+
+    ASSERT_NO_THROW(pImport->RequireGeometry());
+    EXPECT_TRUE(pImport->IsGeometryResident());
+    EXPECT_EQ(pImport->GetMeshes()[1]->GetIndices(), pSkinnedMesh->GetIndices());
+
+    auto pImportSkinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(pImport->GetMeshes()[1]);
+    ASSERT_NE(pImportSkinnedMesh, nullptr);
+    ASSERT_EQ(pImportSkinnedMesh->GetNumVertices(), pSkinnedMesh->GetNumVertices());
+    EXPECT_EQ(memcmp(pImportSkinnedMesh->GetVertices().data(), pSkinnedMesh->GetVertices().data(), sizeof(VertexPositionNormalTextureSkinning) * pSkinnedMesh->GetNumVertices()), 0);
+}
+
+TEST_F(AssetIOTest, ImportRoXModl_DeferredGeometry_KeepsBounds) {
+    MeshFactory::AddSphere(*pMesh, 2.f, 16);
+    DirectX::XMMATRIX M = DirectX::XMMatrixTranslation(1.f, 2.f, 3.f);
+    pModel->TransformVertices(M);
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME, true));
+
+    std::shared_ptr<Model> pImport;
+    ASSERT_NO_THROW(pImport = AssetIO::ImportRoXModl(MODL_NAME, pMaterial, AssetIO::ReadMode::DeferredGeometry));
+    EXPECT_FALSE(pImport->IsGeometryResident());
+
+    const std::unique_ptr<Submesh>& pSubmesh = pMesh->GetSubmeshes()[1];
+    const std::unique_ptr<Submesh>& pImportSubmesh = pImport->GetMeshes()[0]->GetSubmeshes()[1];
+    EXPECT_EQ(memcmp(&pImportSubmesh->GetBoundingBox(), &pSubmesh->GetBoundingBox(), sizeof(DirectX::BoundingBox)), 0);
+    EXPECT_EQ(memcmp(&pImportSubmesh->GetBoundingSphere(), &pSubmesh->GetBoundingSphere(), sizeof(DirectX::BoundingSphere)), 0);
+    EXPECT_NEAR(pImport->GetBoundingBox().Center.y, 2.f, 1e-5f);
+    EXPECT_NEAR(pImport->GetBoundingSphere().Radius, pModel->GetBoundingSphere().Radius, 1e-5f);
+}
+
+TEST_F(AssetIOTest, ImportRoXModl_WithMissingFile) {
+    EXPECT_THROW(AssetIO::ImportRoXModl("missing.roxmodl", pMaterial, AssetIO::ReadMode::Stream), std::runtime_error);
+    EXPECT_THROW(AssetIO::ImportRoXModl("missing.roxmodl", pMaterial, AssetIO::ReadMode::MemoryMapped), std::runtime_error);
+    EXPECT_THROW(AssetIO::ImportRoXModl("missing.roxmodl", pMaterial, AssetIO::ReadMode::DeferredGeometry), std::runtime_error);
+}
+
+TEST_F(AssetIOTest, AsyncImporter_ImportRoXModls_MatchesSynchronousImport) {
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+
+    AssetIO::AsyncImporter importer(2);
+    EXPECT_EQ(importer.GetNumThreads(), 2u);
+
+    auto futures = importer.ImportRoXModls({ MODL_NAME, MODL_NAME, MODL_NAME }, pMaterial);
+    ASSERT_EQ(futures.size(), 3u);
+    for (auto& future : futures) {
+        std::shared_ptr<Model> pImport;
+        ASSERT_NO_THROW(pImport = future.get());
+        EXPECT_EQ(pImport->GetName(), pModel->GetName());
+        EXPECT_EQ(pImport->GetNumMeshes(), pModel->GetNumMeshes());
+    }
+}
+
+TEST_F(AssetIOTest, AsyncImporter_ImportRoXModl_WithMissingFile) {
+    AssetIO::AsyncImporter importer(1);
+    EXPECT_THROW(importer.ImportRoXModl("missing.roxmodl", pMaterial).get(), std::runtime_error);
+}
+
+TEST_F(AssetIOTest, AsyncImporter_OnCompleted_RunsOnDispatchingThread) {
+    ASSERT_NO_THROW(AssetIO::ExportRoXAnim(pAnimation, ANIM_NAME));
+
+    AssetIO::AsyncImporter importer(1);
+    std::thread::id callbackThread;
+    std::shared_ptr<Animation> pImport;
+    importer.OnCompleted<std::shared_ptr<Animation>>(importer.ImportRoXAnim(ANIM_NAME), [&](std::shared_ptr<Animation> pAnim) {
+        callbackThread = std::this_thread::get_id();
+        pImport = pAnim;
+    });
+    EXPECT_EQ(importer.GetNumPending(), 1u);
+
+    while (importer.GetNumPending() > 0) {
+        importer.DispatchCompleted();
+    }
+    EXPECT_EQ(callbackThread, std::this_thread::get_id());
+    ASSERT_NE(pImport, nullptr);
+    EXPECT_EQ(pImport->GetNumBoneAnimations(), pAnimation->GetNumBoneAnimations());
+}
+
+TEST_F(AssetIOTest, AsyncImporter_OnCompleted_QueuedFromCallback) {
+    ASSERT_NO_THROW(AssetIO::ExportRoXAnim(pAnimation, ANIM_NAME));
+
+    AssetIO::AsyncImporter importer(1);
+    std::uint32_t numCallbacks = 0;
+    std::function<void(std::shared_ptr<Animation>)> onCompleted = [&](std::shared_ptr<Animation> pAnim) {
+        // Every callback queues two follow-up imports until 7 imports have completed.
+        if (++numCallbacks < 4) {
+            importer.OnCompleted(importer.ImportRoXAnim(ANIM_NAME), onCompleted);
+            importer.OnCompleted(importer.ImportRoXAnim(ANIM_NAME), onCompleted);
+        }
+    };
+    importer.OnCompleted(importer.ImportRoXAnim(ANIM_NAME), onCompleted);
+
+    while (importer.GetNumPending() > 0) {
+        ASSERT_NO_THROW(importer.DispatchCompleted());
+    }
+    EXPECT_EQ(numCallbacks, 7u);
+}
+
+// Loads the same model many times with 1 to hardware_concurrency threads.
+// The timings are written to the test report as properties.
+TEST_F(AssetIOTest, DISABLED_AsyncImporter_Benchmark_ThreadScaling) {
+    static constexpr std::uint32_t NUM_COPIES = 256;
+
+    ASSERT_NO_THROW(AssetIO::ExportRoXModl(pModel, MODL_NAME));
+    std::vector<std::string> filePaths(NUM_COPIES, MODL_NAME);
+
+    std::uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::uint32_t numThreads = 1; numThreads <= maxThreads; ++numThreads) {
+        AssetIO::AsyncImporter importer(numThreads);
+
+        auto start = std::chrono::steady_clock::now();
+        auto futures = importer.ImportRoXModls(filePaths, pMaterial, AssetIO::ReadMode::MemoryMapped);
+        for (auto& future : futures) {
+            ASSERT_NE(future.get(), nullptr);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        RecordProperty("Threads_" + std::to_string(numThreads) + "_us", std::to_string(elapsed.count()));
+    }
+}
+
+TEST_F(AssetIOTest, ImportModel_WithCacheDirectory_ReusesCacheEntry) {
+    static constexpr const char* SOURCE_NAME = "triangle.obj";
+    static constexpr const char* CACHE_DIRECTORY = "ImportCache";
+
+    std::ofstream fout(SOURCE_NAME);
+    fout << "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nvt 0 0\nf 1/1/1 2/1/1 3/1/1\n";
+    fout.close();
+
+    std::shared_ptr<Model> pCold;
+    ASSERT_NO_THROW(pCold = AssetIO::ImportModel(SOURCE_NAME, pMaterial, false, false, CACHE_DIRECTORY));
+    ASSERT_EQ(std::distance(std::filesystem::directory_iterator(CACHE_DIRECTORY), std::filesystem::directory_iterator()), 1);
+
+    std::shared_ptr<Model> pWarm;
+    ASSERT_NO_THROW(pWarm = AssetIO::ImportModel(SOURCE_NAME, pMaterial, false, false, CACHE_DIRECTORY));
+    EXPECT_EQ(pWarm->GetName(), pCold->GetName());
+    ASSERT_EQ(pWarm->GetNumMeshes(), pCold->GetNumMeshes());
+    EXPECT_EQ(pWarm->GetMeshes()[0]->GetIndices(), pCold->GetMeshes()[0]->GetIndices());
+    EXPECT_EQ(pWarm->GetMeshes()[0]->GetNumVertices(), pCold->GetMeshes()[0]->GetNumVertices());
+
+    // Different settings result in a separate entry.
+    ASSERT_NO_THROW(AssetIO::ImportModel(SOURCE_NAME, pMaterial, false, true, CACHE_DIRECTORY));
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(CACHE_DIRECTORY), std::filesystem::directory_iterator()), 2);
+
+    std::filesystem::remove(SOURCE_NAME);
+    std::filesystem::remove_all(CACHE_DIRECTORY);
+}
+
+TEST_F(AssetIOTest, ImportAnimations_MergesKeyChannels) {
+    ASSERT_NO_THROW(SyntheticScene::WriteSkinnedChain(SCENE_NAME, 1, 7));
+
+    std::unordered_map<std::string, std::shared_ptr<Animation>> animations;
+    ASSERT_NO_THROW(animations = AssetIO::ImportAnimations(SCENE_NAME));
+    ASSERT_EQ(animations.count("synthetic"), 1u);
+
+    std::vector<Keyframe>& keyframes = animations.at("synthetic")->GetBoneAnimations()[0].Keyframes;
+    ASSERT_EQ(keyframes.size(), 7u);
+    for (std::uint32_t i = 0; i < keyframes.size(); ++i) {
+        EXPECT_FLOAT_EQ(keyframes[i].TimePosition, i / 30.f);
+        EXPECT_FLOAT_EQ(keyframes[i].Translation.x, static_cast<float>(i));
+        EXPECT_FLOAT_EQ(keyframes[i].Scale.x, i % 3 == 0 ? 2.f : 1.f);
+        EXPECT_FLOAT_EQ(keyframes[i].RotationQuaternion.w, i % 2 == 0 ? 1.f : 0.f);
+    }
+}
+
+// Imports a clip with 10k ticks per bone, the import time is written to the test report as a property.
+TEST_F(AssetIOTest, DISABLED_ImportAnimations_Benchmark_LongClip) {
+    static constexpr std::uint32_t NUM_BONES = 4;
+    static constexpr std::uint32_t NUM_TICKS = 10000;
+
+    ASSERT_NO_THROW(SyntheticScene::WriteSkinnedChain(SCENE_NAME, NUM_BONES, NUM_TICKS));
+
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, std::shared_ptr<Animation>> animations = AssetIO::ImportAnimations(SCENE_NAME);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    RecordProperty("ImportAnimations_us", std::to_string(elapsed.count()));
+
+    ASSERT_EQ(animations.at("synthetic")->GetNumBoneAnimations(), NUM_BONES);
+    for (BoneAnimation& boneAnimation : animations.at("synthetic")->GetBoneAnimations()) {
+        EXPECT_EQ(boneAnimation.GetNumKeyframes(), NUM_TICKS);
+    }
+}
+
+TEST_F(AssetIOTest, ImportModel_Skinned_KeepsStrongestInfluences) {
+    // Every vertex is influenced by 6 bones, with weights 1, 1/2, 1/3, ... 
+    ASSERT_NO_THROW(SyntheticScene::WriteSkinnedChain(SCENE_NAME, 18, 2));
+
+    std::shared_ptr<Model> pImport;
+    ASSERT_NO_THROW(pImport = AssetIO::ImportModel(SCENE_NAME, pMaterial, true, false));
+    auto pImportMesh = std::dynamic_pointer_cast<SkinnedMesh>(pImport->GetMeshes()[0]);
+    ASSERT_NE(pImportMesh, nullptr);
+    ASSERT_EQ(pImportMesh->GetNumVertices(), 3u);
+
+    for (VertexPositionNormalTextureSkinning& vertex : pImportMesh->GetVertices()) {
+        std::uint32_t vertexId = vertex.position.x == 1.f ? 1 : (vertex.position.y == 1.f ? 2 : 0);
+        const float weights[4] = { vertex.weights.x, vertex.weights.y, vertex.weights.z, vertex.weights.w };
+
+        EXPECT_NEAR(weights[0] + weights[1] + weights[2] + weights[3], 1.f, 1e-6f);
+        for (std::uint32_t i = 0; i < 4; ++i) {
+            std::uint32_t boneIndex = (vertex.indices >> (i * 8)) & 0xFF;
+            EXPECT_EQ(boneIndex % 3, vertexId);
+            EXPECT_LE(boneIndex, vertexId + 9);
+
+            // Normalized from 1 + 1/2 + 1/3 + 1/4 = 25/12.
+            EXPECT_NEAR(weights[i], 12.f / 25.f / (1 + boneIndex / 3), 1e-6f);
+        }
+    }
+}
+
+// Imports a rig with 256 bones, the import times are written to the test report as properties.
+TEST_F(AssetIOTest, DISABLED_ImportModel_Benchmark_LargeSkeleton) {
+    static constexpr std::uint32_t NUM_BONES = 256;
+
+    ASSERT_NO_THROW(SyntheticScene::WriteSkinnedChain(SCENE_NAME, NUM_BONES, 2));
+
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<Model> pImport = AssetIO::ImportModel(SCENE_NAME, pMaterial, true, false);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    RecordProperty("ImportModel_us", std::to_string(elapsed.count()));
+
+    start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, std::shared_ptr<Animation>> animations = AssetIO::ImportAnimations(SCENE_NAME);
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    RecordProperty("ImportAnimations_us", std::to_string(elapsed.count()));
+
+    ASSERT_EQ(pImport->GetNumBones(), NUM_BONES);
+    for (std::uint32_t i = 0; i < NUM_BONES; ++i) {
+        EXPECT_EQ(pImport->GetBones()[i].GetName(), "bone" + std::to_string(i));
+    }
+
+    ASSERT_EQ(animations.at("synthetic")->GetNumBoneAnimations(), NUM_BONES);
+    for (BoneAnimation& boneAnimation : animations.at("synthetic")->GetBoneAnimations()) {
+        EXPECT_EQ(boneAnimation.GetNumKeyframes(), 2u);
+    }
+}
+
 TEST_F(AssetIOTest, ExportRoXAnim_WithValidAnimation) {
     EXPECT_NO_THROW(AssetIO::ExportRoXAnim(pAnimation, ANIM_NAME));
 }
@@ -103,3 +534,49 @@ TEST_F(AssetIOTest, ImportRoXAnim_WithValidAnimation_ExportedWithExportRoXAnim)
     }
 }
 
+
+TEST_F(AssetIOTest, ImportCompressedRoXAnim_WithValidAnimation_ExportedWithExportRoXAnim) {
+    auto pCompressed = std::make_shared<CompressedAnimation>(*pAnimation);
+    EXPECT_NO_THROW(AssetIO::ExportRoXAnim(pCompressed, ANIM_NAME));
+
+    std::shared_ptr<CompressedAnimation> pImport;
+    EXPECT_NO_THROW(pImport = AssetIO::ImportCompressedRoXAnim(ANIM_NAME));
+    ASSERT_NE(pImport, nullptr);
+
+    EXPECT_EQ(pImport->GetName(), pCompressed->GetName());
+    EXPECT_EQ(pImport->GetStartTime(), pCompressed->GetStartTime());
+    EXPECT_EQ(pImport->GetEndTime(), pCompressed->GetEndTime());
+    EXPECT_EQ(pImport->GetData(), pCompressed->GetData());
+    ASSERT_EQ(pImport->GetTracks().size(), pCompressed->GetTracks().size());
+    for (std::uint32_t i = 0; i < pImport->GetTracks().size(); ++i) {
+        EXPECT_EQ(std::memcmp(&pImport->GetTracks()[i], &pCompressed->GetTracks()[i], sizeof(CompressedTrack)), 0);
+    }
+}
+
+TEST_F(AssetIOTest, ImportCompressedRoXAnim_WithUncompressedAnimation) {
+    EXPECT_NO_THROW(AssetIO::ExportRoXAnim(pAnimation, ANIM_NAME));
+
+    EXPECT_THROW(AssetIO::ImportCompressedRoXAnim(ANIM_NAME), std::runtime_error);
+}
+
+TEST_F(AssetIOTest, ImportRoXAnim_WithCompressedAnimation) {
+    auto pCompressed = std::make_shared<CompressedAnimation>(*pAnimation);
+    EXPECT_NO_THROW(AssetIO::ExportRoXAnim(pCompressed, ANIM_NAME));
+
+    EXPECT_THROW(AssetIO::ImportRoXAnim(ANIM_NAME), std::runtime_error);
+}
+
+TEST_F(AssetIOTest, ImportRoXAnim_WithTruncatedFile) {
+    EXPECT_NO_THROW(AssetIO::ExportRoXAnim(pAnimation, ANIM_NAME));
+    std::filesystem::resize_file(ANIM_NAME, std::filesystem::file_size(ANIM_NAME) - 1);
+
+    EXPECT_THROW(AssetIO::ImportRoXAnim(ANIM_NAME), std::runtime_error);
+}
+
+TEST_F(AssetIOTest, ImportCompressedRoXAnim_WithTruncatedFile) {
+    auto pCompressed = std::make_shared<CompressedAnimation>(*pAnimation);
+    EXPECT_NO_THROW(AssetIO::ExportRoXAnim(pCompressed, ANIM_NAME));
+    std::filesystem::resize_file(ANIM_NAME, std::filesystem::file_size(ANIM_NAME) - 1);
+
+    EXPECT_THROW(AssetIO::ImportCompressedRoXAnim(ANIM_NAME), std::runtime_error);
+}
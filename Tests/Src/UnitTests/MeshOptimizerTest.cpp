@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include <RoX/MeshFactory.h>
+#include <RoX/MeshOptimizer.h>
+
+#include "../PredefinedObjects/ValidMesh.h"
+
+class MeshOptimizerTest : public testing::Test, public ValidMesh {
+    protected:
+        using Triangle = std::array<float, 9>;
+
+        MeshOptimizerTest() {
+            pMesh = std::make_shared<Mesh>("optimized");
+        }
+
+        // Grid of **width** by **height** cells with two triangles per cell, in a single submesh.
+        static std::shared_ptr<Mesh> NewGridMesh(std::uint32_t width, std::uint32_t height) {
+            auto pGrid = std::make_shared<Mesh>("grid");
+            for (std::uint32_t y = 0; y <= height; ++y) {
+                for (std::uint32_t x = 0; x <= width; ++x) {
+                    pGrid->GetVertices().push_back(VertexPositionNormalTexture({ float(x), float(y), 0.f }, { 0.f, 0.f, 1.f }, { float(x) / width, float(y) / height }));
+                }
+            }
+            for (std::uint32_t y = 0; y < height; ++y) {
+                for (std::uint32_t x = 0; x < width; ++x) {
+                    std::uint32_t i = y * (width + 1) + x;
+                    std::uint32_t cell[] = { i, i + width + 1, i + 1, i + 1, i + width + 1, i + width + 2 };
+                    pGrid->AppendIndices(cell, 6);
+                }
+            }
+
+            auto pSubmesh = std::make_unique<Submesh>("grid_submesh", 0);
+            pSubmesh->SetIndexCount(pGrid->GetNumIndices());
+            pGrid->Add(std::move(pSubmesh));
+            return pGrid;
+        }
+
+        // Shuffles the triangles of every submesh with a fixed seed, the way an unoptimized exporter might order them.
+        static void ShuffleTriangles(IMesh& iMesh) {
+            if (iMesh.GetIndexSizeInBytes() == sizeof(std::uint16_t))
+                ShuffleTriangles(iMesh, iMesh.GetIndices());
+            else
+                ShuffleTriangles(iMesh, iMesh.GetWideIndices());
+        }
+
+        template<typename Index>
+        static void ShuffleTriangles(IMesh& iMesh, std::vector<Index>& indices) {
+            std::mt19937 random(42);
+            for (std::unique_ptr<Submesh>& pSubmesh : iMesh.GetSubmeshes()) {
+                Index* pIndices = indices.data() + pSubmesh->GetStartIndex();
+                for (std::uint32_t t = pSubmesh->GetIndexCount() / 3; t > 1; --t) {
+                    std::uint32_t other = std::uniform_int_distribution<std::uint32_t>(0, t - 1)(random);
+                    std::swap_ranges(pIndices + (t - 1) * 3, pIndices + t * 3, pIndices + other * 3);
+                }
+            }
+        }
+
+        // Triangles of **pSubmesh** as the positions of their corners, starting at the smallest corner so the winding is kept.
+        static std::vector<Triangle> GetTriangles(Mesh& mesh, const std::unique_ptr<Submesh>& pSubmesh) {
+            std::vector<Triangle> triangles;
+            for (std::uint32_t i = pSubmesh->GetStartIndex(); i < pSubmesh->GetStartIndex() + pSubmesh->GetIndexCount(); i += 3) {
+                std::array<Triangle, 3> rotations;
+                for (std::uint32_t r = 0; r < 3; ++r) {
+                    for (std::uint32_t j = 0; j < 3; ++j) {
+                        const DirectX::XMFLOAT3& position = mesh.GetVertices()[pSubmesh->GetVertexOffset() + mesh.GetIndices()[i + (r + j) % 3]].position;
+                        rotations[r][j * 3] = position.x;
+                        rotations[r][j * 3 + 1] = position.y;
+                        rotations[r][j * 3 + 2] = position.z;
+                    }
+                }
+                triangles.push_back(*std::min_element(rotations.begin(), rotations.end()));
+            }
+            std::sort(triangles.begin(), triangles.end());
+            return triangles;
+        }
+};
+
+// ---------------------------------------------------------------- //
+//                          MeshOptimizer
+// ---------------------------------------------------------------- //
+
+TEST_F(MeshOptimizerTest, ComputeACMR) {
+    std::vector<std::uint32_t> single = { 0, 1, 2 };
+    EXPECT_FLOAT_EQ(MeshOptimizer::ComputeACMR(single.data(), single.size()), 3.f);
+
+    std::vector<std::uint32_t> quad = { 0, 1, 2, 2, 1, 3 };
+    EXPECT_FLOAT_EQ(MeshOptimizer::ComputeACMR(quad.data(), quad.size()), 2.f);
+
+    // The first triangle is evicted before it is drawn again.
+    std::vector<std::uint32_t> evicted = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+    EXPECT_FLOAT_EQ(MeshOptimizer::ComputeACMR(evicted.data(), evicted.size(), 3), 3.f);
+    EXPECT_FLOAT_EQ(MeshOptimizer::ComputeACMR(evicted.data(), evicted.size(), 6), 2.f);
+}
+
+TEST_F(MeshOptimizerTest, OptimizeTriangleOrder_KeepsTriangles) {
+    MeshFactory::AddSphere(*pMesh, 1.f, 32);
+    ShuffleTriangles(*pMesh);
+    std::vector<Triangle> triangles = GetTriangles(*pMesh, pMesh->GetSubmeshes()[0]);
+    // The building blocks work on 32-bit indices.
+    std::vector<std::uint32_t> indices(pMesh->GetIndices().begin(), pMesh->GetIndices().end());
+    float ACMRBefore = MeshOptimizer::ComputeACMR(indices.data(), indices.size());
+
+    std::vector<std::uint32_t> clusterStarts;
+    ASSERT_NO_THROW(MeshOptimizer::OptimizeTriangleOrder(indices.data(), indices.size(), 16, &clusterStarts));
+    pMesh->GetIndices().assign(indices.begin(), indices.end());
+    EXPECT_EQ(GetTriangles(*pMesh, pMesh->GetSubmeshes()[0]), triangles);
+
+    float ACMRAfter = MeshOptimizer::ComputeACMR(indices.data(), indices.size());
+    EXPECT_LT(ACMRAfter, ACMRBefore);
+    EXPECT_LT(ACMRAfter, 1.f);
+
+    ASSERT_FALSE(clusterStarts.empty());
+    EXPECT_EQ(clusterStarts.front(), 0);
+    EXPECT_TRUE(std::is_sorted(clusterStarts.begin(), clusterStarts.end()));
+    EXPECT_LT(clusterStarts.back(), pMesh->GetNumIndices() / 3);
+
+    ASSERT_NO_THROW(MeshOptimizer::OptimizeOverdraw(indices.data(), indices.size(), clusterStarts, pMesh->GetVertices().data(), sizeof(VertexPositionNormalTexture)));
+    pMesh->GetIndices().assign(indices.begin(), indices.end());
+    EXPECT_EQ(GetTriangles(*pMesh, pMesh->GetSubmeshes()[0]), triangles);
+}
+
+TEST_F(MeshOptimizerTest, OptimizeTriangleOrder_WithInvalidIndexCount) {
+    std::vector<std::uint32_t> indices = { 0, 1, 2, 3 };
+    EXPECT_THROW(MeshOptimizer::OptimizeTriangleOrder(indices.data(), indices.size()), std::invalid_argument);
+    EXPECT_THROW(MeshOptimizer::OptimizeTriangleOrder(indices.data(), 3, 2), std::invalid_argument);
+}
+
+// ---------------------------------------------------------------- //
+//                          IMesh::Optimize
+// ---------------------------------------------------------------- //
+
+TEST_F(MeshOptimizerTest, Optimize_KeepsSubmeshes) {
+    MeshFactory::AddSphere(*pMesh, 1.f, 32);
+    MeshFactory::AddTorus(*pMesh, 1.f, 0.333f, 32);
+    ShuffleTriangles(*pMesh);
+
+    std::vector<std::vector<Triangle>> triangles;
+    std::vector<std::uint32_t> startIndices;
+    for (std::unique_ptr<Submesh>& pSubmesh : pMesh->GetSubmeshes()) {
+        triangles.push_back(GetTriangles(*pMesh, pSubmesh));
+        startIndices.push_back(pSubmesh->GetStartIndex());
+    }
+
+    MeshOptimizerStats stats;
+    ASSERT_NO_THROW(stats = pMesh->Optimize());
+    EXPECT_LT(stats.ACMRAfter, stats.ACMRBefore);
+    EXPECT_EQ(stats.NumVerticesAfter, stats.NumVerticesBefore);
+    EXPECT_EQ(pMesh->GetNumVertices(), stats.NumVerticesAfter);
+
+    for (std::uint32_t i = 0; i < pMesh->GetNumSubmeshes(); ++i) {
+        std::unique_ptr<Submesh>& pSubmesh = pMesh->GetSubmeshes()[i];
+        EXPECT_EQ(pSubmesh->GetStartIndex(), startIndices[i]);
+        EXPECT_EQ(GetTriangles(*pMesh, pSubmesh), triangles[i]);
+    }
+
+    // Vertices are stored in the order they are first used.
+    std::uint32_t nextVertex = 0;
+    std::unique_ptr<Submesh>& pSphere = pMesh->GetSubmeshes()[0];
+    for (std::uint32_t i = 0; i < pSphere->GetIndexCount(); ++i) {
+        std::uint32_t index = pMesh->GetIndices()[i];
+        ASSERT_LE(index, nextVertex);
+        if (index == nextVertex)
+            ++nextVertex;
+    }
+}
+
+TEST_F(MeshOptimizerTest, Optimize_DeduplicateVertices) {
+    MeshFactory::AddSphere(*pMesh, 1.f, 16);
+    MeshFactory::AddCube(*pMesh, 1.f);
+    std::uint32_t numWeldedVertices = pMesh->GetNumVertices();
+
+    // Gives every corner of every triangle its own vertex.
+    std::vector<VertexPositionNormalTexture> vertices;
+    for (std::unique_ptr<Submesh>& pSubmesh : pMesh->GetSubmeshes()) {
+        std::uint32_t vertexOffset = vertices.size();
+        for (std::uint32_t i = pSubmesh->GetStartIndex(); i < pSubmesh->GetStartIndex() + pSubmesh->GetIndexCount(); ++i) {
+            vertices.push_back(pMesh->GetVertices()[pSubmesh->GetVertexOffset() + pMesh->GetIndices()[i]]);
+            pMesh->GetIndices()[i] = vertices.size() - 1 - vertexOffset;
+        }
+        pSubmesh->SetVertexOffset(vertexOffset);
+    }
+    pMesh->GetVertices() = vertices;
+
+    std::vector<std::vector<Triangle>> triangles;
+    for (std::unique_ptr<Submesh>& pSubmesh : pMesh->GetSubmeshes()) {
+        triangles.push_back(GetTriangles(*pMesh, pSubmesh));
+    }
+
+    MeshOptimizerSettings settings;
+    settings.DeduplicateVertices = true;
+    MeshOptimizerStats stats;
+    ASSERT_NO_THROW(stats = pMesh->Optimize(settings));
+    EXPECT_EQ(stats.NumVerticesBefore, vertices.size());
+    EXPECT_LE(stats.NumVerticesAfter, numWeldedVertices);
+    EXPECT_EQ(pMesh->GetNumVertices(), stats.NumVerticesAfter);
+    EXPECT_LT(stats.ACMRAfter, stats.ACMRBefore);
+
+    EXPECT_EQ(pMesh->GetSubmeshes()[0]->GetVertexOffset(), 0);
+    for (std::uint32_t i = 0; i < pMesh->GetNumSubmeshes(); ++i) {
+        EXPECT_EQ(GetTriangles(*pMesh, pMesh->GetSubmeshes()[i]), triangles[i]);
+    }
+}
+
+TEST_F(MeshOptimizerTest, Optimize_WithOverlappingSubmeshes) {
+    MeshFactory::AddCube(*pMesh, 1.f);
+    auto pOverlapping = std::make_unique<Submesh>("overlapping", 0);
+    pOverlapping->SetStartIndex(3);
+    pOverlapping->SetIndexCount(6);
+    pMesh->Add(std::move(pOverlapping));
+
+    std::vector<std::uint16_t> indices = pMesh->GetIndices();
+    MeshOptimizerStats stats;
+    ASSERT_NO_THROW(stats = pMesh->Optimize());
+    EXPECT_EQ(pMesh->GetIndices(), indices);
+    EXPECT_EQ(stats.ACMRAfter, stats.ACMRBefore);
+}
+
+TEST_F(MeshOptimizerTest, Optimize_SkinnedMesh) {
+    MeshFactory::AddTorus(*pSkinnedMesh, 1.f, 0.333f, 32);
+    ShuffleTriangles(*pSkinnedMesh);
+
+    MeshOptimizerStats stats;
+    ASSERT_NO_THROW(stats = pSkinnedMesh->Optimize());
+    EXPECT_LT(stats.ACMRAfter, stats.ACMRBefore);
+    EXPECT_EQ(pSkinnedMesh->GetNumVertices(), stats.NumVerticesAfter);
+}
+
+// Optimizes shuffled grids of up to 1M triangles.
+// The timings and the ACMR before and after are written to the test report as properties.
+TEST_F(MeshOptimizerTest, DISABLED_Benchmark_Optimize) {
+    for (std::uint32_t width : { 64u, 256u, 1024u }) {
+        std::shared_ptr<Mesh> pGrid = NewGridMesh(width, width / 2);
+        ShuffleTriangles(*pGrid);
+
+        auto start = std::chrono::steady_clock::now();
+        MeshOptimizerStats stats = pGrid->Optimize();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_LT(stats.ACMRAfter, stats.ACMRBefore);
+        std::string name = "Triangles_" + std::to_string(pGrid->GetNumIndices() / 3);
+        RecordProperty(name + "_ms", std::to_string(elapsed));
+        RecordProperty(name + "_ACMRBefore", std::to_string(stats.ACMRBefore));
+        RecordProperty(name + "_ACMRAfter", std::to_string(stats.ACMRAfter));
+    }
+}
@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include <RoX/MeshFactory.h>
 #include <RoX/Model.h>
 
 #include "../Mocks/MockMeshObserver.h"
@@ -20,6 +27,44 @@ class SkinnedMeshTest : public testing::Test, public ValidMesh {
         SkinnedMeshTest() {}
 };
 
+// Scales unevenly, rotates and translates, so normals need the inverse transpose.
+DirectX::XMMATRIX MakeTestTransform() {
+    return DirectX::XMMatrixScaling(2.f, 0.5f, 3.f)
+        * DirectX::XMMatrixRotationRollPitchYaw(0.3f, 1.1f, -0.7f)
+        * DirectX::XMMatrixTranslation(4.f, -2.f, 7.f);
+}
+
+// Appends **numVertices** vertices with varied positions and unit normals.
+template<typename Vertex>
+void AddTestVertices(std::vector<Vertex>& vertices, std::uint32_t numVertices) {
+    for (std::uint32_t i = 0; i < numVertices; ++i) {
+        Vertex vertex = {};
+        vertex.position = { float(i % 97), float(i % 13) - 6.f, float(i % 7) * 0.25f };
+        DirectX::XMVECTOR N = DirectX::XMVector3Normalize(DirectX::XMVectorSet(float(i % 5) + 1.f, float(i % 3) - 1.f, float(i % 11) - 5.f, 0.f));
+        DirectX::XMStoreFloat3(&vertex.normal, N);
+        vertices.push_back(vertex);
+    }
+}
+
+// Checks **transformed** against transforming **original** one vertex at a time.
+template<typename Vertex>
+void ExpectTransformedVertices(const std::vector<Vertex>& original, const std::vector<Vertex>& transformed, DirectX::XMMATRIX M) {
+    ASSERT_EQ(original.size(), transformed.size());
+    DirectX::XMMATRIX N = DirectX::XMMatrixTranspose(DirectX::XMMatrixInverse(nullptr, M));
+    for (std::uint32_t i = 0; i < original.size(); ++i) {
+        DirectX::XMFLOAT3 position, normal;
+        DirectX::XMStoreFloat3(&position, DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&original[i].position), M));
+        DirectX::XMStoreFloat3(&normal, DirectX::XMVector3Normalize(DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&original[i].normal), N)));
+
+        EXPECT_NEAR(transformed[i].position.x, position.x, 1e-3f);
+        EXPECT_NEAR(transformed[i].position.y, position.y, 1e-3f);
+        EXPECT_NEAR(transformed[i].position.z, position.z, 1e-3f);
+        EXPECT_NEAR(transformed[i].normal.x, normal.x, 1e-5f);
+        EXPECT_NEAR(transformed[i].normal.y, normal.y, 1e-5f);
+        EXPECT_NEAR(transformed[i].normal.z, normal.z, 1e-5f);
+    }
+}
+
 // ---------------------------------------------------------------- //
 //                          BaseMesh
 // ---------------------------------------------------------------- //
@@ -107,6 +152,259 @@ TEST_F(BaseMeshTest, Detach_WithInvalidObserver) {
     EXPECT_NO_THROW(pMesh->Detach(nullptr));
 }
 
+TEST_F(BaseMeshTest, SelectIndexSize) {
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 2);
+
+    pMesh->GetIndices().push_back(USHRT_MAX);
+    pMesh->SelectIndexSize();
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 4);
+    EXPECT_TRUE(pMesh->GetIndices().empty());
+    EXPECT_EQ(pMesh->GetWideIndices(), std::vector<std::uint32_t>({ 0, USHRT_MAX }));
+
+    pMesh->GetWideIndices().pop_back();
+    pMesh->SelectIndexSize();
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 2);
+    EXPECT_TRUE(pMesh->GetWideIndices().empty());
+    EXPECT_EQ(pMesh->GetIndices(), std::vector<std::uint16_t>({ 0 }));
+}
+
+TEST_F(BaseMeshTest, AppendIndices) {
+    std::vector<std::uint16_t> narrowIndices = { 0, 1, 2 };
+    pMesh->AppendIndices(narrowIndices.data(), narrowIndices.size());
+    EXPECT_EQ(pMesh->GetNumIndices(), 4);
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 2);
+
+    std::vector<std::uint32_t> wideIndices = { 3, 100000 };
+    pMesh->AppendIndices(wideIndices.data(), 1);
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 2);
+    EXPECT_EQ(pMesh->GetIndices().back(), 3);
+    pMesh->AppendIndices(wideIndices.data() + 1, 1);
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 4);
+    EXPECT_TRUE(pMesh->GetIndices().empty());
+    EXPECT_EQ(pMesh->GetWideIndices(), std::vector<std::uint32_t>({ 0, 0, 1, 2, 3, 100000 }));
+
+    // Appending never narrows, that is left to **SelectIndexSize**.
+    pMesh->AppendIndices(narrowIndices.data(), narrowIndices.size());
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 4);
+    EXPECT_EQ(pMesh->GetNumIndices(), 9);
+}
+
+TEST_F(BaseMeshTest, SetIndexSizeInBytes_WithInvalidSize) {
+    EXPECT_THROW(pMesh->SetIndexSizeInBytes(1), std::invalid_argument);
+    EXPECT_THROW(pMesh->SetIndexSizeInBytes(8), std::invalid_argument);
+    EXPECT_NO_THROW(pMesh->SetIndexSizeInBytes(4));
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 4);
+}
+
+TEST_F(BaseMeshTest, SetIndexSizeInBytes_MovesIndices) {
+    ASSERT_NO_THROW(pMesh->SetIndexSizeInBytes(4));
+    EXPECT_TRUE(pMesh->GetIndices().empty());
+    EXPECT_EQ(pMesh->GetWideIndices(), std::vector<std::uint32_t>({ 0 }));
+    EXPECT_EQ(pMesh->GetNumIndices(), 1);
+
+    ASSERT_NO_THROW(pMesh->SetIndexSizeInBytes(2));
+    EXPECT_TRUE(pMesh->GetWideIndices().empty());
+    EXPECT_EQ(pMesh->GetIndices(), std::vector<std::uint16_t>({ 0 }));
+
+    // 0xFFFF is the strip cut value and does not fit in 16-bit indices.
+    ASSERT_NO_THROW(pMesh->SetIndexSizeInBytes(4));
+    pMesh->GetWideIndices().push_back(USHRT_MAX);
+    EXPECT_THROW(pMesh->SetIndexSizeInBytes(2), std::invalid_argument);
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 4);
+    EXPECT_EQ(pMesh->GetNumIndices(), 2);
+}
+
+TEST_F(BaseMeshTest, ApplyResidency_KeepCPUCopy) {
+    EXPECT_NO_THROW(pMesh->ApplyResidency());
+    EXPECT_FALSE(pMesh->IsGeometryReleased());
+    EXPECT_EQ(pMesh->GetVertices().size(), 1);
+    EXPECT_EQ(pMesh->GetResidencySavingsInBytes(), 0);
+}
+
+TEST_F(BaseMeshTest, ApplyResidency_KeepCompressedCopy) {
+    // A strip of vertices along the x axis compresses well.
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        pMesh->GetVertices().push_back(VertexPositionNormalTexture({ float(i), 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f }));
+        pMesh->GetIndices().push_back(i);
+    }
+    std::vector<VertexPositionNormalTexture> vertices = pMesh->GetVertices();
+    std::vector<std::uint16_t> indices = pMesh->GetIndices();
+    std::uint64_t sizeInBytes = pMesh->GetGeometrySizeInBytes();
+
+    ASSERT_NO_THROW(pMesh->UseStaticBuffers(true));
+    ASSERT_NO_THROW(pMesh->SetResidency(GeometryResidency::KeepCompressedCopy));
+    EXPECT_FALSE(pMesh->IsGeometryReleased());
+    ASSERT_NO_THROW(pMesh->ApplyResidency());
+    EXPECT_TRUE(pMesh->IsGeometryReleased());
+    EXPECT_TRUE(pMesh->GetVertices().empty());
+    EXPECT_EQ(pMesh->GetNumVertices(), vertices.size());
+    EXPECT_EQ(pMesh->GetNumIndices(), indices.size());
+    EXPECT_LT(pMesh->GetGeometrySizeInBytes(), sizeInBytes);
+    EXPECT_EQ(pMesh->GetResidencySavingsInBytes(), sizeInBytes - pMesh->GetGeometrySizeInBytes());
+
+    ASSERT_NO_THROW(pMesh->RestoreGeometry());
+    EXPECT_FALSE(pMesh->IsGeometryReleased());
+    ASSERT_EQ(pMesh->GetVertices().size(), vertices.size());
+    EXPECT_EQ(memcmp(pMesh->GetVertices().data(), vertices.data(), vertices.size() * sizeof(VertexPositionNormalTexture)), 0);
+    EXPECT_EQ(pMesh->GetIndices(), indices);
+}
+
+TEST_F(BaseMeshTest, ApplyResidency_KeepCompressedCopy_WideIndices) {
+    std::vector<std::uint32_t> indices = { 0, 100000, 7 };
+    pMesh->AppendIndices(indices.data(), indices.size());
+    ASSERT_EQ(pMesh->GetIndexSizeInBytes(), 4);
+    indices = pMesh->GetWideIndices();
+
+    ASSERT_NO_THROW(pMesh->UseStaticBuffers(true));
+    ASSERT_NO_THROW(pMesh->SetResidency(GeometryResidency::KeepCompressedCopy));
+    ASSERT_NO_THROW(pMesh->ApplyResidency());
+    EXPECT_TRUE(pMesh->GetWideIndices().empty());
+    EXPECT_EQ(pMesh->GetNumIndices(), indices.size());
+
+    ASSERT_NO_THROW(pMesh->RestoreGeometry());
+    EXPECT_EQ(pMesh->GetIndexSizeInBytes(), 4);
+    EXPECT_EQ(pMesh->GetWideIndices(), indices);
+}
+
+TEST_F(BaseMeshTest, ApplyResidency_KeepCompressedCopy_DynamicBuffers) {
+    std::vector<VertexPositionNormalTexture> vertices = pMesh->GetVertices();
+    std::vector<std::uint16_t> indices = pMesh->GetIndices();
+
+    // Dynamic buffers are restored from the renderer like **ReleaseAfterUpload**.
+    MockMeshObserver observer;
+    EXPECT_CALL(observer, OnSetResidency(pMesh.get(), GeometryResidency::KeepCompressedCopy)).Times(testing::Exactly(1));
+    EXPECT_CALL(observer, OnRebuildFromBuffers(pMesh.get())).WillOnce([&](Mesh* pRebuilt) {
+        pRebuilt->GetVertices() = vertices;
+        pRebuilt->GetIndices() = indices;
+    });
+    ASSERT_NO_THROW(pMesh->Attach(&observer));
+
+    ASSERT_NO_THROW(pMesh->SetResidency(GeometryResidency::KeepCompressedCopy));
+    ASSERT_NO_THROW(pMesh->ApplyResidency());
+    EXPECT_TRUE(pMesh->IsGeometryReleased());
+    EXPECT_EQ(pMesh->GetGeometrySizeInBytes(), 0);
+
+    ASSERT_NO_THROW(pMesh->RestoreGeometry());
+    EXPECT_EQ(pMesh->GetIndices(), indices);
+}
+
+TEST_F(BaseMeshTest, ApplyResidency_ReleaseAfterUpload) {
+    std::vector<VertexPositionNormalTexture> vertices = pMesh->GetVertices();
+    std::vector<std::uint16_t> indices = pMesh->GetIndices();
+
+    // Stands in for the renderer, which copies the geometry back from its buffers.
+    MockMeshObserver observer;
+    EXPECT_CALL(observer, OnSetResidency(pMesh.get(), GeometryResidency::ReleaseAfterUpload)).Times(testing::Exactly(1));
+    EXPECT_CALL(observer, OnRebuildFromBuffers(pMesh.get())).WillOnce([&](Mesh* pRebuilt) {
+        pRebuilt->GetVertices() = vertices;
+        pRebuilt->GetIndices() = indices;
+    });
+    ASSERT_NO_THROW(pMesh->Attach(&observer));
+
+    ASSERT_NO_THROW(pMesh->SetResidency(GeometryResidency::ReleaseAfterUpload));
+    ASSERT_NO_THROW(pMesh->ApplyResidency());
+    EXPECT_TRUE(pMesh->IsGeometryReleased());
+    EXPECT_EQ(pMesh->GetGeometrySizeInBytes(), 0);
+    EXPECT_EQ(pMesh->GetResidencySavingsInBytes(), sizeof(VertexPositionNormalTexture) + sizeof(std::uint16_t));
+
+    ASSERT_NO_THROW(pMesh->RestoreGeometry());
+    EXPECT_EQ(pMesh->GetVertices().size(), vertices.size());
+    EXPECT_EQ(pMesh->GetIndices(), indices);
+}
+
+TEST_F(BaseMeshTest, RestoreGeometry_WithoutCopy) {
+    ASSERT_NO_THROW(pMesh->SetResidency(GeometryResidency::ReleaseAfterUpload));
+    ASSERT_NO_THROW(pMesh->ApplyResidency());
+
+    EXPECT_THROW(pMesh->RestoreGeometry(), std::runtime_error);
+    EXPECT_TRUE(pMesh->IsGeometryReleased());
+    EXPECT_EQ(pMesh->GetNumVertices(), 1);
+}
+
+TEST_F(BaseMeshTest, UpdateBounds_WithMeshFactory) {
+    auto pBoxes = std::make_shared<Mesh>();
+    MeshFactory::AddCube(*pBoxes, 1.f);
+    MeshFactory::AddBox(*pBoxes, { 2.f, 4.f, 6.f });
+
+    const DirectX::BoundingBox& cube = pBoxes->GetSubmeshes()[0]->GetBoundingBox();
+    EXPECT_NEAR(cube.Extents.x, 0.5f, 1e-5f);
+    EXPECT_NEAR(cube.Extents.y, 0.5f, 1e-5f);
+    EXPECT_NEAR(cube.Extents.z, 0.5f, 1e-5f);
+    EXPECT_NEAR(pBoxes->GetSubmeshes()[0]->GetBoundingSphere().Radius, std::sqrt(0.75f), 1e-5f);
+
+    const DirectX::BoundingBox& box = pBoxes->GetBoundingBox();
+    EXPECT_NEAR(box.Center.x, 0.f, 1e-5f);
+    EXPECT_NEAR(box.Extents.x, 1.f, 1e-5f);
+    EXPECT_NEAR(box.Extents.y, 2.f, 1e-5f);
+    EXPECT_NEAR(box.Extents.z, 3.f, 1e-5f);
+    EXPECT_NEAR(pBoxes->GetBoundingSphere().Radius, std::sqrt(14.f), 1e-4f);
+}
+
+TEST_F(BaseMeshTest, UpdateBounds_OnlyCoversIndexRange) {
+    pMesh->GetVertices() = {
+        VertexPositionNormalTexture({ 0.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f }),
+        VertexPositionNormalTexture({ 2.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f }),
+        VertexPositionNormalTexture({ 0.f, 2.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f }),
+        VertexPositionNormalTexture({ 100.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f }),
+    };
+    // The last index points past the vertices and is skipped.
+    pMesh->GetIndices() = { 0, 1, 2, 3, 9 };
+    pMesh->GetSubmeshes()[0]->SetIndexCount(3);
+
+    ASSERT_NO_THROW(pMesh->UpdateBounds());
+    const DirectX::BoundingBox& box = pMesh->GetSubmeshes()[0]->GetBoundingBox();
+    EXPECT_FLOAT_EQ(box.Center.x, 1.f);
+    EXPECT_FLOAT_EQ(box.Center.y, 1.f);
+    EXPECT_FLOAT_EQ(box.Extents.x, 1.f);
+    EXPECT_FLOAT_EQ(box.Extents.z, 0.f);
+    EXPECT_FLOAT_EQ(pMesh->GetSubmeshes()[0]->GetBoundingSphere().Radius, std::sqrt(2.f));
+
+    auto pSubmesh = NewValidSubmesh();
+    pSubmesh->SetStartIndex(3);
+    pSubmesh->SetIndexCount(2);
+    pMesh->Add(std::move(pSubmesh));
+    ASSERT_NO_THROW(pMesh->UpdateBounds(*pMesh->GetSubmeshes()[1]));
+    EXPECT_FLOAT_EQ(pMesh->GetSubmeshes()[1]->GetBoundingBox().Center.x, 100.f);
+    EXPECT_FLOAT_EQ(pMesh->GetSubmeshes()[1]->GetBoundingSphere().Radius, 0.f);
+    EXPECT_FLOAT_EQ(pMesh->GetBoundingBox().Extents.x, 50.f);
+}
+
+TEST_F(BaseMeshTest, UpdateBounds_FromGeometryLoader) {
+    std::vector<VertexPositionNormalTexture> vertices = {
+        VertexPositionNormalTexture({ 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f }),
+        VertexPositionNormalTexture({ 2.f, 4.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f })
+    };
+    std::vector<std::uint16_t> indices = { 0, 1, 1 };
+    pMesh->GetSubmeshes()[0]->SetIndexCount(indices.size());
+    pMesh->DeferGeometry([&](IMesh& iMesh) {
+        static_cast<Mesh&>(iMesh).GetVertices() = vertices;
+        iMesh.GetIndices() = indices;
+        iMesh.UpdateBounds();
+    }, indices.size(), vertices.size());
+
+    ASSERT_NO_THROW(pMesh->RequireGeometry());
+    EXPECT_FLOAT_EQ(pMesh->GetBoundingBox().Center.x, 1.f);
+    EXPECT_FLOAT_EQ(pMesh->GetBoundingBox().Extents.y, 2.f);
+}
+
+TEST_F(BaseMeshTest, RequireGeometry_WithFailingLoader) {
+    pMesh->DeferGeometry([](IMesh&) { throw std::runtime_error("corrupt"); }, 3, 2);
+
+    EXPECT_THROW(pMesh->RequireGeometry(), std::runtime_error);
+    EXPECT_FALSE(pMesh->IsGeometryResident());
+    EXPECT_EQ(pMesh->GetNumVertices(), 2);
+}
+
+TEST_F(BaseMeshTest, UpdateBounds_WithReleasedGeometry) {
+    MeshFactory::AddCube(*pMesh, 1.f);
+    DirectX::BoundingBox box = pMesh->GetBoundingBox();
+
+    ASSERT_NO_THROW(pMesh->SetResidency(GeometryResidency::ReleaseAfterUpload));
+    ASSERT_NO_THROW(pMesh->ApplyResidency());
+    ASSERT_NO_THROW(pMesh->UpdateBounds());
+    EXPECT_FLOAT_EQ(pMesh->GetBoundingBox().Extents.x, box.Extents.x);
+}
+
 // ---------------------------------------------------------------- //
 //                          Mesh
 // ---------------------------------------------------------------- //
@@ -125,6 +423,151 @@ TEST_F(MeshTest, RebuildFromBuffers) {
     EXPECT_NO_THROW(pMesh->RebuildFromBuffers());
 }
 
+TEST_F(MeshTest, TransformVertices_MatchesScalar) {
+    DirectX::XMMATRIX M = MakeTestTransform();
+    // Covers a partial batch, and a mesh large enough to be split over the thread pool.
+    for (std::uint32_t numVertices : { 7u, 100003u }) {
+        pMesh->GetVertices().clear();
+        AddTestVertices(pMesh->GetVertices(), numVertices);
+        std::vector<VertexPositionNormalTexture> original = pMesh->GetVertices();
+
+        pMesh->TransformVertices(M);
+        ExpectTransformedVertices(original, pMesh->GetVertices(), M);
+    }
+}
+
+TEST_F(MeshTest, TransformVertices_UpdatesBounds) {
+    MeshFactory::AddCube(*pMesh, 2.f);
+    DirectX::XMMATRIX M = DirectX::XMMatrixScaling(1.f, 2.f, 3.f) * DirectX::XMMatrixTranslation(5.f, 0.f, -1.f);
+    pMesh->TransformVertices(M);
+
+    const DirectX::BoundingBox& box = pMesh->GetSubmeshes()[1]->GetBoundingBox();
+    EXPECT_NEAR(box.Center.x, 5.f, 1e-5f);
+    EXPECT_NEAR(box.Center.z, -1.f, 1e-5f);
+    EXPECT_NEAR(box.Extents.y, 2.f, 1e-5f);
+    EXPECT_NEAR(box.Extents.z, 3.f, 1e-5f);
+    EXPECT_NEAR(pMesh->GetBoundingSphere().Radius, std::sqrt(14.f), 1e-4f);
+}
+
+TEST_F(MeshTest, TransformVertices_LoadsDeferredGeometry) {
+    std::vector<VertexPositionNormalTexture> original;
+    AddTestVertices(original, 9);
+    pMesh->DeferGeometry([&](IMesh& iMesh) {
+        static_cast<Mesh&>(iMesh).GetVertices() = original;
+    }, 0, original.size());
+
+    DirectX::XMMATRIX M = MakeTestTransform();
+    pMesh->TransformVertices(M);
+    EXPECT_TRUE(pMesh->IsGeometryResident());
+    ExpectTransformedVertices(original, pMesh->GetVertices(), M);
+}
+
+TEST_F(MeshTest, TransformVertices_RestoresReleasedGeometry) {
+    pMesh->GetVertices().clear();
+    AddTestVertices(pMesh->GetVertices(), 9);
+    std::vector<VertexPositionNormalTexture> original = pMesh->GetVertices();
+
+    ASSERT_NO_THROW(pMesh->UseStaticBuffers(true));
+    ASSERT_NO_THROW(pMesh->SetResidency(GeometryResidency::KeepCompressedCopy));
+    ASSERT_NO_THROW(pMesh->ApplyResidency());
+    ASSERT_TRUE(pMesh->IsGeometryReleased());
+
+    DirectX::XMMATRIX M = MakeTestTransform();
+    pMesh->TransformVertices(M);
+    EXPECT_FALSE(pMesh->IsGeometryReleased());
+    ExpectTransformedVertices(original, pMesh->GetVertices(), M);
+}
+
+TEST_F(MeshTest, TransformVertices_KeepsTextureCoordinates) {
+    pMesh->GetVertices().clear();
+    AddTestVertices(pMesh->GetVertices(), 9);
+    for (std::uint32_t i = 0; i < 9; ++i) {
+        pMesh->GetVertices()[i].textureCoordinate = { float(i), 1.f - float(i) };
+    }
+
+    DirectX::XMMATRIX M = MakeTestTransform();
+    pMesh->TransformVertices(M);
+    for (std::uint32_t i = 0; i < 9; ++i) {
+        EXPECT_EQ(pMesh->GetVertices()[i].textureCoordinate.x, float(i));
+        EXPECT_EQ(pMesh->GetVertices()[i].textureCoordinate.y, 1.f - float(i));
+    }
+}
+
+TEST_F(MeshTest, EncodeCompactVertices_RoundTrip) {
+    pMesh->GetVertices().clear();
+    AddTestVertices(pMesh->GetVertices(), 100);
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        pMesh->GetVertices()[i].textureCoordinate = { i / 100.f, 1.f - i / 50.f };
+    }
+    std::vector<VertexPositionNormalTexture> original = pMesh->GetVertices();
+
+    std::vector<VertexPositionNormalTextureCompact> compactVertices;
+    VertexQuantization quantization = pMesh->EncodeCompactVertices(compactVertices);
+    ASSERT_EQ(compactVertices.size(), original.size());
+    EXPECT_FLOAT_EQ(quantization.Offset.x, 48.f);
+    EXPECT_FLOAT_EQ(quantization.Scale.x, 48.f);
+
+    ASSERT_NO_THROW(pMesh->DecodeCompactVertices(compactVertices.data(), compactVertices.size(), quantization));
+    ASSERT_EQ(pMesh->GetVertices().size(), original.size());
+    for (std::uint32_t i = 0; i < original.size(); ++i) {
+        const VertexPositionNormalTexture& vertex = pMesh->GetVertices()[i];
+        EXPECT_NEAR(vertex.position.x, original[i].position.x, 1e-3f);
+        EXPECT_NEAR(vertex.position.y, original[i].position.y, 1e-3f);
+        EXPECT_NEAR(vertex.position.z, original[i].position.z, 1e-3f);
+        EXPECT_NEAR(vertex.normal.x, original[i].normal.x, 1e-3f);
+        EXPECT_NEAR(vertex.normal.y, original[i].normal.y, 1e-3f);
+        EXPECT_NEAR(vertex.normal.z, original[i].normal.z, 1e-3f);
+        EXPECT_NEAR(vertex.textureCoordinate.x, original[i].textureCoordinate.x, 1e-3f);
+        EXPECT_NEAR(vertex.textureCoordinate.y, original[i].textureCoordinate.y, 1e-3f);
+    }
+}
+
+TEST_F(MeshTest, EncodeCompactVertices_WithFlatMesh) {
+    pMesh->GetVertices().clear();
+    pMesh->GetVertices().push_back(VertexPositionNormalTexture({ 1.f, 2.f, 3.f }, { 0.f, 0.f, -1.f }, { 0.f, 0.f }));
+    pMesh->GetVertices().push_back(VertexPositionNormalTexture({ 5.f, 2.f, 3.f }, { 0.f, 0.f, -1.f }, { 0.f, 0.f }));
+
+    std::vector<VertexPositionNormalTextureCompact> compactVertices;
+    VertexQuantization quantization = pMesh->EncodeCompactVertices(compactVertices);
+    EXPECT_FLOAT_EQ(quantization.Scale.y, 0.f);
+    ASSERT_NO_THROW(pMesh->DecodeCompactVertices(compactVertices.data(), compactVertices.size(), quantization));
+
+    // Flat axes decode exactly, normals pointing down survive the octahedral fold.
+    for (VertexPositionNormalTexture& vertex : pMesh->GetVertices()) {
+        EXPECT_FLOAT_EQ(vertex.position.y, 2.f);
+        EXPECT_FLOAT_EQ(vertex.position.z, 3.f);
+        EXPECT_NEAR(vertex.normal.z, -1.f, 1e-5f);
+    }
+    EXPECT_NEAR(pMesh->GetVertices()[1].position.x, 5.f, 1e-3f);
+}
+
+// Transforms a mesh of 1M vertices one vertex at a time and with **TransformVertices**.
+// The timings are written to the test report as properties.
+TEST_F(MeshTest, DISABLED_Benchmark_TransformVertices) {
+    static constexpr std::uint32_t NUM_VERTICES = 1 << 20;
+
+    pMesh->GetVertices().clear();
+    AddTestVertices(pMesh->GetVertices(), NUM_VERTICES);
+    std::vector<VertexPositionNormalTexture> vertices = pMesh->GetVertices();
+    DirectX::XMMATRIX M = MakeTestTransform();
+    DirectX::XMMATRIX N = DirectX::XMMatrixTranspose(DirectX::XMMatrixInverse(nullptr, M));
+
+    auto start = std::chrono::steady_clock::now();
+    for (VertexPositionNormalTexture& vertex : vertices) {
+        DirectX::XMStoreFloat3(&vertex.position, DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&vertex.position), M));
+        DirectX::XMStoreFloat3(&vertex.normal, DirectX::XMVector3Normalize(DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&vertex.normal), N)));
+    }
+    auto scalarElapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    pMesh->TransformVertices(M);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_NEAR(pMesh->GetVertices().back().position.x, vertices.back().position.x, 1e-3f);
+    RecordProperty("Scalar_us", std::to_string(scalarElapsed));
+    RecordProperty("TransformVertices_us", std::to_string(elapsed));
+}
+
 // ---------------------------------------------------------------- //
 //                          SkinnedMesh
 // ---------------------------------------------------------------- //
@@ -143,3 +586,49 @@ TEST_F(SkinnedMeshTest, RebuildFromBuffers) {
     EXPECT_NO_THROW(pSkinnedMesh->RebuildFromBuffers());
 }
 
+TEST_F(SkinnedMeshTest, EncodeCompactVertices_RoundTrip) {
+    pSkinnedMesh->GetVertices().clear();
+    AddTestVertices(pSkinnedMesh->GetVertices(), 10);
+    for (VertexPositionNormalTextureSkinning& vertex : pSkinnedMesh->GetVertices()) {
+        vertex.SetBlendIndices({ 4, 3, 2, 1 });
+        vertex.SetBlendWeights({ 0.333f, 0.333f, 0.334f, 0.f });
+    }
+    std::vector<VertexPositionNormalTextureSkinning> original = pSkinnedMesh->GetVertices();
+
+    std::vector<VertexPositionNormalTextureSkinningCompact> compactVertices;
+    VertexQuantization quantization = pSkinnedMesh->EncodeCompactVertices(compactVertices);
+    ASSERT_NO_THROW(pSkinnedMesh->DecodeCompactVertices(compactVertices.data(), compactVertices.size(), quantization));
+
+    ASSERT_EQ(pSkinnedMesh->GetVertices().size(), original.size());
+    for (std::uint32_t i = 0; i < original.size(); ++i) {
+        const VertexPositionNormalTextureSkinning& vertex = pSkinnedMesh->GetVertices()[i];
+        EXPECT_NEAR(vertex.position.x, original[i].position.x, 1e-3f);
+        EXPECT_NEAR(vertex.normal.y, original[i].normal.y, 1e-3f);
+        EXPECT_EQ(vertex.indices, original[i].indices);
+        EXPECT_NEAR(vertex.weights.x, original[i].weights.x, 1.f / 255.f);
+        EXPECT_NEAR(vertex.weights.z, original[i].weights.z, 1.f / 255.f);
+        // Rounding keeps the weights adding up to 1.
+        EXPECT_NEAR(vertex.weights.x + vertex.weights.y + vertex.weights.z + vertex.weights.w, 1.f, 1e-5f);
+    }
+}
+
+TEST_F(SkinnedMeshTest, TransformVertices_MatchesScalar) {
+    pSkinnedMesh->GetVertices().clear();
+    AddTestVertices(pSkinnedMesh->GetVertices(), 1030);
+    for (VertexPositionNormalTextureSkinning& vertex : pSkinnedMesh->GetVertices()) {
+        vertex.SetBlendIndices({ 1, 2, 3, 4 });
+        vertex.SetBlendWeights({ 0.25f, 0.25f, 0.25f, 0.25f });
+    }
+    std::vector<VertexPositionNormalTextureSkinning> original = pSkinnedMesh->GetVertices();
+
+    DirectX::XMMATRIX M = MakeTestTransform();
+    pSkinnedMesh->TransformVertices(M);
+    ExpectTransformedVertices(original, pSkinnedMesh->GetVertices(), M);
+
+    // Skinning data is left alone.
+    for (std::uint32_t i = 0; i < original.size(); ++i) {
+        EXPECT_EQ(pSkinnedMesh->GetVertices()[i].indices, original[i].indices);
+        EXPECT_EQ(pSkinnedMesh->GetVertices()[i].weights.x, original[i].weights.x);
+    }
+}
+
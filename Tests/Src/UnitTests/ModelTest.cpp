@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <RoX/MeshFactory.h>
+
 #include "../Mocks/MockModelObserver.h"
 #include "../PredefinedObjects/ValidModel.h"
 
@@ -121,6 +123,28 @@ TEST_F(ModelTest, RemoveIMesh_WithInalidIndex) {
     EXPECT_EQ(pModel->GetNumMeshes(), 2);
 }
 
+TEST_F(ModelTest, MergeBounds_FollowsMeshes) {
+    MeshFactory::AddCube(*pMesh, 2.f);
+    pModel->MergeBounds();
+    EXPECT_NEAR(pModel->GetBoundingBox().Extents.x, 1.f, 1e-5f);
+
+    auto pNewMesh = NewValidMesh();
+    MeshFactory::AddCube(*pNewMesh, 2.f);
+    DirectX::XMMATRIX M = DirectX::XMMatrixTranslation(4.f, 0.f, 0.f);
+    pNewMesh->TransformVertices(M);
+    ASSERT_NO_THROW(pModel->Add(pNewMesh));
+    EXPECT_NEAR(pModel->GetBoundingBox().Center.x, 2.f, 1e-5f);
+    EXPECT_NEAR(pModel->GetBoundingBox().Extents.x, 3.f, 1e-5f);
+    EXPECT_NEAR(pModel->GetBoundingSphere().Center.x, 2.f, 1e-4f);
+
+    ASSERT_NO_THROW(pModel->RemoveIMesh(1));
+    EXPECT_NEAR(pModel->GetBoundingBox().Center.x, 0.f, 1e-5f);
+
+    M = DirectX::XMMatrixScaling(2.f, 2.f, 2.f);
+    pModel->TransformVertices(M);
+    EXPECT_NEAR(pModel->GetBoundingBox().Extents.x, 2.f, 1e-5f);
+}
+
 TEST_F(ModelTest, Attach_WithValidObserver) {
     MockModelObserver observer;
     EXPECT_NO_THROW(pModel->Attach(&observer));
@@ -141,3 +165,71 @@ TEST_F(ModelTest, Detach_WithInvalidObserver) {
     EXPECT_NO_THROW(pModel->Detach(nullptr));
 }
 
+
+TEST_F(ModelTest, Skeleton_WithMultipleRoots_IsBreadthFirst) {
+    // Children are stored before their parents and there are two roots.
+    std::vector<Bone> bones = {
+        { "grandchild", 2 },
+        { "root0" },
+        { "child0", 1 },
+        { "root1" },
+        { "child1", 3 }
+    };
+
+    Skeleton skeleton;
+    ASSERT_NO_THROW(skeleton = Skeleton(bones));
+    EXPECT_EQ(skeleton.GetNumBones(), 5u);
+    EXPECT_EQ(skeleton.GetNumRoots(), 2u);
+    EXPECT_EQ(skeleton.GetNumLevels(), 3u);
+    EXPECT_EQ(skeleton.GetOrder(), std::vector<std::uint16_t>({ 1, 3, 2, 4, 0 }));
+    EXPECT_EQ(skeleton.GetParentSlots(), std::vector<std::uint16_t>({ 0, 0, 1, 2, 3 }));
+    EXPECT_EQ(skeleton.GetLevelOffsets(), std::vector<std::uint32_t>({ 0, 2, 4, 5 }));
+}
+
+TEST_F(ModelTest, Skeleton_WithParentOutOfRange) {
+    std::vector<Bone> bones = { { "root" }, { "child", 2 } };
+    EXPECT_THROW(Skeleton{ bones }, std::invalid_argument);
+}
+
+TEST_F(ModelTest, Skeleton_WithCycle) {
+    std::vector<Bone> bones = { { "root" }, { "a", 2 }, { "b", 1 } };
+    EXPECT_THROW(Skeleton{ bones }, std::invalid_argument);
+}
+
+TEST_F(ModelTest, GetSkeleton_CompilesAfterAddingBones) {
+    EXPECT_EQ(pSkinnedModel->GetSkeleton().GetNumBones(), pSkinnedModel->GetNumBones());
+
+    pSkinnedModel->GetBones().push_back({ "root" });
+    pSkinnedModel->GetBones().push_back({ "child", pSkinnedModel->GetNumBones() - 1 });
+    EXPECT_EQ(pSkinnedModel->GetSkeleton().GetNumBones(), pSkinnedModel->GetNumBones());
+}
+
+TEST_F(ModelTest, UpdateBoneMatrices_OnlyRecomputesDirtyBones) {
+    Model model(pMaterial);
+    model.GetBones() = { { "root0" }, { "child0", 0 }, { "grandchild", 1 }, { "root1" } };
+    model.MakeBoneMatricesArray(4);
+    model.MakeInverseBoneMatricesArray(4);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        model.GetInverseBindPoseMatrices()[i] = DirectX::XMMatrixIdentity();
+    }
+
+    EXPECT_EQ(model.UpdateBoneMatrices(), 4u);
+    EXPECT_EQ(model.UpdateBoneMatrices(), 0u);
+
+    // Setting the same transform again does not dirty the bone.
+    model.SetLocalTransform(3, DirectX::XMMatrixIdentity());
+    EXPECT_EQ(model.UpdateBoneMatrices(), 0u);
+
+    // Moving the child also moves the grandchild but leaves the roots alone.
+    model.SetLocalTransform(1, DirectX::XMMatrixTranslation(1.f, 2.f, 3.f));
+    EXPECT_EQ(model.UpdateBoneMatrices(), 2u);
+
+    DirectX::XMFLOAT4X4 grandchild;
+    DirectX::XMStoreFloat4x4(&grandchild, model.GetBoneMatrices()[2]);
+    EXPECT_FLOAT_EQ(grandchild._41, 1.f);
+    EXPECT_FLOAT_EQ(grandchild._42, 2.f);
+    EXPECT_FLOAT_EQ(grandchild._43, 3.f);
+
+    model.MarkBonesDirty();
+    EXPECT_EQ(model.UpdateBoneMatrices(), 4u);
+}